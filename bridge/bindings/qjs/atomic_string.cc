@@ -21,7 +21,11 @@ AtomicString AtomicString::From(JSContext* ctx, NativeString* native_string) {
 
 namespace {
 
-AtomicString::StringKind GetStringKind(const std::string& string) {
+AtomicString::StringKind GetStringKind(std::string_view string) {
+  if (string.empty()) {
+    return AtomicString::StringKind::kIsMixed;
+  }
+
   AtomicString::StringKind predictKind =
       std::islower(string[0]) ? AtomicString::StringKind::kIsLowerCase : AtomicString::StringKind::kIsUpperCase;
   for (char i : string) {
@@ -41,7 +45,7 @@ AtomicString::StringKind GetStringKind(JSValue stringValue) {
     return AtomicString::StringKind::kIsMixed;
   }
 
-  return GetStringKind(reinterpret_cast<const char*>(p->u.str8));
+  return GetStringKind(std::string_view(reinterpret_cast<const char*>(p->u.str8), p->len));
 }
 
 AtomicString::StringKind GetStringKind(const NativeString* native_string) {
@@ -66,10 +70,10 @@ AtomicString::StringKind GetStringKind(const NativeString* native_string) {
 
 }  // namespace
 
-AtomicString::AtomicString(JSContext* ctx, const std::string& string)
+AtomicString::AtomicString(JSContext* ctx, std::string_view string)
     : runtime_(JS_GetRuntime(ctx)),
       ctx_(ctx),
-      atom_(JS_NewAtom(ctx, string.c_str())),
+      atom_(JS_NewAtomLen(ctx, string.data(), string.size())),
       kind_(GetStringKind(string)),
       length_(string.size()) {}
 
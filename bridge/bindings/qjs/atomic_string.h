@@ -10,6 +10,7 @@
 #include <cassert>
 #include <functional>
 #include <memory>
+#include <string_view>
 #include "foundation/macros.h"
 #include "foundation/native_string.h"
 #include "foundation/string_view.h"
@@ -36,7 +37,8 @@ class AtomicString {
   static AtomicString From(JSContext* ctx, NativeString* native_string);
 
   AtomicString() = default;
-  AtomicString(JSContext* ctx, const std::string& string);
+  // Creates the atom straight from the UTF-8 characters of |string|, which need not be null terminated.
+  AtomicString(JSContext* ctx, std::string_view string);
   AtomicString(JSContext* ctx, const NativeString* native_string);
   AtomicString(JSContext* ctx, JSValue value);
   AtomicString(JSContext* ctx, JSAtom atom);
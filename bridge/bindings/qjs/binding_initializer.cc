@@ -31,6 +31,7 @@
 #include "qjs_html_body_element.h"
 #include "qjs_html_button_element.h"
 #include "qjs_html_canvas_element.h"
+#include "qjs_html_collection.h"
 #include "qjs_html_div_element.h"
 #include "qjs_html_element.h"
 #include "qjs_html_head_element.h"
@@ -128,6 +129,7 @@ void InstallBindings(ExecutingContext* context) {
   QJSCanvasRenderingContext2D::Install(context);
   QJSCSSStyleDeclaration::Install(context);
   QJSBoundingClientRect::Install(context);
+  QJSHTMLCollection::Install(context);
   QJSHTMLAllCollection::Install(context);
   QJSScreen::Install(context);
   QJSBlob::Install(context);
@@ -30,6 +30,7 @@ class Member {
   Member(const Member<T>& other) {
     raw_ = other.raw_;
     runtime_ = other.runtime_;
+    deferred_context_ = other.deferred_context_;
   }
   ~Member() {
     if (raw_ != nullptr) {
@@ -39,7 +40,12 @@ class Member {
       //  Two is by free directly when running out of function body.
       // We detect the GC phase to handle case two, and free our members by hand(call JS_FreeValueRT directly).
       JSGCPhaseEnum phase = JS_GetEnginePhase(runtime_);
-      if (phase == JS_GC_PHASE_DECREF) {
+      // The GC may already have freed the pointee, so it is only read when it still has no JS object, which means
+      // the document tree keeps it alive.
+      if (phase != JS_GC_PHASE_NONE && deferred_context_ != nullptr &&
+          deferred_context_->IsDeferredWrapper(static_cast<const ScriptWrappable*>(raw_))) {
+        To<ScriptWrappable>(raw_)->ReleaseReferenceFromGC();
+      } else if (phase == JS_GC_PHASE_DECREF) {
         JS_FreeValueRT(runtime_, raw_->ToQuickJSUnsafe());
       }
     }
@@ -53,12 +59,14 @@ class Member {
     // Record the free operation to avoid JSObject had been freed immediately.
     wrappable->GetExecutingContext()->mutationScope()->RecordFree(wrappable);
     raw_ = nullptr;
+    deferred_context_ = nullptr;
   }
 
   // Copy assignment.
   Member& operator=(const Member& other) {
     raw_ = other.raw_;
     runtime_ = other.runtime_;
+    deferred_context_ = other.deferred_context_;
     return *this;
   }
   // Move assignment.
@@ -90,13 +98,17 @@ class Member {
       assert_m(wrappable->GetExecutingContext()->HasMutationScope(),
                "Member must be used after MemberMutationScope allcated.");
       runtime_ = wrappable->runtime();
-      JS_DupValue(wrappable->ctx(), wrappable->ToQuickJSUnsafe());
+      // Objects only become deferred when they are created, so a pointee with a JS object never needs the lookup.
+      deferred_context_ = wrappable->HasDeferredWrapper() ? wrappable->GetExecutingContext() : nullptr;
+      wrappable->RetainReference();
     }
     raw_ = p;
   }
 
   mutable T* raw_{nullptr};
   JSRuntime* runtime_{nullptr};
+  // Set when the pointee had no JS object yet, see ScriptWrappable::HasDeferredWrapper().
+  mutable ExecutingContext* deferred_context_{nullptr};
 };
 
 }  // namespace webf
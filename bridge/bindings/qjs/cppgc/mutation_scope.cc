@@ -35,10 +35,9 @@ void MemberMutationScope::RecordFree(ScriptWrappable* wrappable) {
 }
 
 void MemberMutationScope::ApplyRecord() {
-  JSContext* ctx = context_->ctx();
   for (auto& entry : mutation_records_) {
     for (int i = 0; i < -entry.second; i++) {
-      JS_FreeValue(ctx, entry.first->ToQuickJSUnsafe());
+      entry.first->ReleaseReference();
     }
   }
 }
@@ -13,6 +13,7 @@ ScriptWrappable::ScriptWrappable(JSContext* ctx)
     : ctx_(ctx), runtime_(JS_GetRuntime(ctx)), context_(ExecutingContext::From(ctx)) {}
 
 JSValue ScriptWrappable::ToQuickJS() const {
+  EnsureWrapper();
   return JS_DupValue(ctx_, jsObject_);
 }
 
@@ -21,6 +22,7 @@ JSValue ScriptWrappable::ToQuickJSUnsafe() const {
 }
 
 ScriptValue ScriptWrappable::ToValue() {
+  EnsureWrapper();
   return ScriptValue(ctx_, jsObject_);
 }
 
@@ -154,6 +156,71 @@ static int HandleJSGetOwnProperty(JSContext* ctx, JSPropertyDescriptor* desc, JS
 }
 
 void ScriptWrappable::InitializeQuickJSObject() {
+  if (context_->IsDeferringWrappers() && CanDeferWrapper() && !KeepAlive()) {
+    // Stands for the reference of the JS object, which MakeGarbageCollected hands to a Local.
+    wrapper_deferred_ = true;
+    deferred_references_ = 1;
+    context_->DidDeferWrapper(this);
+    return;
+  }
+  CreateQuickJSObject();
+}
+
+void ScriptWrappable::EnsureWrapper() const {
+  if (LIKELY(!wrapper_deferred_))
+    return;
+
+  assert(deferred_references_ > 0);
+  // Creating the object may run the GC, which still has to find the references counted here.
+  const_cast<ScriptWrappable*>(this)->CreateQuickJSObject();
+  wrapper_deferred_ = false;
+  context_->DidCreateDeferredWrapper(this);
+  // The new object holds one reference, add the others counted so far.
+  for (uint32_t i = 1; i < deferred_references_; i++) {
+    JS_DupValue(ctx_, jsObject_);
+  }
+  deferred_references_ = 0;
+  DidCreateDeferredWrapper();
+}
+
+void ScriptWrappable::RetainReference() const {
+  if (UNLIKELY(wrapper_deferred_)) {
+    deferred_references_++;
+    return;
+  }
+  JS_DupValue(ctx_, jsObject_);
+}
+
+void ScriptWrappable::ReleaseReference() const {
+  if (LIKELY(!wrapper_deferred_)) {
+    JS_FreeValue(ctx_, jsObject_);
+    return;
+  }
+
+  assert(deferred_references_ > 0);
+  if (--deferred_references_ > 0)
+    return;
+  // Nothing holds the object any more. Its JS object is created with the last reference, so that it is freed by the
+  // finalizer the same way as every other object.
+  deferred_references_ = 1;
+  EnsureWrapper();
+  JS_FreeValue(ctx_, jsObject_);
+}
+
+bool ScriptWrappable::HasOneReference() const {
+  if (UNLIKELY(wrapper_deferred_))
+    return deferred_references_ == 1;
+  return static_cast<JSRefCountHeader*>(JS_VALUE_GET_PTR(jsObject_))->ref_count == 1;
+}
+
+void ScriptWrappable::ReleaseReferenceFromGC() const {
+  assert(wrapper_deferred_ && deferred_references_ > 1);
+  // No JS object can be created while the GC runs. The document tree holds the last reference to a deferred wrapper
+  // and creates its JS object before it lets go, so a GC never releases the last one.
+  deferred_references_--;
+}
+
+void ScriptWrappable::CreateQuickJSObject() {
   auto* wrapper_type_info = GetWrapperTypeInfo();
   JSRuntime* runtime = runtime_;
 
@@ -253,4 +320,13 @@ bool ScriptWrappable::KeepAlive() const {
   return false;
 }
 
+DeferredWrapperScope::DeferredWrapperScope(ExecutingContext* context, bool defer)
+    : context_(context), previous_(context->IsDeferringWrappers()) {
+  context->SetDeferringWrappers(defer);
+}
+
+DeferredWrapperScope::~DeferredWrapperScope() {
+  context_->SetDeferringWrappers(previous_);
+}
+
 }  // namespace webf
@@ -49,6 +49,7 @@ class ScriptWrappable : public GarbageCollected<ScriptWrappable> {
   void Trace(GCVisitor* visitor) const override{};
 
   virtual JSValue ToQuickJS() const;
+  // The JS object without taking a reference, JS_NULL while its creation is deferred.
   JSValue ToQuickJSUnsafe() const;
 
   ScriptValue ToValue();
@@ -58,6 +59,19 @@ class ScriptWrappable : public GarbageCollected<ScriptWrappable> {
 
   void InitializeQuickJSObject() override;
 
+  // The JS object of an object created inside a DeferredWrapperScope is created when script first reaches it. Until
+  // then the references of Members and Locals are counted here, and handed over to the JS object once it exists.
+  [[nodiscard]] bool HasDeferredWrapper() const { return wrapper_deferred_; }
+  void EnsureWrapper() const;
+  void RetainReference() const;
+  void ReleaseReference() const;
+  // Whether a single holder references the object, so that when it is the caller nobody else can observe the object
+  // being changed.
+  [[nodiscard]] bool HasOneReference() const;
+  // The GC frees the holder of a reference to a deferred wrapper. It does not see such references, so they are not
+  // released along with the edges it knows about.
+  void ReleaseReferenceFromGC() const;
+
   /**
    * Classes kept alive as long as
    * they have a pending activity. Destroying the corresponding ExecutionContext
@@ -65,14 +79,41 @@ class ScriptWrappable : public GarbageCollected<ScriptWrappable> {
    */
   virtual bool KeepAlive() const;
 
+ protected:
+  // Objects whose creation of the JS object may be deferred. They must only be kept alive by holders which create
+  // their JS object when they are no longer reachable themselves, such as the document tree, see
+  // Node::RemovedFrom.
+  virtual bool CanDeferWrapper() const { return false; }
+  // The deferred wrappers held by this object create their JS object too, so that the GC sees the edges to them.
+  virtual void DidCreateDeferredWrapper() const {}
+
  private:
-  JSValue jsObject_{JS_NULL};
+  void CreateQuickJSObject();
+
+  mutable JSValue jsObject_{JS_NULL};
+  mutable bool wrapper_deferred_{false};
+  mutable uint32_t deferred_references_{0};
   JSContext* ctx_{nullptr};
   ExecutingContext* context_{nullptr};
   JSRuntime* runtime_{nullptr};
   friend class GCVisitor;
 };
 
+// Defers the creation of the JS object of the objects created while it is active, see
+// ScriptWrappable::CanDeferWrapper. The HTML parser uses it, as scripts only touch a few of the nodes it creates.
+class DeferredWrapperScope {
+  WEBF_DISALLOW_NEW();
+
+ public:
+  // A scope with |defer| false creates JS objects eagerly again, e.g. while an inline script runs.
+  explicit DeferredWrapperScope(ExecutingContext* context, bool defer = true);
+  ~DeferredWrapperScope();
+
+ private:
+  ExecutingContext* context_;
+  bool previous_;
+};
+
 // Converts a QuickJS object back to a ScriptWrappable.
 template <typename ScriptWrappable>
 inline ScriptWrappable* toScriptWrappable(JSValue object) {
@@ -55,6 +55,7 @@ enum {
   JS_CLASS_DOCUMENT_FRAGMENT,
   JS_CLASS_BOUNDING_CLIENT_RECT,
   JS_CLASS_ELEMENT_ATTRIBUTES,
+  JS_CLASS_HTML_COLLECTION,
   JS_CLASS_HTML_ALL_COLLECTION,
   JS_CLASS_HTML_ELEMENT,
   JS_CLASS_WIDGET_ELEMENT,
@@ -51,7 +51,13 @@ NativeValue BindingObject::InvokeBindingMethod(const AtomicString& method,
                                                int32_t argc,
                                                const NativeValue* argv,
                                                ExceptionState& exception_state) const {
-  context_->FlushUICommand();
+  if (!binding_call_methods::IsLayoutIndependent(method)) {
+    context_->FlushUICommand();
+  }
+  // Reads leave the geometry snapshots valid, layouts made by dart side for other reasons are reported per frame.
+  if (binding_call_methods::MutatesLayout(method)) {
+    context_->uiCommandBuffer()->invalidateLayout();
+  }
   if (binding_object_->invoke_bindings_methods_from_native == nullptr) {
     exception_state.ThrowException(context_->ctx(), ErrorType::InternalError,
                                    "Failed to call dart method: invoke_bindings_methods_from_native not initialized.");
@@ -69,6 +75,18 @@ NativeValue BindingObject::InvokeBindingMethod(BindingMethodCallOperations bindi
                                                const NativeValue* argv,
                                                ExceptionState& exception_state) const {
   context_->FlushUICommand();
+  // Widget methods and anonymous functions run arbitrary dart code, assume they may change the layout.
+  if (binding_method_call_operation != BindingMethodCallOperations::kGetProperty &&
+      binding_method_call_operation != BindingMethodCallOperations::kGetAllPropertyNames) {
+    context_->uiCommandBuffer()->invalidateLayout();
+  }
+  return InvokeBindingMethodWithoutFlush(binding_method_call_operation, argc, argv, exception_state);
+}
+
+NativeValue BindingObject::InvokeBindingMethodWithoutFlush(BindingMethodCallOperations binding_method_call_operation,
+                                                           int32_t argc,
+                                                           const NativeValue* argv,
+                                                           ExceptionState& exception_state) const {
   if (binding_object_->invoke_bindings_methods_from_native == nullptr) {
     exception_state.ThrowException(context_->ctx(), ErrorType::InternalError,
                                    "Failed to call dart method: invoke_bindings_methods_from_native not initialized.");
@@ -82,17 +100,20 @@ NativeValue BindingObject::InvokeBindingMethod(BindingMethodCallOperations bindi
 }
 
 NativeValue BindingObject::GetBindingProperty(const AtomicString& prop, ExceptionState& exception_state) const {
-  context_->FlushUICommand();
+  if (!binding_call_methods::IsLayoutIndependent(prop)) {
+    context_->FlushUICommand();
+  }
   const NativeValue argv[] = {Native_NewString(prop.ToNativeString().release())};
-  return InvokeBindingMethod(BindingMethodCallOperations::kGetProperty, 1, argv, exception_state);
+  return InvokeBindingMethodWithoutFlush(BindingMethodCallOperations::kGetProperty, 1, argv, exception_state);
 }
 
 NativeValue BindingObject::SetBindingProperty(const AtomicString& prop,
                                               NativeValue value,
                                               ExceptionState& exception_state) const {
   context_->FlushUICommand();
+  context_->uiCommandBuffer()->invalidateLayout();
   const NativeValue argv[] = {Native_NewString(prop.ToNativeString().release()), value};
-  return InvokeBindingMethod(BindingMethodCallOperations::kSetProperty, 2, argv, exception_state);
+  return InvokeBindingMethodWithoutFlush(BindingMethodCallOperations::kSetProperty, 2, argv, exception_state);
 }
 
 ScriptValue BindingObject::AnonymousFunctionCallback(JSContext* ctx,
@@ -200,7 +221,8 @@ ScriptValue BindingObject::AnonymousAsyncFunctionCallback(JSContext* ctx,
 
 NativeValue BindingObject::GetAllBindingPropertyNames(ExceptionState& exception_state) const {
   context_->FlushUICommand();
-  return InvokeBindingMethod(BindingMethodCallOperations::kGetAllPropertyNames, 0, nullptr, exception_state);
+  return InvokeBindingMethodWithoutFlush(BindingMethodCallOperations::kGetAllPropertyNames, 0, nullptr,
+                                         exception_state);
 }
 
 void BindingObject::Trace(GCVisitor* visitor) const {
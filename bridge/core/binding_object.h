@@ -47,6 +47,9 @@ struct NativeBindingObject : public DartReadable {
   BindingObject* binding_target_{nullptr};
   InvokeBindingMethodsFromDart invoke_binding_methods_from_dart{nullptr};
   InvokeBindingsMethodsFromNative invoke_bindings_methods_from_native{nullptr};
+  // EventListenerTypeBit bits of the event types listened to somewhere on the event path of an EventTarget, read by
+  // Dart to skip dispatching events nobody listens to.
+  uint32_t event_path_listener_types{0};
 };
 
 enum BindingMethodCallOperations {
@@ -118,6 +121,12 @@ class BindingObject {
                                   const NativeValue* args,
                                   ExceptionState& exception_state) const;
 
+  // Callers should flush UICommands first when dart side needs to be up to date.
+  NativeValue InvokeBindingMethodWithoutFlush(BindingMethodCallOperations binding_method_call_operation,
+                                              int32_t argc,
+                                              const NativeValue* args,
+                                              ExceptionState& exception_state) const;
+
   // NativeBindingObject may allocated at Dart side. Binding this with Dart allocated NativeBindingObject.
   explicit BindingObject(ExecutingContext* context, NativeBindingObject* native_binding_object);
 
@@ -0,0 +1,35 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "css_selector.h"
+
+namespace webf {
+
+CSSSelector::CSSSelector(CSSSelector&&) noexcept = default;
+CSSSelector& CSSSelector::operator=(CSSSelector&&) noexcept = default;
+CSSSelector::~CSSSelector() = default;
+
+void CSSSelector::SetAttributeValue(const AtomicString& value, std::string value_string, bool case_insensitive) {
+  attribute_value_ = value;
+  attribute_value_string_ = std::move(value_string);
+  attribute_case_insensitive_ = case_insensitive;
+}
+
+void CSSSelector::SetSelectorList(std::unique_ptr<CSSSelectorList> selector_list) {
+  selector_list_ = std::move(selector_list);
+}
+
+// https://drafts.csswg.org/selectors/#nth-child-pseudo
+// |index| is 1-based, matches when index == a*n + b for some n >= 0.
+bool CSSSelector::MatchNth(int index) const {
+  if (nth_a_ == 0)
+    return index == nth_b_;
+  int offset = index - nth_b_;
+  if (nth_a_ > 0) {
+    return offset >= 0 && offset % nth_a_ == 0;
+  }
+  return offset <= 0 && offset % nth_a_ == 0;
+}
+
+}  // namespace webf
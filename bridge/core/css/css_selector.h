@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef BRIDGE_CORE_CSS_CSS_SELECTOR_H_
+#define BRIDGE_CORE_CSS_CSS_SELECTOR_H_
+
+#include <memory>
+#include <string>
+#include <vector>
+#include "bindings/qjs/atomic_string.h"
+
+namespace webf {
+
+class CSSSelectorList;
+
+// A simple selector: a type selector, #id, .class, [attribute] or a pseudo class.
+class CSSSelector {
+ public:
+  enum class MatchType : uint8_t {
+    kUniversal,
+    kTag,
+    kId,
+    kClass,
+    kAttributeSet,      // [attr]
+    kAttributeExact,    // [attr=value]
+    kAttributeList,     // [attr~=value]
+    kAttributeHyphen,   // [attr|=value]
+    kAttributeBegin,    // [attr^=value]
+    kAttributeEnd,      // [attr$=value]
+    kAttributeContain,  // [attr*=value]
+    kPseudoClass,
+  };
+
+  enum class PseudoType : uint8_t {
+    kUnknown,
+    kNot,
+    kFirstChild,
+    kLastChild,
+    kOnlyChild,
+    kNthChild,
+    kNthLastChild,
+    kEmpty,
+    kRoot,
+  };
+
+  // How a compound selector relates to the compound selector on its left, "a > b" gives b the relation kChild.
+  enum class RelationType : uint8_t {
+    // The leftmost compound selector.
+    kNone,
+    // "a b"
+    kDescendant,
+    // "a > b"
+    kChild,
+    // "a + b"
+    kDirectAdjacent,
+    // "a ~ b"
+    kIndirectAdjacent,
+  };
+
+  CSSSelector(MatchType match, const AtomicString& value) : match_(match), value_(value) {}
+  CSSSelector(CSSSelector&&) noexcept;
+  CSSSelector& operator=(CSSSelector&&) noexcept;
+  ~CSSSelector();
+
+  MatchType Match() const { return match_; }
+  PseudoType GetPseudoType() const { return pseudo_type_; }
+  // The tag name, id, class name or attribute name.
+  const AtomicString& Value() const { return value_; }
+
+  const AtomicString& AttributeValue() const { return attribute_value_; }
+  const std::string& AttributeValueString() const { return attribute_value_string_; }
+  bool AttributeMatchIsCaseInsensitive() const { return attribute_case_insensitive_; }
+  void SetAttributeValue(const AtomicString& value, std::string value_string, bool case_insensitive);
+
+  void SetPseudoType(PseudoType pseudo_type) { pseudo_type_ = pseudo_type; }
+  // For :nth-child(an+b) and :nth-last-child(an+b).
+  void SetNth(int a, int b) {
+    nth_a_ = a;
+    nth_b_ = b;
+  }
+  bool MatchNth(int index) const;
+  // The argument of :not().
+  const CSSSelectorList* SelectorList() const { return selector_list_.get(); }
+  void SetSelectorList(std::unique_ptr<CSSSelectorList> selector_list);
+
+ private:
+  MatchType match_;
+  PseudoType pseudo_type_{PseudoType::kUnknown};
+  bool attribute_case_insensitive_{false};
+  int nth_a_{0};
+  int nth_b_{0};
+  AtomicString value_;
+  AtomicString attribute_value_;
+  std::string attribute_value_string_;
+  std::unique_ptr<CSSSelectorList> selector_list_;
+};
+
+// Simple selectors without combinators in between, e.g. "div.item[data-id]".
+struct CSSCompoundSelector {
+  std::vector<CSSSelector> selectors;
+  CSSSelector::RelationType relation{CSSSelector::RelationType::kNone};
+};
+
+// Compound selectors joined by combinators, stored from right to left so compounds[0] is the subject.
+struct CSSComplexSelector {
+  std::vector<CSSCompoundSelector> compounds;
+};
+
+// A comma separated list of complex selectors.
+class CSSSelectorList {
+ public:
+  CSSSelectorList() = default;
+  explicit CSSSelectorList(std::vector<CSSComplexSelector> selectors) : selectors_(std::move(selectors)) {}
+
+  const std::vector<CSSComplexSelector>& Selectors() const { return selectors_; }
+
+ private:
+  std::vector<CSSComplexSelector> selectors_;
+};
+
+}  // namespace webf
+
+#endif  // BRIDGE_CORE_CSS_CSS_SELECTOR_H_
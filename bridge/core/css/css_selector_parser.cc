@@ -0,0 +1,417 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "css_selector_parser.h"
+#include <cstdlib>
+#include "foundation/ascii_types.h"
+
+namespace webf {
+
+namespace {
+
+bool IsNameStart(char c) {
+  return IsASCIIAlpha(c) || c == '_' || !IsASCII(static_cast<unsigned char>(c));
+}
+
+bool IsNameCharacter(char c) {
+  return IsNameStart(c) || IsASCIIDigit(c) || c == '-';
+}
+
+bool IsHexDigit(char c) {
+  return IsASCIIDigit(c) || ((c | 0x20) >= 'a' && (c | 0x20) <= 'f');
+}
+
+std::string ToLowerASCII(std::string string) {
+  for (char& c : string) {
+    if (IsASCIIUpper(c))
+      c |= 0x20;
+  }
+  return string;
+}
+
+void AppendUTF8(std::string& output, uint32_t code_point) {
+  if (code_point == 0 || code_point > 0x10FFFF || (code_point >= 0xD800 && code_point <= 0xDFFF)) {
+    code_point = 0xFFFD;
+  }
+  if (code_point < 0x80) {
+    output += static_cast<char>(code_point);
+  } else if (code_point < 0x800) {
+    output += static_cast<char>(0xC0 | (code_point >> 6));
+    output += static_cast<char>(0x80 | (code_point & 0x3F));
+  } else if (code_point < 0x10000) {
+    output += static_cast<char>(0xE0 | (code_point >> 12));
+    output += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+    output += static_cast<char>(0x80 | (code_point & 0x3F));
+  } else {
+    output += static_cast<char>(0xF0 | (code_point >> 18));
+    output += static_cast<char>(0x80 | ((code_point >> 12) & 0x3F));
+    output += static_cast<char>(0x80 | ((code_point >> 6) & 0x3F));
+    output += static_cast<char>(0x80 | (code_point & 0x3F));
+  }
+}
+
+CSSSelector::PseudoType PseudoTypeFromName(const std::string& name, bool is_function) {
+  if (is_function) {
+    if (name == "not")
+      return CSSSelector::PseudoType::kNot;
+    if (name == "nth-child")
+      return CSSSelector::PseudoType::kNthChild;
+    if (name == "nth-last-child")
+      return CSSSelector::PseudoType::kNthLastChild;
+    return CSSSelector::PseudoType::kUnknown;
+  }
+  if (name == "first-child")
+    return CSSSelector::PseudoType::kFirstChild;
+  if (name == "last-child")
+    return CSSSelector::PseudoType::kLastChild;
+  if (name == "only-child")
+    return CSSSelector::PseudoType::kOnlyChild;
+  if (name == "empty")
+    return CSSSelector::PseudoType::kEmpty;
+  if (name == "root")
+    return CSSSelector::PseudoType::kRoot;
+  return CSSSelector::PseudoType::kUnknown;
+}
+
+}  // namespace
+
+std::unique_ptr<CSSSelectorList> CSSSelectorParser::Parse(JSContext* ctx, const std::string& text) {
+  CSSSelectorParser parser(ctx, text);
+  std::vector<CSSComplexSelector> selectors;
+  if (!parser.ConsumeSelectorList(selectors, false) || !parser.AtEnd()) {
+    return nullptr;
+  }
+  return std::make_unique<CSSSelectorList>(std::move(selectors));
+}
+
+bool CSSSelectorParser::ConsumeSelectorList(std::vector<CSSComplexSelector>& selectors, bool nested) {
+  while (true) {
+    ConsumeWhitespace();
+    CSSComplexSelector complex;
+    if (!ConsumeComplexSelector(complex))
+      return false;
+    selectors.emplace_back(std::move(complex));
+    if (Peek() != ',')
+      break;
+    position_++;
+  }
+  // A nested list ends at the closing parenthesis, which is consumed by the caller.
+  return nested ? Peek() == ')' : AtEnd();
+}
+
+bool CSSSelectorParser::ConsumeComplexSelector(CSSComplexSelector& complex) {
+  std::vector<CSSCompoundSelector> compounds;
+  CSSSelector::RelationType relation = CSSSelector::RelationType::kNone;
+  while (true) {
+    CSSCompoundSelector compound;
+    if (!ConsumeCompoundSelector(compound))
+      return false;
+    compound.relation = relation;
+    compounds.emplace_back(std::move(compound));
+
+    bool had_whitespace = ConsumeWhitespace();
+    char c = Peek();
+    if (c == '>' || c == '+' || c == '~') {
+      position_++;
+      ConsumeWhitespace();
+      relation = c == '>'   ? CSSSelector::RelationType::kChild
+                 : c == '+' ? CSSSelector::RelationType::kDirectAdjacent
+                            : CSSSelector::RelationType::kIndirectAdjacent;
+    } else if (had_whitespace && !AtEnd() && c != ',' && c != ')') {
+      relation = CSSSelector::RelationType::kDescendant;
+    } else {
+      break;
+    }
+  }
+
+  // Matching starts from the subject, every compound already records the relation to its left neighbour.
+  complex.compounds.reserve(compounds.size());
+  for (size_t i = compounds.size(); i > 0; i--) {
+    complex.compounds.emplace_back(std::move(compounds[i - 1]));
+  }
+  return true;
+}
+
+bool CSSSelectorParser::ConsumeCompoundSelector(CSSCompoundSelector& compound) {
+  if (Peek() == '*') {
+    position_++;
+    compound.selectors.emplace_back(CSSSelector::MatchType::kUniversal, AtomicString::Empty());
+  } else if (IsNameStart(Peek()) || Peek() == '\\' || (Peek() == '-' && IsNameStart(Peek(1)))) {
+    std::string tag_name;
+    if (!ConsumeIdentifier(tag_name))
+      return false;
+    compound.selectors.emplace_back(CSSSelector::MatchType::kTag, AtomicString(ctx_, ToLowerASCII(tag_name)));
+  }
+
+  while (!AtEnd()) {
+    char c = Peek();
+    if (c == '#' || c == '.') {
+      position_++;
+      std::string name;
+      if (!ConsumeIdentifier(name))
+        return false;
+      compound.selectors.emplace_back(c == '#' ? CSSSelector::MatchType::kId : CSSSelector::MatchType::kClass,
+                                      AtomicString(ctx_, name));
+    } else if (c == '[') {
+      position_++;
+      if (!ConsumeAttributeSelector(compound))
+        return false;
+    } else if (c == ':') {
+      position_++;
+      if (!ConsumePseudoSelector(compound))
+        return false;
+    } else {
+      break;
+    }
+  }
+  return !compound.selectors.empty();
+}
+
+bool CSSSelectorParser::ConsumeAttributeSelector(CSSCompoundSelector& compound) {
+  ConsumeWhitespace();
+  std::string name;
+  if (!ConsumeIdentifier(name))
+    return false;
+  ConsumeWhitespace();
+
+  AtomicString attribute_name = AtomicString(ctx_, ToLowerASCII(name));
+  if (Peek() == ']') {
+    position_++;
+    compound.selectors.emplace_back(CSSSelector::MatchType::kAttributeSet, attribute_name);
+    return true;
+  }
+
+  CSSSelector::MatchType match;
+  switch (Peek()) {
+    case '=':
+      match = CSSSelector::MatchType::kAttributeExact;
+      break;
+    case '~':
+      match = CSSSelector::MatchType::kAttributeList;
+      break;
+    case '|':
+      match = CSSSelector::MatchType::kAttributeHyphen;
+      break;
+    case '^':
+      match = CSSSelector::MatchType::kAttributeBegin;
+      break;
+    case '$':
+      match = CSSSelector::MatchType::kAttributeEnd;
+      break;
+    case '*':
+      match = CSSSelector::MatchType::kAttributeContain;
+      break;
+    default:
+      return false;
+  }
+  position_++;
+  if (match != CSSSelector::MatchType::kAttributeExact) {
+    if (Peek() != '=')
+      return false;
+    position_++;
+  }
+  ConsumeWhitespace();
+
+  std::string value;
+  if (Peek() == '"' || Peek() == '\'') {
+    if (!ConsumeString(value))
+      return false;
+  } else if (!ConsumeIdentifier(value)) {
+    return false;
+  }
+  ConsumeWhitespace();
+
+  bool case_insensitive = false;
+  if ((Peek() | 0x20) == 'i' || (Peek() | 0x20) == 's') {
+    case_insensitive = (Peek() | 0x20) == 'i';
+    position_++;
+    ConsumeWhitespace();
+  }
+  if (Peek() != ']')
+    return false;
+  position_++;
+
+  CSSSelector selector(match, attribute_name);
+  selector.SetAttributeValue(AtomicString(ctx_, value), case_insensitive ? ToLowerASCII(value) : value,
+                             case_insensitive);
+  compound.selectors.emplace_back(std::move(selector));
+  return true;
+}
+
+bool CSSSelectorParser::ConsumePseudoSelector(CSSCompoundSelector& compound) {
+  // Pseudo elements never match an element.
+  if (Peek() == ':')
+    return false;
+  std::string name;
+  if (!ConsumeIdentifier(name))
+    return false;
+  bool is_function = Peek() == '(';
+  CSSSelector::PseudoType pseudo_type = PseudoTypeFromName(ToLowerASCII(name), is_function);
+  if (pseudo_type == CSSSelector::PseudoType::kUnknown)
+    return false;
+
+  CSSSelector selector(CSSSelector::MatchType::kPseudoClass, AtomicString::Empty());
+  selector.SetPseudoType(pseudo_type);
+  if (is_function) {
+    position_++;
+    ConsumeWhitespace();
+    if (pseudo_type == CSSSelector::PseudoType::kNot) {
+      std::vector<CSSComplexSelector> selectors;
+      if (!ConsumeSelectorList(selectors, true))
+        return false;
+      selector.SetSelectorList(std::make_unique<CSSSelectorList>(std::move(selectors)));
+    } else if (!ConsumeNth(selector)) {
+      return false;
+    }
+    ConsumeWhitespace();
+    if (Peek() != ')')
+      return false;
+    position_++;
+  }
+  compound.selectors.emplace_back(std::move(selector));
+  return true;
+}
+
+// https://drafts.csswg.org/css-syntax-3/#anb-microsyntax
+bool CSSSelectorParser::ConsumeNth(CSSSelector& selector) {
+  size_t start = position_;
+  while (!AtEnd() && (IsASCIIAlphanumeric(Peek()) || Peek() == '+' || Peek() == '-' || IsASCIISpace(Peek()))) {
+    position_++;
+  }
+  std::string argument;
+  for (size_t i = start; i < position_; i++) {
+    if (!IsASCIISpace(text_[i]))
+      argument += static_cast<char>(text_[i] | (IsASCIIUpper(text_[i]) ? 0x20 : 0));
+  }
+
+  if (argument == "odd") {
+    selector.SetNth(2, 1);
+    return true;
+  }
+  if (argument == "even") {
+    selector.SetNth(2, 0);
+    return true;
+  }
+
+  size_t n = argument.find('n');
+  if (n == std::string::npos) {
+    // Only b.
+    if (argument.empty())
+      return false;
+    char* end;
+    long b = strtol(argument.c_str(), &end, 10);
+    if (*end != '\0')
+      return false;
+    selector.SetNth(0, static_cast<int>(b));
+    return true;
+  }
+
+  std::string a_part = argument.substr(0, n);
+  std::string b_part = argument.substr(n + 1);
+  int a;
+  if (a_part.empty() || a_part == "+") {
+    a = 1;
+  } else if (a_part == "-") {
+    a = -1;
+  } else {
+    char* end;
+    a = static_cast<int>(strtol(a_part.c_str(), &end, 10));
+    if (*end != '\0')
+      return false;
+  }
+
+  int b = 0;
+  if (!b_part.empty()) {
+    if (b_part[0] != '+' && b_part[0] != '-')
+      return false;
+    if (b_part.size() < 2 || !IsASCIIDigit(b_part[1]))
+      return false;
+    char* end;
+    b = static_cast<int>(strtol(b_part.c_str(), &end, 10));
+    if (*end != '\0')
+      return false;
+  }
+  selector.SetNth(a, b);
+  return true;
+}
+
+bool CSSSelectorParser::ConsumeIdentifier(std::string& identifier) {
+  size_t start = position_;
+  if (Peek() == '-')
+    identifier += text_[position_++];
+  if (Peek() == '-') {
+    // Custom identifiers such as "--foo".
+    identifier += text_[position_++];
+  } else if (Peek() == '\\') {
+    ConsumeEscape(identifier);
+  } else if (IsNameStart(Peek())) {
+    identifier += text_[position_++];
+  } else {
+    position_ = start;
+    return false;
+  }
+
+  while (!AtEnd()) {
+    if (Peek() == '\\') {
+      ConsumeEscape(identifier);
+    } else if (IsNameCharacter(Peek())) {
+      identifier += text_[position_++];
+    } else {
+      break;
+    }
+  }
+  return true;
+}
+
+bool CSSSelectorParser::ConsumeString(std::string& string) {
+  char quote = text_[position_++];
+  while (!AtEnd()) {
+    char c = Peek();
+    if (c == quote) {
+      position_++;
+      return true;
+    }
+    if (c == '\n')
+      return false;
+    if (c == '\\') {
+      ConsumeEscape(string);
+    } else {
+      string += c;
+      position_++;
+    }
+  }
+  return false;
+}
+
+// https://drafts.csswg.org/css-syntax-3/#consume-escaped-code-point
+void CSSSelectorParser::ConsumeEscape(std::string& output) {
+  // Skip the backslash.
+  position_++;
+  if (AtEnd()) {
+    AppendUTF8(output, 0xFFFD);
+    return;
+  }
+  if (!IsHexDigit(Peek())) {
+    output += text_[position_++];
+    return;
+  }
+  uint32_t code_point = 0;
+  for (int i = 0; i < 6 && IsHexDigit(Peek()); i++) {
+    char c = text_[position_++];
+    code_point = code_point * 16 + (IsASCIIDigit(c) ? c - '0' : (c | 0x20) - 'a' + 10);
+  }
+  if (IsASCIISpace(Peek()))
+    position_++;
+  AppendUTF8(output, code_point);
+}
+
+bool CSSSelectorParser::ConsumeWhitespace() {
+  size_t start = position_;
+  while (!AtEnd() && IsASCIISpace(Peek())) {
+    position_++;
+  }
+  return position_ != start;
+}
+
+}  // namespace webf
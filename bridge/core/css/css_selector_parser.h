@@ -0,0 +1,47 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef BRIDGE_CORE_CSS_CSS_SELECTOR_PARSER_H_
+#define BRIDGE_CORE_CSS_CSS_SELECTOR_PARSER_H_
+
+#include <memory>
+#include <string>
+#include "css_selector.h"
+
+namespace webf {
+
+// Parses the selector grammar used by querySelector(): type, universal, #id, .class and attribute selectors,
+// descendant, child and sibling combinators, :not(), :nth-child(), :nth-last-child(), :first-child, :last-child,
+// :only-child, :empty and :root.
+class CSSSelectorParser {
+ public:
+  // Return nullptr when |text| is not a valid selector list.
+  static std::unique_ptr<CSSSelectorList> Parse(JSContext* ctx, const std::string& text);
+
+ private:
+  CSSSelectorParser(JSContext* ctx, const std::string& text) : ctx_(ctx), text_(text) {}
+
+  bool ConsumeSelectorList(std::vector<CSSComplexSelector>& selectors, bool nested);
+  bool ConsumeComplexSelector(CSSComplexSelector& complex);
+  bool ConsumeCompoundSelector(CSSCompoundSelector& compound);
+  bool ConsumeAttributeSelector(CSSCompoundSelector& compound);
+  bool ConsumePseudoSelector(CSSCompoundSelector& compound);
+  bool ConsumeNth(CSSSelector& selector);
+  bool ConsumeIdentifier(std::string& identifier);
+  bool ConsumeString(std::string& string);
+  void ConsumeEscape(std::string& output);
+  bool ConsumeWhitespace();
+  bool AtEnd() const { return position_ >= text_.size(); }
+  char Peek(size_t offset = 0) const {
+    return position_ + offset < text_.size() ? text_[position_ + offset] : '\0';
+  }
+
+  JSContext* ctx_;
+  const std::string& text_;
+  size_t position_{0};
+};
+
+}  // namespace webf
+
+#endif  // BRIDGE_CORE_CSS_CSS_SELECTOR_PARSER_H_
@@ -5,6 +5,7 @@
 #include "css_style_declaration.h"
 #include <vector>
 #include "core/dom/element.h"
+#include "core/dom/markup_escape.h"
 #include "core/executing_context.h"
 #include "css_property_list.h"
 
@@ -50,6 +51,10 @@ static std::string parseJavaScriptCSSPropertyName(std::string& propertyName) {
   return result;
 }
 
+std::string CSSStyleDeclaration::CamelCasePropertyName(std::string name) {
+  return parseJavaScriptCSSPropertyName(name);
+}
+
 CSSStyleDeclaration* CSSStyleDeclaration::Create(ExecutingContext* context, ExceptionState& exception_state) {
   exception_state.ThrowException(context->ctx(), ErrorType::TypeError, "Illegal constructor.");
   return nullptr;
@@ -95,18 +100,16 @@ void CSSStyleDeclaration::CopyWith(CSSStyleDeclaration* inline_style) {
   }
 }
 
-std::string CSSStyleDeclaration::ToString() const {
-  if (properties_.empty())
-    return "";
-
-  std::string s;
-
+void CSSStyleDeclaration::ToString(std::string& result) const {
   for (auto& attr : properties_) {
-    s += attr.first + ": " + attr.second.ToStdString() + ";";
+    // Properties set to an empty string are kept in the map, but they are no longer part of the declaration.
+    if (attr.second.IsEmpty())
+      continue;
+    result += attr.first;
+    result += ": ";
+    AppendEscapedMarkup(result, attr.second.ToStdString(), MarkupEscapeMode::kAttributeValue);
+    result += ';';
   }
-
-  s += "\"";
-  return s;
 }
 
 bool CSSStyleDeclaration::NamedPropertyQuery(const AtomicString& key, ExceptionState&) {
@@ -140,8 +143,8 @@ bool CSSStyleDeclaration::InternalSetProperty(std::string& name, const AtomicStr
 
   std::unique_ptr<NativeString> args_01 = stringToNativeString(name);
   std::unique_ptr<NativeString> args_02 = value.ToNativeString();
-  GetExecutingContext()->uiCommandBuffer()->addCommand(owner_element_target_id_, UICommand::kSetStyle,
-                                                       std::move(args_01), std::move(args_02), nullptr);
+  GetExecutingContext()->uiCommandBuffer()->addStyleProperty(owner_element_target_id_, std::move(args_01),
+                                                             std::move(args_02));
 
   return true;
 }
@@ -158,8 +161,8 @@ AtomicString CSSStyleDeclaration::InternalRemoveProperty(std::string& name) {
 
   std::unique_ptr<NativeString> args_01 = stringToNativeString(name);
   std::unique_ptr<NativeString> args_02 = jsValueToNativeString(ctx(), JS_NULL);
-  GetExecutingContext()->uiCommandBuffer()->addCommand(owner_element_target_id_, UICommand::kSetStyle,
-                                                       std::move(args_01), std::move(args_02), nullptr);
+  GetExecutingContext()->uiCommandBuffer()->addStyleProperty(owner_element_target_id_, std::move(args_01),
+                                                             std::move(args_02));
 
   return return_value;
 }
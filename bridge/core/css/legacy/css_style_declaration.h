@@ -33,12 +33,19 @@ class CSSStyleDeclaration : public ScriptWrappable {
   AtomicString removeProperty(const AtomicString& key, ExceptionState& exception_state);
 
   void CopyWith(CSSStyleDeclaration* attributes);
+  // The name a declaration is stored and sent to dart side with, e.g. backgroundColor for background-color.
+  static std::string CamelCasePropertyName(std::string name);
 
-  std::string ToString() const;
+  // Append the declarations as `name: value;` to |result|, escaped for a double quoted attribute value.
+  void ToString(std::string& result) const;
 
   bool NamedPropertyQuery(const AtomicString&, ExceptionState&);
   void NamedPropertyEnumerator(std::vector<AtomicString>& names, ExceptionState&);
 
+ protected:
+  // Created by the HTML parser along with their element, see Element::DidCreateDeferredWrapper.
+  bool CanDeferWrapper() const override { return true; }
+
  private:
   AtomicString InternalGetPropertyValue(std::string& name);
   bool InternalSetProperty(std::string& name, const AtomicString& value);
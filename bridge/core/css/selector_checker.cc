@@ -0,0 +1,210 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "selector_checker.h"
+#include "core/dom/character_data.h"
+#include "core/dom/element.h"
+#include "core/dom/element_traversal.h"
+#include "foundation/ascii_types.h"
+#include "html_names.h"
+
+namespace webf {
+
+namespace {
+
+std::string AttributeValueForMatching(const AtomicString& value, bool case_insensitive) {
+  std::string string = value.ToStdString();
+  if (case_insensitive) {
+    for (char& c : string) {
+      if (IsASCIIUpper(c))
+        c |= 0x20;
+    }
+  }
+  return string;
+}
+
+bool ContainsInSpaceSeparatedList(const std::string& list, const std::string& value) {
+  if (value.empty())
+    return false;
+  size_t i = 0;
+  while (i < list.size()) {
+    while (i < list.size() && IsASCIISpace(list[i])) {
+      i++;
+    }
+    size_t start = i;
+    while (i < list.size() && !IsASCIISpace(list[i])) {
+      i++;
+    }
+    if (i - start == value.size() && list.compare(start, value.size(), value) == 0)
+      return true;
+  }
+  return false;
+}
+
+int ElementIndex(const Element& element) {
+  int index = 1;
+  for (Element* sibling = ElementTraversal::PreviousSibling(element); sibling != nullptr;
+       sibling = ElementTraversal::PreviousSibling(*sibling)) {
+    index++;
+  }
+  return index;
+}
+
+int ElementIndexFromEnd(const Element& element) {
+  int index = 1;
+  for (Element* sibling = ElementTraversal::NextSibling(element); sibling != nullptr;
+       sibling = ElementTraversal::NextSibling(*sibling)) {
+    index++;
+  }
+  return index;
+}
+
+}  // namespace
+
+bool SelectorChecker::Match(const CSSSelectorList& selector_list, const Element& element) {
+  for (const CSSComplexSelector& selector : selector_list.Selectors()) {
+    if (Match(selector, element))
+      return true;
+  }
+  return false;
+}
+
+bool SelectorChecker::Match(const CSSComplexSelector& selector, const Element& element) {
+  return MatchFrom(selector, 0, element);
+}
+
+// Match compounds right to left, backtracking through ancestors and siblings for the descendant and indirect
+// adjacent combinators.
+bool SelectorChecker::MatchFrom(const CSSComplexSelector& selector, size_t index, const Element& element) {
+  const CSSCompoundSelector& compound = selector.compounds[index];
+  if (!MatchCompound(compound, element))
+    return false;
+  if (index + 1 == selector.compounds.size())
+    return true;
+
+  switch (compound.relation) {
+    case CSSSelector::RelationType::kDescendant:
+      for (Element* ancestor = element.parentElement(); ancestor != nullptr; ancestor = ancestor->parentElement()) {
+        if (MatchFrom(selector, index + 1, *ancestor))
+          return true;
+      }
+      return false;
+    case CSSSelector::RelationType::kChild: {
+      Element* parent = element.parentElement();
+      return parent != nullptr && MatchFrom(selector, index + 1, *parent);
+    }
+    case CSSSelector::RelationType::kDirectAdjacent: {
+      Element* sibling = ElementTraversal::PreviousSibling(element);
+      return sibling != nullptr && MatchFrom(selector, index + 1, *sibling);
+    }
+    case CSSSelector::RelationType::kIndirectAdjacent:
+      for (Element* sibling = ElementTraversal::PreviousSibling(element); sibling != nullptr;
+           sibling = ElementTraversal::PreviousSibling(*sibling)) {
+        if (MatchFrom(selector, index + 1, *sibling))
+          return true;
+      }
+      return false;
+    case CSSSelector::RelationType::kNone:
+      break;
+  }
+  return false;
+}
+
+bool SelectorChecker::MatchCompound(const CSSCompoundSelector& compound, const Element& element) {
+  for (const CSSSelector& selector : compound.selectors) {
+    if (!MatchSimple(selector, element))
+      return false;
+  }
+  return true;
+}
+
+bool SelectorChecker::MatchSimple(const CSSSelector& selector, const Element& element) {
+  switch (selector.Match()) {
+    case CSSSelector::MatchType::kUniversal:
+      return true;
+    case CSSSelector::MatchType::kTag:
+      return element.HasTagName(selector.Value());
+    case CSSSelector::MatchType::kId: {
+      const AtomicString* id = element.FindAttribute(html_names::kIdAttr);
+      return id != nullptr && *id == selector.Value();
+    }
+    case CSSSelector::MatchType::kClass:
+      return element.HasClass(selector.Value());
+    case CSSSelector::MatchType::kPseudoClass:
+      return MatchPseudoClass(selector, element);
+    default:
+      return MatchAttribute(selector, element);
+  }
+}
+
+// https://drafts.csswg.org/selectors/#attribute-selectors
+bool SelectorChecker::MatchAttribute(const CSSSelector& selector, const Element& element) {
+  const AtomicString* value = element.FindAttribute(selector.Value());
+  if (value == nullptr)
+    return false;
+
+  switch (selector.Match()) {
+    case CSSSelector::MatchType::kAttributeSet:
+      return true;
+    case CSSSelector::MatchType::kAttributeExact:
+      if (!selector.AttributeMatchIsCaseInsensitive())
+        return *value == selector.AttributeValue();
+      break;
+    default:
+      break;
+  }
+
+  std::string string = AttributeValueForMatching(*value, selector.AttributeMatchIsCaseInsensitive());
+  const std::string& expected = selector.AttributeValueString();
+  switch (selector.Match()) {
+    case CSSSelector::MatchType::kAttributeExact:
+      return string == expected;
+    case CSSSelector::MatchType::kAttributeList:
+      return ContainsInSpaceSeparatedList(string, expected);
+    case CSSSelector::MatchType::kAttributeHyphen:
+      return string.compare(0, expected.size(), expected) == 0 &&
+             (string.size() == expected.size() || string[expected.size()] == '-');
+    case CSSSelector::MatchType::kAttributeBegin:
+      return !expected.empty() && string.compare(0, expected.size(), expected) == 0;
+    case CSSSelector::MatchType::kAttributeEnd:
+      return !expected.empty() && string.size() >= expected.size() &&
+             string.compare(string.size() - expected.size(), expected.size(), expected) == 0;
+    case CSSSelector::MatchType::kAttributeContain:
+      return !expected.empty() && string.find(expected) != std::string::npos;
+    default:
+      return false;
+  }
+}
+
+bool SelectorChecker::MatchPseudoClass(const CSSSelector& selector, const Element& element) {
+  switch (selector.GetPseudoType()) {
+    case CSSSelector::PseudoType::kNot:
+      return !Match(*selector.SelectorList(), element);
+    case CSSSelector::PseudoType::kFirstChild:
+      return ElementTraversal::PreviousSibling(element) == nullptr;
+    case CSSSelector::PseudoType::kLastChild:
+      return ElementTraversal::NextSibling(element) == nullptr;
+    case CSSSelector::PseudoType::kOnlyChild:
+      return ElementTraversal::PreviousSibling(element) == nullptr && ElementTraversal::NextSibling(element) == nullptr;
+    case CSSSelector::PseudoType::kNthChild:
+      return selector.MatchNth(ElementIndex(element));
+    case CSSSelector::PseudoType::kNthLastChild:
+      return selector.MatchNth(ElementIndexFromEnd(element));
+    case CSSSelector::PseudoType::kEmpty:
+      for (Node* child = element.firstChild(); child != nullptr; child = child->nextSibling()) {
+        if (child->IsElementNode())
+          return false;
+        if (child->IsTextNode() && To<CharacterData>(child)->length() > 0)
+          return false;
+      }
+      return true;
+    case CSSSelector::PseudoType::kRoot:
+      return element.parentNode() != nullptr && element.parentNode()->IsDocumentNode();
+    case CSSSelector::PseudoType::kUnknown:
+      break;
+  }
+  return false;
+}
+
+}  // namespace webf
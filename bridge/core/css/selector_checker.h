@@ -0,0 +1,33 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef BRIDGE_CORE_CSS_SELECTOR_CHECKER_H_
+#define BRIDGE_CORE_CSS_SELECTOR_CHECKER_H_
+
+#include "css_selector.h"
+#include "foundation/macros.h"
+
+namespace webf {
+
+class Element;
+
+// Matches parsed selectors against the DOM tree kept at the bridge side.
+class SelectorChecker {
+  WEBF_STATIC_ONLY(SelectorChecker);
+
+ public:
+  static bool Match(const CSSSelectorList& selector_list, const Element& element);
+  static bool Match(const CSSComplexSelector& selector, const Element& element);
+
+ private:
+  static bool MatchFrom(const CSSComplexSelector& selector, size_t index, const Element& element);
+  static bool MatchCompound(const CSSCompoundSelector& compound, const Element& element);
+  static bool MatchSimple(const CSSSelector& selector, const Element& element);
+  static bool MatchAttribute(const CSSSelector& selector, const Element& element);
+  static bool MatchPseudoClass(const CSSSelector& selector, const Element& element);
+};
+
+}  // namespace webf
+
+#endif  // BRIDGE_CORE_CSS_SELECTOR_CHECKER_H_
@@ -5,27 +5,35 @@
 
 #include "child_node_list.h"
 #include "bindings/qjs/cppgc/gc_visitor.h"
+#include "core/dom/document.h"
 
 namespace webf {
 
-ChildNodeList::ChildNodeList(ContainerNode* parent) : parent_(parent), NodeList(parent->ctx()) {}
+ChildNodeList::ChildNodeList(ContainerNode* parent)
+    : parent_(parent), NodeList(parent->ctx()), cached_dom_tree_version_(parent->GetDocument().DomTreeVersion()) {}
 ChildNodeList::~ChildNodeList() = default;
 
 Node* ChildNodeList::VirtualOwnerNode() const {
   return &OwnerNode();
 }
 
+unsigned ChildNodeList::length() const {
+  InvalidateCacheIfNeeded();
+  return collection_index_cache_.NodeCount(*this);
+}
+
 Node* ChildNodeList::item(unsigned index, ExceptionState& exception_state) const {
+  InvalidateCacheIfNeeded();
   return collection_index_cache_.NodeAt(*this, index);
 }
 
 bool ChildNodeList::NamedPropertyQuery(const AtomicString& key, ExceptionState& exception_state) {
   int32_t index = std::stoi(key.ToStdString());
-  return collection_index_cache_.NodeAt(*this, index);
+  return item(index, exception_state);
 }
 
 void ChildNodeList::NamedPropertyEnumerator(std::vector<AtomicString>& names, ExceptionState& exception_state) {
-  uint32_t size = collection_index_cache_.NodeCount(*this);
+  uint32_t size = length();
   for (int i = 0; i < size; i++) {
     names.emplace_back(AtomicString(ctx(), std::to_string(i)));
   }
@@ -53,6 +61,14 @@ Node* ChildNodeList::TraverseBackwardToOffset(unsigned offset, Node& current_nod
   return nullptr;
 }
 
+void ChildNodeList::InvalidateCacheIfNeeded() const {
+  uint64_t dom_tree_version = OwnerNode().GetDocument().DomTreeVersion();
+  if (dom_tree_version == cached_dom_tree_version_)
+    return;
+  collection_index_cache_.Invalidate();
+  cached_dom_tree_version_ = dom_tree_version;
+}
+
 void ChildNodeList::Trace(GCVisitor* visitor) const {
   visitor->Trace(parent_);
   collection_index_cache_.Trace(visitor);
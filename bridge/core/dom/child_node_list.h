@@ -50,7 +50,7 @@ class ChildNodeList : public NodeList {
   ~ChildNodeList() override;
 
   // DOM API.
-  unsigned length() const override { return collection_index_cache_.NodeCount(*this); }
+  unsigned length() const override;
 
   Node* item(unsigned index, ExceptionState& exception_state) const override;
 
@@ -75,9 +75,12 @@ class ChildNodeList : public NodeList {
  private:
   bool IsChildNodeList() const override { return true; }
   Node* VirtualOwnerNode() const override;
+  // Drop the cache when the tree changed since it was filled, see Document::DomTreeVersion().
+  void InvalidateCacheIfNeeded() const;
 
   Member<ContainerNode> parent_;
   mutable CollectionIndexCache<ChildNodeList, Node> collection_index_cache_;
+  mutable uint64_t cached_dom_tree_version_;
 };
 
 }  // namespace webf
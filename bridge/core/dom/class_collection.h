@@ -0,0 +1,25 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef BRIDGE_CORE_DOM_CLASS_COLLECTION_H_
+#define BRIDGE_CORE_DOM_CLASS_COLLECTION_H_
+
+#include "core/html/legacy/html_collection.h"
+
+namespace webf {
+
+// https://dom.spec.whatwg.org/#concept-getelementsbyclassname
+class ClassCollection final : public HTMLCollection {
+ public:
+  ClassCollection(ContainerNode* root_node, const AtomicString& class_names);
+
+  bool ElementMatches(const Element&) const override;
+
+ private:
+  std::vector<AtomicString> class_names_;
+};
+
+}  // namespace webf
+
+#endif  // BRIDGE_CORE_DOM_CLASS_COLLECTION_H_
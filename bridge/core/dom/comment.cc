@@ -32,8 +32,7 @@ std::string Comment::nodeName() const {
 
 Node* Comment::Clone(Document& factory, CloneChildrenFlag flag) const {
   Node* copy = Create(factory);
-  std::unique_ptr<NativeString> args_01 = stringToNativeString(std::to_string(copy->eventTargetId()));
-  GetExecutingContext()->uiCommandBuffer()->addCommand(eventTargetId(), UICommand::kCloneNode, std::move(args_01),
+  GetExecutingContext()->uiCommandBuffer()->addCommand(eventTargetId(), UICommand::kCloneNode, copy->eventTargetId(),
                                                        nullptr);
   return copy;
 }
@@ -6,10 +6,14 @@
 #include "container_node.h"
 #include "bindings/qjs/cppgc/garbage_collected.h"
 #include "bindings/qjs/cppgc/gc_visitor.h"
+#include "class_collection.h"
 #include "core/html/html_all_collection.h"
 #include "document.h"
 #include "document_fragment.h"
+#include "element_traversal.h"
 #include "node_traversal.h"
+#include "selector_query.h"
+#include "tag_collection.h"
 
 namespace webf {
 
@@ -26,6 +30,30 @@ std::vector<Element*> ContainerNode::Children() {
   return elements;
 }
 
+Element* ContainerNode::QuerySelector(const AtomicString& selectors, ExceptionState& exception_state) {
+  SelectorQuery* query = GetDocument().GetSelectorQueryCache().Add(ctx(), selectors, exception_state);
+  if (query == nullptr) {
+    return nullptr;
+  }
+  return query->QueryFirst(*this);
+}
+
+std::vector<Element*> ContainerNode::QuerySelectorAll(const AtomicString& selectors, ExceptionState& exception_state) {
+  SelectorQuery* query = GetDocument().GetSelectorQueryCache().Add(ctx(), selectors, exception_state);
+  if (query == nullptr) {
+    return {};
+  }
+  return query->QueryAll(*this);
+}
+
+HTMLCollection* ContainerNode::ElementsByClassName(const AtomicString& class_names) {
+  return MakeGarbageCollected<ClassCollection>(this, class_names);
+}
+
+HTMLCollection* ContainerNode::ElementsByTagName(const AtomicString& tag_name) {
+  return MakeGarbageCollected<TagCollection>(this, tag_name);
+}
+
 unsigned ContainerNode::CountChildren() const {
   unsigned count = 0;
   for (Node* node = firstChild(); node; node = node->nextSibling())
@@ -410,10 +438,9 @@ void ContainerNode::InsertBeforeCommon(Node& next_child, Node& new_child) {
   new_child.SetPreviousSibling(prev);
   new_child.SetNextSibling(&next_child);
 
-  std::unique_ptr<NativeString> args_01 = stringToNativeString(std::to_string(new_child.eventTargetId()));
-  std::unique_ptr<NativeString> args_02 = stringToNativeString("beforebegin");
   GetExecutingContext()->uiCommandBuffer()->addCommand(next_child.eventTargetId(), UICommand::kInsertAdjacentNode,
-                                                       std::move(args_01), std::move(args_02), nullptr);
+                                                       new_child.eventTargetId(),
+                                                       UICommandInsertPosition::kBeforeBegin, nullptr);
 }
 
 void ContainerNode::AppendChildCommon(Node& child) {
@@ -426,14 +453,14 @@ void ContainerNode::AppendChildCommon(Node& child) {
   }
   SetLastChild(&child);
 
-  std::unique_ptr<NativeString> args_01 = stringToNativeString(std::to_string(child.eventTargetId()));
-  std::unique_ptr<NativeString> args_02 = stringToNativeString("beforeend");
-
   GetExecutingContext()->uiCommandBuffer()->addCommand(eventTargetId(), UICommand::kInsertAdjacentNode,
-                                                       std::move(args_01), std::move(args_02), nullptr);
+                                                       child.eventTargetId(), UICommandInsertPosition::kBeforeEnd,
+                                                       nullptr);
 }
 
 void ContainerNode::NotifyNodeInsertedInternal(Node& root) {
+  GetDocument().IncrementDomTreeVersion();
+  root.UpdateEventPathListenerTypes();
   for (Node& node : NodeTraversal::InclusiveDescendantsOf(root)) {
     // As an optimization we don't notify leaf nodes when when inserting
     // into detached subtrees that are not in a shadow tree.
@@ -444,6 +471,8 @@ void ContainerNode::NotifyNodeInsertedInternal(Node& root) {
 }
 
 void ContainerNode::NotifyNodeRemoved(Node& root) {
+  GetDocument().IncrementDomTreeVersion();
+  root.UpdateEventPathListenerTypes();
   for (Node& node : NodeTraversal::InclusiveDescendantsOf(root)) {
     // As an optimization we skip notifying Text nodes and other leaf nodes
     // of removal when they're not in the Document tree and not in a shadow root
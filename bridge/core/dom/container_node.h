@@ -14,6 +14,7 @@
 namespace webf {
 
 class HTMLAllCollection;
+class HTMLCollection;
 
 // This constant controls how much buffer is initially allocated
 // for a Node Vector that is used to store child Nodes of a given Node.
@@ -33,6 +34,12 @@ class ContainerNode : public Node {
 
   std::vector<Element*> Children();
 
+  // Queries over the descendants, answered at the bridge side without calling dart side.
+  Element* QuerySelector(const AtomicString& selectors, ExceptionState& exception_state);
+  std::vector<Element*> QuerySelectorAll(const AtomicString& selectors, ExceptionState& exception_state);
+  HTMLCollection* ElementsByClassName(const AtomicString& class_names);
+  HTMLCollection* ElementsByTagName(const AtomicString& tag_name);
+
   unsigned CountChildren() const;
 
   Node* InsertBefore(Node* new_child, Node* ref_child, ExceptionState&);
@@ -9,6 +9,7 @@
 #include "core/dom/document_fragment.h"
 #include "core/dom/element.h"
 #include "core/dom/events/event_target.h"
+#include "core/dom/live_node_list_base.h"
 #include "core/dom/text.h"
 #include "core/frame/window.h"
 #include "core/html/custom/widget_element.h"
@@ -23,6 +24,7 @@
 #include "foundation/ascii_types.h"
 #include "foundation/native_value_converter.h"
 #include "html_element_factory.h"
+#include "html_names.h"
 #include "qjs_document.h"
 
 namespace webf {
@@ -120,59 +122,93 @@ bool Document::ChildTypeAllowed(NodeType type) const {
 }
 
 Element* Document::querySelector(const AtomicString& selectors, ExceptionState& exception_state) {
-  NativeValue arguments[] = {NativeValueConverter<NativeTypeString>::ToNativeValue(selectors)};
-  NativeValue result = InvokeBindingMethod(binding_call_methods::kquerySelector, 1, arguments, exception_state);
-  if (exception_state.HasException()) {
-    return nullptr;
-  }
-  return NativeValueConverter<NativeTypePointer<Element>>::FromNativeValue(ctx(), result);
+  return QuerySelector(selectors, exception_state);
 }
 
 std::vector<Element*> Document::querySelectorAll(const AtomicString& selectors, ExceptionState& exception_state) {
-  NativeValue arguments[] = {NativeValueConverter<NativeTypeString>::ToNativeValue(selectors)};
-  NativeValue result = InvokeBindingMethod(binding_call_methods::kquerySelectorAll, 1, arguments, exception_state);
-  if (exception_state.HasException()) {
-    return {};
-  }
-  return NativeValueConverter<NativeTypeArray<NativeTypePointer<Element>>>::FromNativeValue(ctx(), result);
+  return QuerySelectorAll(selectors, exception_state);
 }
 
 Element* Document::getElementById(const AtomicString& id, ExceptionState& exception_state) {
-  NativeValue arguments[] = {NativeValueConverter<NativeTypeString>::ToNativeValue(id)};
-  NativeValue result = InvokeBindingMethod(binding_call_methods::kgetElementById, 1, arguments, exception_state);
-  if (exception_state.HasException()) {
-    return {};
-  }
-  return NativeValueConverter<NativeTypePointer<Element>>::FromNativeValue(ctx(), result);
+  return TreeScope::getElementById(id);
 }
 
-std::vector<Element*> Document::getElementsByClassName(const AtomicString& class_name,
-                                                       ExceptionState& exception_state) {
-  NativeValue arguments[] = {NativeValueConverter<NativeTypeString>::ToNativeValue(class_name)};
-  NativeValue result =
-      InvokeBindingMethod(binding_call_methods::kgetElementsByClassName, 1, arguments, exception_state);
-  if (exception_state.HasException()) {
-    return {};
-  }
-  return NativeValueConverter<NativeTypeArray<NativeTypePointer<Element>>>::FromNativeValue(ctx(), result);
+HTMLCollection* Document::getElementsByClassName(const AtomicString& class_name, ExceptionState& exception_state) {
+  return ElementsByClassName(class_name);
 }
 
-std::vector<Element*> Document::getElementsByTagName(const AtomicString& tag_name, ExceptionState& exception_state) {
-  NativeValue arguments[] = {NativeValueConverter<NativeTypeString>::ToNativeValue(tag_name)};
-  NativeValue result = InvokeBindingMethod(binding_call_methods::kgetElementsByTagName, 1, arguments, exception_state);
-  if (exception_state.HasException()) {
-    return {};
-  }
-  return NativeValueConverter<NativeTypeArray<NativeTypePointer<Element>>>::FromNativeValue(ctx(), result);
+HTMLCollection* Document::getElementsByTagName(const AtomicString& tag_name, ExceptionState& exception_state) {
+  return ElementsByTagName(tag_name);
 }
 
 std::vector<Element*> Document::getElementsByName(const AtomicString& name, ExceptionState& exception_state) {
-  NativeValue arguments[] = {NativeValueConverter<NativeTypeString>::ToNativeValue(name)};
-  NativeValue result = InvokeBindingMethod(binding_call_methods::kgetElementsByName, 1, arguments, exception_state);
-  if (exception_state.HasException()) {
-    return {};
+  std::vector<Element*> elements;
+  for (Element& element : ElementTraversal::DescendantsOf(*this)) {
+    const AtomicString* element_name = element.FindAttribute(html_names::kNameAttr);
+    if (element_name != nullptr && *element_name == name) {
+      elements.emplace_back(&element);
+    }
+  }
+  return elements;
+}
+
+ScriptValue Document::___webf_get_bounding_client_rects__(const std::vector<Element*>& elements,
+                                                         ExceptionState& exception_state) {
+  // Elements read since the last layout keep their snapshot, only the others are sent to dart side in one call.
+  std::vector<Element*> stale_elements;
+  std::vector<NativeValue> stale_pointers;
+  for (auto* element : elements) {
+    if (!element->HasValidGeometrySnapshot()) {
+      stale_elements.emplace_back(element);
+      stale_pointers.emplace_back(NativeValueConverter<NativeTypePointer<Element>>::ToNativeValue(element));
+    }
+  }
+
+  if (!stale_elements.empty()) {
+    NativeValue arguments[] = {Native_NewList(stale_pointers.size(), stale_pointers.data())};
+    NativeValue result =
+        InvokeBindingMethod(binding_call_methods::kgetGeometrySnapshots, 1, arguments, exception_state);
+    if (exception_state.HasException()) {
+      return ScriptValue::Empty(ctx());
+    }
+
+    assert(result.tag == NativeTag::TAG_LIST);
+    assert(result.uint32 == stale_elements.size() * kElementGeometryPropertyCount);
+    auto* items = static_cast<NativeValue*>(result.u.ptr);
+    int64_t layout_generation = GetExecutingContext()->uiCommandBuffer()->layoutGeneration();
+    double values[kElementGeometryPropertyCount];
+    for (size_t i = 0; i < stale_elements.size(); i++) {
+      for (uint32_t j = 0; j < kElementGeometryPropertyCount; j++) {
+        values[j] =
+            NativeValueConverter<NativeTypeDouble>::FromNativeValue(items[i * kElementGeometryPropertyCount + j]);
+      }
+      stale_elements[i]->UpdateGeometrySnapshot(values, layout_generation);
+    }
+    // The list is allocated by dart side with malloc.
+    free(items);
+  }
+
+  std::vector<double> rects;
+  rects.reserve(elements.size() * 4);
+  for (auto* element : elements) {
+    rects.emplace_back(element->GetGeometry(ElementGeometryProperty::kRectX));
+    rects.emplace_back(element->GetGeometry(ElementGeometryProperty::kRectY));
+    rects.emplace_back(element->GetGeometry(ElementGeometryProperty::kRectWidth));
+    rects.emplace_back(element->GetGeometry(ElementGeometryProperty::kRectHeight));
   }
-  return NativeValueConverter<NativeTypeArray<NativeTypePointer<Element>>>::FromNativeValue(ctx(), result);
+
+  JSValue buffer =
+      JS_NewArrayBufferCopy(ctx(), reinterpret_cast<const uint8_t*>(rects.data()), rects.size() * sizeof(double));
+  JSValue global = JS_GetGlobalObject(ctx());
+  JSValue constructor = JS_GetPropertyStr(ctx(), global, "Float64Array");
+  JSValue array = JS_CallConstructor(ctx(), constructor, 1, &buffer);
+  JS_FreeValue(ctx(), constructor);
+  JS_FreeValue(ctx(), global);
+  JS_FreeValue(ctx(), buffer);
+
+  ScriptValue rect_array = ScriptValue(ctx(), array);
+  JS_FreeValue(ctx(), array);
+  return rect_array;
 }
 
 template <typename CharType>
@@ -311,6 +347,27 @@ std::shared_ptr<EventListener> Document::GetWindowAttributeEventListener(const A
   return window->GetAttributeEventListener(event_type);
 }
 
+void Document::InvalidateNodeListCaches(const AtomicString& attr_name) {
+  for (int type = kDoNotInvalidateOnAttributeChanges; type < kNumNodeListInvalidationTypes; type++) {
+    if (LiveNodeListBase::ShouldInvalidateTypeOnAttributeChange(static_cast<NodeListInvalidationType>(type), attr_name))
+      node_list_invalidation_versions_[type]++;
+  }
+}
+
+SelectorQueryCache& Document::GetSelectorQueryCache() {
+  if (selector_query_cache_ == nullptr) {
+    selector_query_cache_ = std::make_unique<SelectorQueryCache>();
+  }
+  return *selector_query_cache_;
+}
+
+HTMLFragmentTemplateCache& Document::GetFragmentTemplateCache() {
+  if (fragment_template_cache_ == nullptr) {
+    fragment_template_cache_ = std::make_unique<HTMLFragmentTemplateCache>(GetExecutingContext());
+  }
+  return *fragment_template_cache_;
+}
+
 bool Document::IsAttributeDefinedInternal(const AtomicString& key) const {
   return QJSDocument::IsAttributeDefinedInternal(key) || Node::IsAttributeDefinedInternal(key);
 }
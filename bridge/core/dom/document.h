@@ -7,7 +7,9 @@
 
 #include "bindings/qjs/cppgc/local_handle.h"
 #include "container_node.h"
+#include "core/html/parser/html_fragment_template.h"
 #include "scripted_animation_controller.h"
+#include "selector_query.h"
 #include "tree_scope.h"
 
 namespace webf {
@@ -61,10 +63,13 @@ class Document : public ContainerNode, public TreeScope {
   std::vector<Element*> querySelectorAll(const AtomicString& selectors, ExceptionState& exception_state);
 
   Element* getElementById(const AtomicString& id, ExceptionState& exception_state);
-  std::vector<Element*> getElementsByClassName(const AtomicString& class_name, ExceptionState& exception_state);
-  std::vector<Element*> getElementsByTagName(const AtomicString& tag_name, ExceptionState& exception_state);
+  HTMLCollection* getElementsByClassName(const AtomicString& class_name, ExceptionState& exception_state);
+  HTMLCollection* getElementsByTagName(const AtomicString& tag_name, ExceptionState& exception_state);
   std::vector<Element*> getElementsByName(const AtomicString& name, ExceptionState& exception_state);
 
+  ScriptValue ___webf_get_bounding_client_rects__(const std::vector<Element*>& elements,
+                                                   ExceptionState& exception_state);
+
   // The following implements the rule from HTML 4 for what valid names are.
   static bool IsValidName(const AtomicString& name);
 
@@ -89,6 +94,16 @@ class Document : public ContainerNode, public TreeScope {
   }
   int NodeCount() const { return node_count_; }
 
+  // Live collections remember the versions their caches were filled at and drop the caches once these move on, so
+  // mutating the tree only costs a counter increment.
+  uint64_t DomTreeVersion() const { return dom_tree_version_; }
+  void IncrementDomTreeVersion() { dom_tree_version_++; }
+  uint64_t NodeListInvalidationVersion(NodeListInvalidationType type) const {
+    return node_list_invalidation_versions_[type];
+  }
+  // Bump the version of every invalidation type which depends on |attr_name|.
+  void InvalidateNodeListCaches(const AtomicString& attr_name);
+
   uint32_t RequestAnimationFrame(const std::shared_ptr<FrameCallback>& callback, ExceptionState& exception_state);
   void CancelAnimationFrame(uint32_t request_id, ExceptionState& exception_state);
 
@@ -101,11 +116,18 @@ class Document : public ContainerNode, public TreeScope {
 
   bool IsAttributeDefinedInternal(const AtomicString& key) const override;
 
+  SelectorQueryCache& GetSelectorQueryCache();
+  HTMLFragmentTemplateCache& GetFragmentTemplateCache();
+
   void Trace(GCVisitor* visitor) const override;
 
  private:
   int node_count_{0};
+  uint64_t dom_tree_version_{0};
+  uint64_t node_list_invalidation_versions_[kNumNodeListInvalidationTypes]{};
   ScriptAnimationController script_animation_controller_;
+  std::unique_ptr<SelectorQueryCache> selector_query_cache_;
+  std::unique_ptr<HTMLFragmentTemplateCache> fragment_template_cache_;
 };
 
 template <>
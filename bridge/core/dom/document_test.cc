@@ -2,6 +2,8 @@
  * Copyright (C) 2019-2022 The Kraken authors. All rights reserved.
  * Copyright (C) 2022-present The WebF authors. All rights reserved.
  */
+#include "core/dom/document.h"
+#include "core/html/html_body_element.h"
 #include "gtest/gtest.h"
 #include "webf_test_env.h"
 
@@ -184,3 +186,76 @@ TEST(document, all) {
   EXPECT_EQ(errorCalled, false);
   EXPECT_EQ(logCalled, true);
 }
+
+TEST(Document, getBoundingClientRectsFromSnapshots) {
+  bool static errorCalled = false;
+  bool static logCalled = false;
+  webf::WebFPage::consoleMessageHandler = [](void* ctx, const std::string& message, int logLevel) {
+    logCalled = true;
+    EXPECT_STREQ(message.c_str(), "true 8 1,2,3,4,5,6,7,8");
+  };
+  auto bridge = TEST_init([](int32_t contextId, const char* errmsg) {
+    WEBF_LOG(VERBOSE) << errmsg;
+    errorCalled = true;
+  });
+  auto context = bridge->GetExecutingContext();
+  const char* code =
+      "document.body.appendChild(document.createElement('div'));"
+      "document.body.appendChild(document.createElement('div'));";
+  bridge->evaluateScript(code, strlen(code), "vm://", 0);
+
+  // Both elements are measured already, no call to dart side is needed.
+  double first[kElementGeometryPropertyCount] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 3, 4};
+  double second[kElementGeometryPropertyCount] = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 5, 6, 7, 8};
+  int64_t layout_generation = context->uiCommandBuffer()->layoutGeneration();
+  To<Element>(context->document()->body()->firstChild())->UpdateGeometrySnapshot(first, layout_generation);
+  To<Element>(context->document()->body()->lastChild())->UpdateGeometrySnapshot(second, layout_generation);
+
+  const char* read =
+      "let rects = document.__webf_get_bounding_client_rects__(Array.from(document.body.childNodes));"
+      "console.log(rects instanceof Float64Array, rects.length, rects.join(','));";
+  bridge->evaluateScript(read, strlen(read), "vm://", 0);
+  EXPECT_EQ(errorCalled, false);
+  EXPECT_EQ(logCalled, true);
+}
+
+TEST(Document, getElementByIdFollowsTreeChanges) {
+  bool static errorCalled = false;
+  bool static logCalled = false;
+  webf::WebFPage::consoleMessageHandler = [](void* ctx, const std::string& message, int logLevel) {
+    logCalled = true;
+    EXPECT_STREQ(message.c_str(), "false true true first second true true second false");
+  };
+  auto bridge = TEST_init([](int32_t contextId, const char* errmsg) {
+    WEBF_LOG(VERBOSE) << errmsg;
+    errorCalled = true;
+  });
+  const char* code =
+      "let container = document.createElement('div');"
+      "let first = document.createElement('div');"
+      "first.id = 'target';"
+      "first.className = 'first';"
+      "container.appendChild(first);"
+      "let detached = document.getElementById('target') === first;"
+      "document.body.appendChild(container);"
+      "let connected = document.getElementById('target') === first;"
+      "let second = document.createElement('div');"
+      "second.setAttribute('id', 'target');"
+      "second.className = 'second';"
+      "document.body.insertBefore(second, container);"
+      "let secondFirst = document.getElementById('target') === second;"
+      "let all = Array.from(document.querySelectorAll('#target')).map(e => e.className).reverse().join(' ');"
+      "document.body.removeChild(second);"
+      "let afterRemove = document.getElementById('target') === first;"
+      "first.id = 'renamed';"
+      "let afterRename = document.getElementById('target') === null;"
+      "let renamed = document.getElementById('renamed') === first;"
+      "document.body.appendChild(second);"
+      "let reinserted = document.getElementById('target').className;"
+      "second.removeAttribute('id');"
+      "console.log(detached, connected, secondFirst, all, afterRemove, afterRename && renamed, reinserted,"
+      "  document.getElementById('target') !== null);";
+  bridge->evaluateScript(code, strlen(code), "vm://", 0);
+  EXPECT_EQ(errorCalled, false);
+  EXPECT_EQ(logCalled, true);
+}
@@ -3,23 +3,47 @@
  * Copyright (C) 2022-present The WebF authors. All rights reserved.
  */
 #include "element.h"
+#include <cstring>
+#include <unordered_set>
 #include <utility>
 #include "binding_call_methods.h"
 #include "bindings/qjs/exception_state.h"
 #include "bindings/qjs/script_promise.h"
 #include "bindings/qjs/script_promise_resolver.h"
+#include "core/dom/comment.h"
 #include "core/dom/document_fragment.h"
+#include "core/dom/markup_escape.h"
+#include "core/dom/selector_query.h"
 #include "core/fileapi/blob.h"
 #include "core/html/html_template_element.h"
 #include "core/html/parser/html_parser.h"
 #include "element_attribute_names.h"
 #include "foundation/native_value_converter.h"
 #include "html_element_type_helper.h"
+#include "html_names.h"
 #include "qjs_element.h"
 #include "text.h"
 
 namespace webf {
 
+namespace {
+
+// https://html.spec.whatwg.org/#void-elements, serialized without children and end tag.
+bool IsVoidElement(const std::string& tag_name) {
+  static const std::unordered_set<std::string> void_elements{"area", "base", "br",   "col",   "embed", "hr",  "img",
+                                                             "input", "link", "meta", "source", "track", "wbr"};
+  return void_elements.count(tag_name) > 0;
+}
+
+// Text under these elements is serialized literally, see https://html.spec.whatwg.org/#serialising-html-fragments
+bool IsRawTextElement(const std::string& tag_name) {
+  static const std::unordered_set<std::string> raw_text_elements{"style",   "script",   "xmp",      "iframe",
+                                                                 "noembed", "noframes", "plaintext"};
+  return raw_text_elements.count(tag_name) > 0;
+}
+
+}  // namespace
+
 Element::Element(const AtomicString& tag_name, Document* document, Node::ConstructionType construction_type)
     : ContainerNode(document, construction_type), tag_name_(tag_name) {
   GetExecutingContext()->uiCommandBuffer()->addCommand(eventTargetId(), UICommand::kCreateElement,
@@ -62,14 +86,88 @@ void Element::setAttribute(const AtomicString& name, const AtomicString& value,
 }
 
 void Element::removeAttribute(const AtomicString& name, ExceptionState& exception_state) {
+  const AtomicString* value = FindAttribute(name);
+  if (value == nullptr) {
+    EnsureElementAttributes().removeAttribute(name, exception_state);
+    return;
+  }
+  AtomicString old_value = *value;
   EnsureElementAttributes().removeAttribute(name, exception_state);
+  _didModifyAttribute(name, old_value, AtomicString::Empty());
+}
+
+AtomicString Element::id() const {
+  const AtomicString* value = FindAttribute(html_names::kIdAttr);
+  return value != nullptr ? *value : AtomicString::Empty();
+}
+
+void Element::setId(const AtomicString& value, ExceptionState& exception_state) {
+  setAttribute(html_names::kIdAttr, value, exception_state);
+}
+
+AtomicString Element::className() const {
+  const AtomicString* value = FindAttribute(html_names::kClassAttr);
+  return value != nullptr ? *value : AtomicString::Empty();
+}
+
+void Element::setClassName(const AtomicString& value, ExceptionState& exception_state) {
+  setAttribute(html_names::kClassAttr, value, exception_state);
 }
 
 BoundingClientRect* Element::getBoundingClientRect(ExceptionState& exception_state) {
-  GetExecutingContext()->FlushUICommand();
-  NativeValue result = InvokeBindingMethod(binding_call_methods::kgetBoundingClientRect, 0, nullptr, exception_state);
-  return BoundingClientRect::Create(
-      GetExecutingContext(), NativeValueConverter<NativeTypePointer<NativeBindingObject>>::FromNativeValue(result));
+  return BoundingClientRect::Create(GetExecutingContext(), GetGeometry(ElementGeometryProperty::kRectX),
+                                    GetGeometry(ElementGeometryProperty::kRectY),
+                                    GetGeometry(ElementGeometryProperty::kRectWidth),
+                                    GetGeometry(ElementGeometryProperty::kRectHeight));
+}
+
+void Element::setScrollTop(double value, ExceptionState& exception_state) {
+  SetBindingProperty(binding_call_methods::kscrollTop, NativeValueConverter<NativeTypeDouble>::ToNativeValue(value),
+                     exception_state);
+}
+
+void Element::setScrollLeft(double value, ExceptionState& exception_state) {
+  SetBindingProperty(binding_call_methods::kscrollLeft, NativeValueConverter<NativeTypeDouble>::ToNativeValue(value),
+                     exception_state);
+}
+
+double Element::GetGeometry(ElementGeometryProperty property) {
+  if (HasValidGeometrySnapshot()) {
+    return geometry_snapshot_->value(property);
+  }
+
+  ExceptionState exception_state;
+  NativeValue result = InvokeBindingMethod(binding_call_methods::kgetGeometrySnapshot, 0, nullptr, exception_state);
+  if (UNLIKELY(exception_state.HasException())) {
+    GetExecutingContext()->HandleException(exception_state);
+    return 0;
+  }
+
+  assert(result.tag == NativeTag::TAG_LIST);
+  assert(result.uint32 == kElementGeometryPropertyCount);
+  auto* items = static_cast<NativeValue*>(result.u.ptr);
+  double values[kElementGeometryPropertyCount];
+  for (uint32_t i = 0; i < kElementGeometryPropertyCount; i++) {
+    values[i] = NativeValueConverter<NativeTypeDouble>::FromNativeValue(items[i]);
+  }
+  // The list is allocated by dart side with malloc.
+  free(items);
+
+  UpdateGeometrySnapshot(values, GetExecutingContext()->uiCommandBuffer()->layoutGeneration());
+  return geometry_snapshot_->value(property);
+}
+
+bool Element::HasValidGeometrySnapshot() {
+  return geometry_snapshot_ != nullptr &&
+         geometry_snapshot_->layout_generation == GetExecutingContext()->uiCommandBuffer()->layoutGeneration();
+}
+
+void Element::UpdateGeometrySnapshot(const double* values, int64_t layout_generation) {
+  if (geometry_snapshot_ == nullptr) {
+    geometry_snapshot_ = std::make_unique<ElementGeometrySnapshot>();
+  }
+  memcpy(geometry_snapshot_->values, values, sizeof(geometry_snapshot_->values));
+  geometry_snapshot_->layout_generation = layout_generation;
 }
 
 void Element::click(ExceptionState& exception_state) {
@@ -137,6 +235,23 @@ bool Element::HasTagName(const AtomicString& name) const {
   return name == tag_name_;
 }
 
+const AtomicString* Element::FindAttribute(const AtomicString& name) const {
+  return attributes_ != nullptr ? attributes_->FindAttribute(name) : nullptr;
+}
+
+bool Element::HasClass(const AtomicString& class_name) const {
+  const AtomicString* class_attribute = FindAttribute(html_names::kClassAttr);
+  if (class_attribute == nullptr) {
+    return false;
+  }
+  for (const AtomicString& name : EnsureElementData().ClassNames(ctx(), *class_attribute)) {
+    if (name == class_name) {
+      return true;
+    }
+  }
+  return false;
+}
+
 std::string Element::nodeValue() const {
   return "";
 }
@@ -149,23 +264,40 @@ std::string Element::nodeNameLowerCase() const {
   return tag_name_.ToStdString();
 }
 
-std::vector<Element*> Element::getElementsByClassName(const AtomicString& class_name, ExceptionState& exception_state) {
-  NativeValue arguments[] = {NativeValueConverter<NativeTypeString>::ToNativeValue(class_name)};
-  NativeValue result =
-      InvokeBindingMethod(binding_call_methods::kgetElementsByClassName, 1, arguments, exception_state);
-  if (exception_state.HasException()) {
-    return {};
+HTMLCollection* Element::getElementsByClassName(const AtomicString& class_name, ExceptionState& exception_state) {
+  return ElementsByClassName(class_name);
+}
+
+HTMLCollection* Element::getElementsByTagName(const AtomicString& tag_name, ExceptionState& exception_state) {
+  return ElementsByTagName(tag_name);
+}
+
+Element* Element::querySelector(const AtomicString& selectors, ExceptionState& exception_state) {
+  return QuerySelector(selectors, exception_state);
+}
+
+std::vector<Element*> Element::querySelectorAll(const AtomicString& selectors, ExceptionState& exception_state) {
+  return QuerySelectorAll(selectors, exception_state);
+}
+
+bool Element::matches(const AtomicString& selectors, ExceptionState& exception_state) {
+  SelectorQuery* query = GetDocument().GetSelectorQueryCache().Add(ctx(), selectors, exception_state);
+  if (query == nullptr) {
+    return false;
   }
-  return NativeValueConverter<NativeTypeArray<NativeTypePointer<Element>>>::FromNativeValue(ctx(), result);
+  return query->Matches(*this);
 }
 
-std::vector<Element*> Element::getElementsByTagName(const AtomicString& tag_name, ExceptionState& exception_state) {
-  NativeValue arguments[] = {NativeValueConverter<NativeTypeString>::ToNativeValue(tag_name)};
-  NativeValue result = InvokeBindingMethod(binding_call_methods::kgetElementsByTagName, 1, arguments, exception_state);
-  if (exception_state.HasException()) {
-    return {};
+Element* Element::closest(const AtomicString& selectors, ExceptionState& exception_state) {
+  SelectorQuery* query = GetDocument().GetSelectorQueryCache().Add(ctx(), selectors, exception_state);
+  if (query == nullptr) {
+    return nullptr;
+  }
+  for (Element* element = this; element != nullptr; element = element->parentElement()) {
+    if (query->Matches(*element))
+      return element;
   }
-  return NativeValueConverter<NativeTypeArray<NativeTypePointer<Element>>>::FromNativeValue(ctx(), result);
+  return nullptr;
 }
 
 CSSStyleDeclaration* Element::style() {
@@ -231,6 +363,16 @@ void Element::Trace(GCVisitor* visitor) const {
   ContainerNode::Trace(visitor);
 }
 
+void Element::DidCreateDeferredWrapper() const {
+  // The GC traces attributes and style from the JS object of the element, so they need their own JS objects now.
+  if (attributes_ != nullptr) {
+    attributes_->EnsureWrapper();
+  }
+  if (cssom_wrapper_ != nullptr) {
+    cssom_wrapper_->EnsureWrapper();
+  }
+}
+
 ElementData& Element::EnsureElementData() const {
   if (element_data_ == nullptr) {
     element_data_ = std::make_unique<ElementData>();
@@ -246,8 +388,7 @@ Node* Element::Clone(Document& factory, CloneChildrenFlag flag) const {
     copy = &CloneWithChildren(flag, &factory);
   }
 
-  std::unique_ptr<NativeString> args_01 = stringToNativeString(std::to_string(copy->eventTargetId()));
-  GetExecutingContext()->uiCommandBuffer()->addCommand(eventTargetId(), UICommand::kCloneNode, std::move(args_01),
+  GetExecutingContext()->uiCommandBuffer()->addCommand(eventTargetId(), UICommand::kCloneNode, copy->eventTargetId(),
                                                        nullptr);
 
   return copy;
@@ -320,58 +461,97 @@ ScriptPromise Element::toBlob(double device_pixel_ratio, ExceptionState& excepti
 }
 
 std::string Element::outerHTML() {
-  std::string s = "<" + nodeNameLowerCase();
+  std::string result;
+  AppendOuterHTML(result);
+  return result;
+}
+
+std::string Element::innerHTML() {
+  std::string result;
+  AppendInnerHTML(result);
+  return result;
+}
+
+void Element::setInnerHTML(const AtomicString& value, ExceptionState& exception_state) {
+  if (auto* template_element = DynamicTo<HTMLTemplateElement>(this)) {
+    HTMLParser::parseHTMLFragment(value.ToStdString(), template_element->content());
+  } else {
+    HTMLParser::parseHTMLFragment(value.ToStdString(), this);
+  }
+}
+
+void Element::AppendOuterHTML(std::string& result) const {
+  std::string tag_name = nodeNameLowerCase();
+  result += '<';
+  result += tag_name;
 
-  // Read attributes
   if (attributes_ != nullptr) {
-    s += " " + attributes_->ToString();
+    attributes_->ToString(result);
   }
   if (cssom_wrapper_ != nullptr) {
-    s += " style=\"" + cssom_wrapper_->ToString();
+    size_t style_start = result.size();
+    result += " style=\"";
+    size_t declarations_start = result.size();
+    cssom_wrapper_->ToString(result);
+    if (result.size() == declarations_start) {
+      result.resize(style_start);
+    } else {
+      result += '"';
+    }
   }
+  result += '>';
 
-  s += ">";
+  if (IsVoidElement(tag_name))
+    return;
 
-  std::string childHTML = innerHTML();
-  s += childHTML;
-  s += "</" + nodeNameLowerCase() + ">";
-
-  return s;
+  AppendInnerHTML(result);
+  result += "</";
+  result += tag_name;
+  result += '>';
 }
 
-std::string Element::innerHTML() {
-  std::string s;
-
+void Element::AppendInnerHTML(std::string& result) const {
   // If Element is TemplateElement, the innerHTML content is the content of documentFragment.
-  Node* parent = To<Node>(this);
-
+  const ContainerNode* parent = this;
   if (auto* template_element = DynamicTo<HTMLTemplateElement>(this)) {
-    parent = To<Node>(template_element->content());
+    parent = template_element->content();
   }
 
-  if (parent->firstChild() == nullptr)
-    return s;
-
-  auto* child = parent->firstChild();
-  while (child != nullptr) {
+  bool raw_text = IsRawTextElement(nodeNameLowerCase());
+  for (Node* child = parent->firstChild(); child != nullptr; child = child->nextSibling()) {
     if (auto* element = DynamicTo<Element>(child)) {
-      s += element->outerHTML();
+      element->AppendOuterHTML(result);
     } else if (auto* text = DynamicTo<Text>(child)) {
-      s += text->data().ToStdString();
+      if (raw_text) {
+        result += text->data().ToStdString();
+      } else {
+        AppendEscapedMarkup(result, text->data().ToStdString(), MarkupEscapeMode::kText);
+      }
+    } else if (auto* comment = DynamicTo<Comment>(child)) {
+      result += "<!--";
+      result += comment->data().ToStdString();
+      result += "-->";
     }
-    child = child->nextSibling();
   }
+}
+
+void Element::InsertedInto(ContainerNode& insertion_point) {
+  ContainerNode::InsertedInto(insertion_point);
+  if (!insertion_point.isConnected())
+    return;
 
-  return s;
+  const AtomicString* id = FindAttribute(html_names::kIdAttr);
+  if (id != nullptr && !id->IsEmpty())
+    GetTreeScope().AddElementById(*id, *this);
 }
 
-void Element::setInnerHTML(const AtomicString& value, ExceptionState& exception_state) {
-  auto html = value.ToStdString();
-  if (auto* template_element = DynamicTo<HTMLTemplateElement>(this)) {
-    HTMLParser::parseHTMLFragment(html.c_str(), html.size(), template_element->content());
-  } else {
-    HTMLParser::parseHTMLFragment(html.c_str(), html.size(), this);
+void Element::RemovedFrom(ContainerNode& insertion_point) {
+  if (insertion_point.isConnected()) {
+    const AtomicString* id = FindAttribute(html_names::kIdAttr);
+    if (id != nullptr && !id->IsEmpty())
+      GetTreeScope().RemoveElementById(*id, *this);
   }
+  ContainerNode::RemovedFrom(insertion_point);
 }
 
 void Element::_notifyNodeRemoved(Node* node) {}
@@ -384,7 +564,19 @@ void Element::_notifyNodeInsert(Node* insertNode){
 
 void Element::_notifyChildInsert() {}
 
-void Element::_didModifyAttribute(const AtomicString& name, const AtomicString& oldId, const AtomicString& newId) {}
+void Element::_didModifyAttribute(const AtomicString& name, const AtomicString& oldId, const AtomicString& newId) {
+  if (oldId == newId)
+    return;
+  GetDocument().InvalidateNodeListCaches(name);
+  if (name != html_names::kIdAttr || !isConnected())
+    return;
+
+  TreeScope& scope = GetTreeScope();
+  if (!oldId.IsEmpty())
+    scope.RemoveElementById(oldId, *this);
+  if (!newId.IsEmpty())
+    scope.AddElementById(newId, *this);
+}
 
 void Element::_beforeUpdateId(JSValue oldIdValue, JSValue newIdValue) {}
 
@@ -4,25 +4,26 @@ import {ScrollToOptions} from "./scroll_to_options";
 import { ElementAttributes } from './legacy/element_attributes';
 import {CSSStyleDeclaration} from "../css/legacy/css_style_declaration";
 import {ParentNode} from "./parent_node";
+import {HTMLCollection} from "../html/legacy/html_collection";
 
 interface Element extends Node, ParentNode {
-  id: DartImpl<string>;
-  className: DartImpl<string>;
+  id: string;
+  className: string;
   class: DartImpl<string>;
   name: DartImpl<string>;
   readonly attributes: ElementAttributes;
   readonly style: CSSStyleDeclaration;
-  readonly clientHeight: DartImpl<number>;
-  readonly clientLeft: DartImpl<number>;
-  readonly clientTop: DartImpl<number>;
-  readonly clientWidth: DartImpl<number>;
+  readonly clientHeight: number;
+  readonly clientLeft: number;
+  readonly clientTop: number;
+  readonly clientWidth: number;
   readonly outerHTML: string;
   innerHTML: string;
   readonly ownerDocument: Document;
-  scrollLeft: DartImpl<number>;
-  scrollTop: DartImpl<number>;
-  readonly scrollWidth: DartImpl<number>;
-  readonly scrollHeight: DartImpl<number>;
+  scrollLeft: number;
+  scrollTop: number;
+  readonly scrollWidth: number;
+  readonly scrollHeight: number;
   /**
    * Returns the HTML-uppercased qualified name.
    */
@@ -49,8 +50,19 @@ interface Element extends Node, ParentNode {
   // https://drafts.csswg.org/cssom-view/#extension-to-the-element-interface
   getBoundingClientRect(): BoundingClientRect;
 
-  getElementsByClassName(className: string) : Element[];
-  getElementsByTagName(tagName: string): Element[];
+  getElementsByClassName(className: string) : HTMLCollection;
+  getElementsByTagName(tagName: string): HTMLCollection;
+
+  querySelector(selectors: string): Element | null;
+  querySelectorAll(selectors: string): Element[];
+  /**
+   * Returns true if matching selectors against element's root yields element, and false otherwise.
+   */
+  matches(selectors: string): boolean;
+  /**
+   * Returns the first (starting at element) inclusive ancestor that matches selectors, and null otherwise.
+   */
+  closest(selectors: string): Element | null;
 
   scroll(options?: ScrollToOptions): void;
   scroll(x: number, y: number): void;
@@ -10,6 +10,7 @@
 #include "container_node.h"
 #include "core/css/legacy/css_style_declaration.h"
 #include "element_data.h"
+#include "element_geometry_snapshot.h"
 #include "legacy/bounding_client_rect.h"
 #include "legacy/element_attributes.h"
 #include "parent_node.h"
@@ -35,7 +36,21 @@ class Element : public ContainerNode {
   void setAttribute(const AtomicString&, const AtomicString& value);
   void setAttribute(const AtomicString&, const AtomicString& value, ExceptionState&);
   void removeAttribute(const AtomicString&, ExceptionState& exception_state);
+  AtomicString id() const;
+  void setId(const AtomicString& value, ExceptionState& exception_state);
+  AtomicString className() const;
+  void setClassName(const AtomicString& value, ExceptionState& exception_state);
   BoundingClientRect* getBoundingClientRect(ExceptionState& exception_state);
+  double clientTop() { return GetGeometry(ElementGeometryProperty::kClientTop); }
+  double clientLeft() { return GetGeometry(ElementGeometryProperty::kClientLeft); }
+  double clientWidth() { return GetGeometry(ElementGeometryProperty::kClientWidth); }
+  double clientHeight() { return GetGeometry(ElementGeometryProperty::kClientHeight); }
+  double scrollTop() { return GetGeometry(ElementGeometryProperty::kScrollTop); }
+  void setScrollTop(double value, ExceptionState& exception_state);
+  double scrollLeft() { return GetGeometry(ElementGeometryProperty::kScrollLeft); }
+  void setScrollLeft(double value, ExceptionState& exception_state);
+  double scrollWidth() { return GetGeometry(ElementGeometryProperty::kScrollWidth); }
+  double scrollHeight() { return GetGeometry(ElementGeometryProperty::kScrollHeight); }
   void click(ExceptionState& exception_state);
   void scroll(ExceptionState& exception_state);
   void scroll(const std::shared_ptr<ScrollToOptions>& options, ExceptionState& exception_state);
@@ -55,13 +70,20 @@ class Element : public ContainerNode {
   void setInnerHTML(const AtomicString& value, ExceptionState& exception_state);
 
   bool HasTagName(const AtomicString&) const;
+  // Read the attributes kept at the bridge side, return nullptr when the attribute is not set.
+  const AtomicString* FindAttribute(const AtomicString& name) const;
+  bool HasClass(const AtomicString& class_name) const;
   std::string nodeValue() const override;
   AtomicString tagName() const { return tag_name_.ToUpperSlow(); }
   std::string nodeName() const override;
   std::string nodeNameLowerCase() const;
 
-  std::vector<Element*> getElementsByClassName(const AtomicString& class_name, ExceptionState& exception_state);
-  std::vector<Element*> getElementsByTagName(const AtomicString& tag_name, ExceptionState& exception_state);
+  HTMLCollection* getElementsByClassName(const AtomicString& class_name, ExceptionState& exception_state);
+  HTMLCollection* getElementsByTagName(const AtomicString& tag_name, ExceptionState& exception_state);
+  Element* querySelector(const AtomicString& selectors, ExceptionState& exception_state);
+  std::vector<Element*> querySelectorAll(const AtomicString& selectors, ExceptionState& exception_state);
+  bool matches(const AtomicString& selectors, ExceptionState& exception_state);
+  Element* closest(const AtomicString& selectors, ExceptionState& exception_state);
 
   CSSStyleDeclaration* style();
   CSSStyleDeclaration& EnsureCSSStyleDeclaration();
@@ -72,6 +94,9 @@ class Element : public ContainerNode {
   NodeType nodeType() const override;
   bool ChildTypeAllowed(NodeType) const override;
 
+  void InsertedInto(ContainerNode& insertion_point) override;
+  void RemovedFrom(ContainerNode& insertion_point) override;
+
   // Clones attributes only.
   void CloneAttributesFrom(const Element&);
   bool HasEquivalentAttributes(const Element& other) const;
@@ -83,9 +108,16 @@ class Element : public ContainerNode {
   bool IsAttributeDefinedInternal(const AtomicString& key) const override;
   void Trace(GCVisitor* visitor) const override;
 
+  // Layout-dependent reads are served from a snapshot filled by one call to dart side, until a UICommand which may
+  // change the layout is recorded or dart side reports a new layout.
+  double GetGeometry(ElementGeometryProperty property);
+  bool HasValidGeometrySnapshot();
+  void UpdateGeometrySnapshot(const double* values, int64_t layout_generation);
+
  protected:
   const ElementData* GetElementData() const { return element_data_.get(); }
   ElementData& EnsureElementData() const;
+  void DidCreateDeferredWrapper() const override;
 
  private:
   // Clone is private so that non-virtual CloneElementWithChildren and
@@ -99,11 +131,15 @@ class Element : public ContainerNode {
   void _notifyChildInsert();
   void _didModifyAttribute(const AtomicString& name, const AtomicString& oldId, const AtomicString& newId);
   void _beforeUpdateId(JSValue oldIdValue, JSValue newIdValue);
+  // innerHTML and outerHTML serialize the whole subtree into one buffer.
+  void AppendOuterHTML(std::string& result) const;
+  void AppendInnerHTML(std::string& result) const;
 
   mutable std::unique_ptr<ElementData> element_data_;
   Member<ElementAttributes> attributes_;
   Member<CSSStyleDeclaration> cssom_wrapper_;
   AtomicString tag_name_ = AtomicString::Empty();
+  std::unique_ptr<ElementGeometrySnapshot> geometry_snapshot_;
 };
 
 template <typename T>
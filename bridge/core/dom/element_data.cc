@@ -4,9 +4,37 @@
  */
 
 #include "element_data.h"
+#include "foundation/ascii_types.h"
 
 namespace webf {
 
 void ElementData::CopyWith(ElementData* other) {}
 
-}  // namespace webf
\ No newline at end of file
+const std::vector<AtomicString>& ElementData::ClassNames(JSContext* ctx, const AtomicString& class_attribute) {
+  if (class_attribute != class_) {
+    class_ = class_attribute;
+    class_names_ = SplitClassNames(ctx, class_attribute);
+  }
+  return class_names_;
+}
+
+std::vector<AtomicString> ElementData::SplitClassNames(JSContext* ctx, const AtomicString& class_attribute) {
+  std::vector<AtomicString> class_names;
+  std::string value = class_attribute.ToStdString();
+  size_t i = 0;
+  while (i < value.size()) {
+    while (i < value.size() && IsASCIISpace(value[i])) {
+      i++;
+    }
+    size_t start = i;
+    while (i < value.size() && !IsASCIISpace(value[i])) {
+      i++;
+    }
+    if (i > start) {
+      class_names.emplace_back(AtomicString(ctx, value.substr(start, i - start)));
+    }
+  }
+  return class_names;
+}
+
+}  // namespace webf
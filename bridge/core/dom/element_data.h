@@ -6,6 +6,7 @@
 #ifndef WEBF_CORE_DOM_ELEMENT_DATA_H_
 #define WEBF_CORE_DOM_ELEMENT_DATA_H_
 
+#include <vector>
 #include "bindings/qjs/atomic_string.h"
 
 namespace webf {
@@ -14,8 +15,13 @@ class ElementData {
  public:
   void CopyWith(ElementData* other);
 
+  // The class attribute split into class names, split again only when the attribute value changed.
+  const std::vector<AtomicString>& ClassNames(JSContext* ctx, const AtomicString& class_attribute);
+  static std::vector<AtomicString> SplitClassNames(JSContext* ctx, const AtomicString& class_attribute);
+
  private:
   AtomicString class_;
+  std::vector<AtomicString> class_names_;
 };
 
 }  // namespace webf
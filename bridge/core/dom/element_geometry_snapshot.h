@@ -0,0 +1,46 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef BRIDGE_CORE_DOM_ELEMENT_GEOMETRY_SNAPSHOT_H_
+#define BRIDGE_CORE_DOM_ELEMENT_GEOMETRY_SNAPSHOT_H_
+
+#include <cinttypes>
+
+namespace webf {
+
+// Layout-dependent values of an element, in the order dart side fills them by getGeometrySnapshot.
+enum class ElementGeometryProperty : uint32_t {
+  kOffsetTop,
+  kOffsetLeft,
+  kOffsetWidth,
+  kOffsetHeight,
+  kClientTop,
+  kClientLeft,
+  kClientWidth,
+  kClientHeight,
+  kScrollTop,
+  kScrollLeft,
+  kScrollWidth,
+  kScrollHeight,
+  // The border box relative to the viewport, as getBoundingClientRect().
+  kRectX,
+  kRectY,
+  kRectWidth,
+  kRectHeight,
+  kCount,
+};
+
+constexpr uint32_t kElementGeometryPropertyCount = static_cast<uint32_t>(ElementGeometryProperty::kCount);
+
+// Valid as long as layout_generation equals UICommandBuffer::layoutGeneration().
+struct ElementGeometrySnapshot {
+  double values[kElementGeometryPropertyCount]{};
+  int64_t layout_generation{-1};
+
+  double value(ElementGeometryProperty property) const { return values[static_cast<uint32_t>(property)]; }
+};
+
+}  // namespace webf
+
+#endif  // BRIDGE_CORE_DOM_ELEMENT_GEOMETRY_SNAPSHOT_H_
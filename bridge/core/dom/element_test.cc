@@ -3,7 +3,11 @@
  * Copyright (C) 2022-present The WebF authors. All rights reserved.
  */
 
+#include "bindings/qjs/native_string_utils.h"
+#include "core/dom/document.h"
 #include "core/dom/legacy/bounding_client_rect.h"
+#include "core/frame/window.h"
+#include "core/html/html_body_element.h"
 #include "gtest/gtest.h"
 #include "webf_test_env.h"
 using namespace webf;
@@ -106,6 +110,61 @@ console.log(div.outerHTML, div.innerHTML, document.body.innerHTML);
   EXPECT_EQ(errorCalled, false);
 }
 
+TEST(Element, innerHTMLEscapesAndRoundTrips) {
+  bool static errorCalled = false;
+  bool static logCalled = false;
+  webf::WebFPage::consoleMessageHandler = [](void* ctx, const std::string& message, int logLevel) {
+    logCalled = true;
+    EXPECT_STREQ(message.c_str(),
+                 "<p title=\"a&quot;b\">x &amp; y &lt; z</p><br><script>window.ran = 1 < 2;</script><!-- c --> "
+                 "boolean true 4");
+  };
+  auto bridge = TEST_init([](int32_t contextId, const char* errmsg) {
+    WEBF_LOG(VERBOSE) << errmsg;
+    errorCalled = true;
+  });
+  std::string code = R"(
+const div = document.createElement('div');
+div.innerHTML = '<p title="a&quot;b">x &amp; y &lt; z</p><br><script>window.ran = 1 < 2;</script>';
+div.appendChild(document.createComment(' c '));
+
+const copy = document.createElement('div');
+copy.innerHTML = div.innerHTML;
+console.log(div.innerHTML, typeof window.ran, copy.firstChild.outerHTML == div.firstChild.outerHTML, copy.childNodes.length);
+)";
+  bridge->evaluateScript(code.c_str(), code.size(), "vm://", 0);
+  EXPECT_EQ(errorCalled, false);
+  EXPECT_EQ(logCalled, true);
+}
+
+TEST(Element, innerHTMLRunsInlineScripts) {
+  bool static errorCalled = false;
+  bool static logCalled = false;
+  webf::WebFPage::consoleMessageHandler = [](void* ctx, const std::string& message, int logLevel) {
+    logCalled = true;
+    EXPECT_STREQ(message.c_str(), "true,second,true,second true");
+  };
+  auto bridge = TEST_init([](int32_t contextId, const char* errmsg) {
+    WEBF_LOG(VERBOSE) << errmsg;
+    errorCalled = true;
+  });
+  std::string code = R"(
+window.runs = [];
+const div = document.createElement('div');
+document.body.appendChild(div);
+// Scripts run once the whole markup is inserted, so the first one already sees the paragraph after it.
+const markup = '<script>runs.push(String(document.getElementById("after") !== null))</script><p id="after"></p>' +
+  '<script>runs.push("second")</script>';
+div.innerHTML = markup;
+const found = document.getElementById('after') !== null;
+div.innerHTML = markup;
+console.log(runs.join(','), found);
+)";
+  bridge->evaluateScript(code.c_str(), code.size(), "vm://", 0);
+  EXPECT_EQ(errorCalled, false);
+  EXPECT_EQ(logCalled, true);
+}
+
 TEST(Element, style) {
   bool static errorCalled = false;
   bool static logCalled = false;
@@ -162,4 +221,151 @@ TEST(Element, instanceofEventTarget) {
 
   EXPECT_EQ(errorCalled, false);
   EXPECT_EQ(logCalled, true);
-}
\ No newline at end of file
+}
+
+static int geometry_snapshot_calls = 0;
+
+// Stands for dart side: answers getGeometrySnapshot with fixed values and every other method with null.
+static void FakeInvokeBindingMethod(const NativeBindingObject* binding_object,
+                                    NativeValue* return_value,
+                                    NativeValue* method,
+                                    int32_t argc,
+                                    const NativeValue* argv) {
+  *return_value = Native_NewNull();
+  if (method->tag != NativeTag::TAG_STRING ||
+      nativeStringToStdString(static_cast<NativeString*>(method->u.ptr)) != "getGeometrySnapshot")
+    return;
+
+  geometry_snapshot_calls++;
+  auto* items = static_cast<NativeValue*>(malloc(sizeof(NativeValue) * kElementGeometryPropertyCount));
+  for (uint32_t i = 0; i < kElementGeometryPropertyCount; i++) {
+    items[i] = Native_NewFloat64(i);
+  }
+  *return_value = Native_NewList(kElementGeometryPropertyCount, items);
+}
+
+TEST(Element, geometryReadsFromSnapshot) {
+  bool static errorCalled = false;
+  bool static logCalled = false;
+  webf::WebFPage::consoleMessageHandler = [](void* ctx, const std::string& message, int logLevel) {
+    logCalled = true;
+    EXPECT_STREQ(message.c_str(), "10 20 100 50 8 16 100 50");
+  };
+  auto bridge = TEST_init([](int32_t contextId, const char* errmsg) {
+    WEBF_LOG(VERBOSE) << errmsg;
+    errorCalled = true;
+  });
+  auto context = bridge->GetExecutingContext();
+  const char* code =
+      "let div = document.createElement('div');"
+      "document.body.appendChild(div);";
+  bridge->evaluateScript(code, strlen(code), "vm://", 0);
+
+  auto* div = To<Element>(context->document()->body()->lastChild());
+  double values[kElementGeometryPropertyCount] = {10, 20, 100, 50, 0, 0, 100, 50, 0, 0, 100, 50, 8, 16, 100, 50};
+  div->UpdateGeometrySnapshot(values, context->uiCommandBuffer()->layoutGeneration());
+
+  // No dart side in unit tests, reading from the snapshot must not reach it.
+  const char* read =
+      "let rect = div.getBoundingClientRect();"
+      "console.log(div.offsetTop, div.offsetLeft, div.offsetWidth, div.offsetHeight, rect.x, rect.y, "
+      "div.clientWidth, rect.bottom - rect.top);";
+  bridge->evaluateScript(read, strlen(read), "vm://", 0);
+  EXPECT_EQ(errorCalled, false);
+  EXPECT_EQ(logCalled, true);
+
+  // A style change may move the element, the next read takes a new snapshot from dart side.
+  div->bindingObject()->invoke_bindings_methods_from_native = FakeInvokeBindingMethod;
+  geometry_snapshot_calls = 0;
+  logCalled = false;
+  webf::WebFPage::consoleMessageHandler = [](void* ctx, const std::string& message, int logLevel) {
+    logCalled = true;
+    EXPECT_STREQ(message.c_str(), "2 0 2");
+  };
+  const char* mutate =
+      "div.style.width = '200px';"
+      "console.log(div.offsetWidth, div.offsetTop, div.offsetWidth);";
+  bridge->evaluateScript(mutate, strlen(mutate), "vm://", 0);
+  EXPECT_EQ(geometry_snapshot_calls, 1);
+  EXPECT_EQ(errorCalled, false);
+  EXPECT_EQ(logCalled, true);
+}
+
+
+TEST(Element, readsKeepGeometrySnapshot) {
+  bool static errorCalled = false;
+  auto bridge = TEST_init([](int32_t contextId, const char* errmsg) {
+    WEBF_LOG(VERBOSE) << errmsg;
+    errorCalled = true;
+  });
+  auto context = bridge->GetExecutingContext();
+  const char* code =
+      "let div = document.createElement('div');"
+      "document.body.appendChild(div);";
+  bridge->evaluateScript(code, strlen(code), "vm://", 0);
+  auto* div = To<Element>(context->document()->body()->lastChild());
+  div->bindingObject()->invoke_bindings_methods_from_native = FakeInvokeBindingMethod;
+  context->window()->bindingObject()->invoke_bindings_methods_from_native = FakeInvokeBindingMethod;
+  geometry_snapshot_calls = 0;
+
+  // Back to back reads, with a dart side method which only reads in between, take one snapshot.
+  const char* read = "div.offsetWidth; div.getBoundingClientRect(); window.open('about:blank'); div.clientHeight;";
+  bridge->evaluateScript(read, strlen(read), "vm://", 0);
+  EXPECT_EQ(geometry_snapshot_calls, 1);
+
+  // Scrolling moves the content, the next read takes a new snapshot.
+  const char* scroll = "div.scrollBy(0, 10); div.scrollTop;";
+  bridge->evaluateScript(scroll, strlen(scroll), "vm://", 0);
+  EXPECT_EQ(geometry_snapshot_calls, 2);
+  EXPECT_EQ(errorCalled, false);
+}
+
+static int anonymous_function_calls = 0;
+
+// Stands for dart side of a widget element: every property is an anonymous function.
+static void FakeInvokeWidgetMethod(const NativeBindingObject* binding_object,
+                                   NativeValue* return_value,
+                                   NativeValue* method,
+                                   int32_t argc,
+                                   const NativeValue* argv) {
+  if (method->tag == NativeTag::TAG_INT && method->u.int64 == BindingMethodCallOperations::kGetProperty) {
+    *return_value = Native_NewNull();
+    return_value->tag = NativeTag::TAG_FUNCTION;
+    return;
+  }
+  if (method->tag == NativeTag::TAG_INT && method->u.int64 == BindingMethodCallOperations::kAnonymousFunctionCall) {
+    anonymous_function_calls++;
+    *return_value = Native_NewNull();
+    return;
+  }
+  FakeInvokeBindingMethod(binding_object, return_value, method, argc, argv);
+}
+
+TEST(Element, widgetCallsDropGeometrySnapshot) {
+  bool static errorCalled = false;
+  auto bridge = TEST_init([](int32_t contextId, const char* errmsg) {
+    WEBF_LOG(VERBOSE) << errmsg;
+    errorCalled = true;
+  });
+  auto context = bridge->GetExecutingContext();
+  const char* code =
+      "let checkbox = document.createElement('flutter-checkbox');"
+      "document.body.appendChild(checkbox);";
+  bridge->evaluateScript(code, strlen(code), "vm://", 0);
+  auto* checkbox = To<Element>(context->document()->body()->lastChild());
+  checkbox->bindingObject()->invoke_bindings_methods_from_native = FakeInvokeWidgetMethod;
+  geometry_snapshot_calls = 0;
+  anonymous_function_calls = 0;
+
+  // Reading a widget property keeps the snapshot.
+  const char* read = "checkbox.offsetWidth; let toggle = checkbox.toggle; checkbox.offsetHeight;";
+  bridge->evaluateScript(read, strlen(read), "vm://", 0);
+  EXPECT_EQ(geometry_snapshot_calls, 1);
+
+  // Widget methods run arbitrary dart code, the next read takes a new snapshot.
+  const char* call = "checkbox.toggle(); checkbox.offsetWidth;";
+  bridge->evaluateScript(call, strlen(call), "vm://", 0);
+  EXPECT_EQ(anonymous_function_calls, 1);
+  EXPECT_EQ(geometry_snapshot_calls, 2);
+  EXPECT_EQ(errorCalled, false);
+}
@@ -19,6 +19,10 @@ interface Event {
    * Returns true if preventDefault() was invoked successfully to indicate cancelation, and false otherwise.
    */
   readonly defaultPrevented: boolean;
+  /**
+   * Returns the event's phase, which is one of NONE (0), CAPTURING_PHASE (1), AT_TARGET (2), and BUBBLING_PHASE (3).
+   */
+  readonly eventPhase: number;
   readonly srcElement: EventTarget | null;
   readonly target: EventTarget | null;
   readonly isTrusted: boolean;
@@ -123,6 +123,11 @@ class Event : public ScriptWrappable {
                  double timeStamp);
   explicit Event(ExecutingContext* context, const AtomicString& event_type, NativeEvent* native_event);
 
+  // Events created from a RawEvent are handed out again by the EventPool once nobody holds them after dispatch. Only
+  // the classes which can take the fields of another RawEvent are reusable.
+  virtual bool IsReusable() const;
+  virtual void ReinitializeFromRawEvent(const AtomicString& event_type, RawEvent* raw_event);
+
   bool propagationStopped() const { return propagation_stopped_; }
   bool bubbles() { return bubbles_; };
   double timeStamp() { return time_stamp_; }
@@ -219,6 +224,8 @@ class Event : public ScriptWrappable {
 
  protected:
   PassiveMode HandlingPassive() const { return handling_passive_; }
+  // Brings the event to the state the constructor taking |native_event| leaves it in.
+  void ReinitializeFromNative(const AtomicString& event_type, NativeEvent* native_event);
 
   AtomicString type_;
 
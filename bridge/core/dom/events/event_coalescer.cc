@@ -0,0 +1,124 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "event_coalescer.h"
+#include "bindings/qjs/cppgc/mutation_scope.h"
+#include "core/dom/frame_request_callback_collection.h"
+#include "core/events/pointer_event.h"
+#include "event_target.h"
+#include "event_type_names.h"
+
+namespace webf {
+
+EventCoalescer::EventCoalescer(ExecutingContext* context) : context_(context) {}
+
+bool EventCoalescer::ShouldCoalesce(const Event& event) const {
+  if (context_->dartMethodPtr()->requestAnimationFrame == nullptr)
+    return false;
+
+  const AtomicString& type = event.type();
+  if (type == event_type_names::kpointermove || type == event_type_names::kmousemove)
+    return true;
+  // Whether a touch move was canceled decides whether it scrolls, so dart side waits for the listeners of those.
+  return type == event_type_names::ktouchmove && !event.cancelable();
+}
+
+void EventCoalescer::Enqueue(EventTarget* target, Event* event) {
+  stats_.queued++;
+  event->RetainReference();
+
+  PointerEvent* pointer_event = event->IsPointerEvent() ? static_cast<PointerEvent*>(event) : nullptr;
+  for (PendingEvent& pending : pending_events_) {
+    if (pending.target != target || pending.event->type() != event->type())
+      continue;
+    // Every pointer moves on its own.
+    if (pointer_event != nullptr && static_cast<PointerEvent*>(pending.event)->pointerId() != pointer_event->pointerId())
+      continue;
+
+    if (pointer_event != nullptr) {
+      pending.coalesced_events.emplace_back(static_cast<PointerEvent*>(pending.event));
+      stats_.merged++;
+    } else {
+      context_->eventPool()->Recycle(pending.event);
+      context_->mutationScope()->RecordFree(pending.event);
+      stats_.dropped++;
+    }
+    pending.event = event;
+    return;
+  }
+
+  target->RetainReference();
+  pending_events_.emplace_back(PendingEvent{target, event, {}});
+  RequestAnimationFrame();
+}
+
+void EventCoalescer::Flush() {
+  if (pending_events_.empty())
+    return;
+
+  MemberMutationScope mutation_scope{context_};
+  // Listeners run below, and the events dispatched from dart side while they run queue up for the next flush.
+  std::vector<PendingEvent> pending_events;
+  pending_events.swap(pending_events_);
+
+  for (PendingEvent& pending : pending_events) {
+    if (!pending.coalesced_events.empty()) {
+      static_cast<PointerEvent*>(pending.event)->SetCoalescedEvents(pending.coalesced_events);
+    }
+
+    ExceptionState exception_state;
+    pending.target->DispatchEventInternal(*pending.event, exception_state);
+    if (exception_state.HasException()) {
+      JSValue error = JS_GetException(context_->ctx());
+      context_->ReportError(error);
+      JS_FreeValue(context_->ctx(), error);
+    }
+    stats_.dispatched++;
+
+    mutation_scope.RecordFree(pending.target);
+    context_->eventPool()->Recycle(pending.event);
+    mutation_scope.RecordFree(pending.event);
+    for (PointerEvent* coalesced_event : pending.coalesced_events) {
+      mutation_scope.RecordFree(coalesced_event);
+    }
+  }
+}
+
+void EventCoalescer::Clear() {
+  for (PendingEvent& pending : pending_events_) {
+    stats_.dropped += 1 + pending.coalesced_events.size();
+    pending.target->ReleaseReference();
+    pending.event->ReleaseReference();
+    for (PointerEvent* coalesced_event : pending.coalesced_events) {
+      coalesced_event->ReleaseReference();
+    }
+  }
+  pending_events_.clear();
+}
+
+void EventCoalescer::HandleAnimationFrame(void* ptr,
+                                          int32_t context_id,
+                                          double high_res_time_stamp,
+                                          const char* errmsg) {
+  if (!isContextValid(context_id))
+    return;
+
+  auto* context = static_cast<FrameCallback*>(ptr)->context();
+  EventCoalescer* coalescer = context->eventCoalescer();
+  coalescer->animation_frame_requested_ = false;
+  coalescer->Flush();
+}
+
+void EventCoalescer::RequestAnimationFrame() {
+  if (animation_frame_requested_)
+    return;
+
+  if (frame_callback_ == nullptr) {
+    frame_callback_ = FrameCallback::Create(context_, nullptr);
+  }
+  context_->dartMethodPtr()->requestAnimationFrame(frame_callback_.get(), context_->contextId(), HandleAnimationFrame);
+  animation_frame_requested_ = true;
+}
+
+}  // namespace webf
@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef BRIDGE_CORE_DOM_EVENTS_EVENT_COALESCER_H_
+#define BRIDGE_CORE_DOM_EVENTS_EVENT_COALESCER_H_
+
+#include <cinttypes>
+#include <memory>
+#include <vector>
+
+namespace webf {
+
+class ExecutingContext;
+class Event;
+class EventTarget;
+class FrameCallback;
+class PointerEvent;
+
+// Counters since the context was created, the layout is read by dart side through getEventCoalescingStats().
+struct EventCoalescingStats {
+  // Move events held until the next animation frame.
+  int64_t queued{0};
+  // Events dispatched at animation frames, each standing for one or more queued ones.
+  int64_t dispatched{0};
+  // Pointer moves merged into a later one, which lists them in getCoalescedEvents().
+  int64_t merged{0};
+  // Moves replaced by a later one without being kept, or never dispatched because the context went away.
+  int64_t dropped{0};
+};
+
+// Holds the pointer, mouse and touch moves dispatched from dart side until the next animation frame, so that the
+// moves arriving for a target within a frame reach the listeners as one event.
+// https://w3c.github.io/pointerevents/#coalesced-events
+class EventCoalescer {
+ public:
+  explicit EventCoalescer(ExecutingContext* context);
+
+  bool ShouldCoalesce(const Event& event) const;
+  // Queues |event| for |target|, replacing the move of the same kind queued for it already.
+  void Enqueue(EventTarget* target, Event* event);
+  // Dispatches the queued events in the order their targets were first queued.
+  void Flush();
+  // Releases the queued events without dispatching them.
+  void Clear();
+
+  const EventCoalescingStats& stats() const { return stats_; }
+  void ResetStats() { stats_ = EventCoalescingStats(); }
+
+ private:
+  struct PendingEvent {
+    EventTarget* target;
+    Event* event;
+    // The pointer moves |event| replaced, oldest first.
+    std::vector<PointerEvent*> coalesced_events;
+  };
+
+  static void HandleAnimationFrame(void* ptr, int32_t context_id, double high_res_time_stamp, const char* errmsg);
+  void RequestAnimationFrame();
+
+  ExecutingContext* context_;
+  std::vector<PendingEvent> pending_events_;
+  // Handed to dart side as the context of the animation frame request.
+  std::shared_ptr<FrameCallback> frame_callback_;
+  bool animation_frame_requested_{false};
+  EventCoalescingStats stats_;
+};
+
+}  // namespace webf
+
+#endif  // BRIDGE_CORE_DOM_EVENTS_EVENT_COALESCER_H_
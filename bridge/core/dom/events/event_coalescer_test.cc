@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "event_coalescer.h"
+#include "core/dom/document.h"
+#include "core/events/mouse_event.h"
+#include "core/events/pointer_event.h"
+#include "core/html/html_body_element.h"
+#include "event_type_names.h"
+#include "gtest/gtest.h"
+#include "qjs_mouse_event_init.h"
+#include "qjs_pointer_event_init.h"
+#include "webf_test_env.h"
+
+using namespace webf;
+
+static PointerEvent* CreatePointerMove(ExecutingContext* context, double pointer_id) {
+  auto init = PointerEventInit::Create();
+  init->setPointerId(pointer_id);
+  return PointerEvent::Create(context, event_type_names::kpointermove, init, ASSERT_NO_EXCEPTION());
+}
+
+TEST(EventCoalescer, mergeMovesUntilAnimationFrame) {
+  bool static errorCalled = false;
+  bool static logCalled = false;
+  webf::WebFPage::consoleMessageHandler = [](void* ctx, const std::string& message, int logLevel) {
+    logCalled = true;
+    EXPECT_STREQ(message.c_str(), "pointer 1 3 true,mouse,pointer 2 1 true");
+  };
+  auto bridge = TEST_init([](int32_t contextId, const char* errmsg) {
+    WEBF_LOG(VERBOSE) << errmsg;
+    errorCalled = true;
+  });
+  auto context = bridge->GetExecutingContext();
+  std::string code =
+      "let log = [];"
+      "document.body.addEventListener('pointermove', e => {"
+      "  let coalesced = e.getCoalescedEvents();"
+      "  log.push(['pointer', e.pointerId, coalesced.length, coalesced[coalesced.length - 1] === e].join(' ')); });"
+      "document.body.addEventListener('mousemove', e => log.push('mouse'));";
+  bridge->evaluateScript(code.c_str(), code.size(), "vm://", 0);
+
+  {
+    MemberMutationScope mutation_scope{context};
+    EventCoalescer* coalescer = context->eventCoalescer();
+    EventTarget* body = context->document()->body();
+    coalescer->Enqueue(body, CreatePointerMove(context, 1));
+    coalescer->Enqueue(body, MouseEvent::Create(context, event_type_names::kmousemove, ASSERT_NO_EXCEPTION()));
+    coalescer->Enqueue(body, CreatePointerMove(context, 1));
+    coalescer->Enqueue(body, CreatePointerMove(context, 2));
+    coalescer->Enqueue(body, MouseEvent::Create(context, event_type_names::kmousemove, ASSERT_NO_EXCEPTION()));
+    coalescer->Enqueue(body, CreatePointerMove(context, 1));
+  }
+  TEST_runLoop(context);
+
+  code = "console.log(log.join(','));";
+  bridge->evaluateScript(code.c_str(), code.size(), "vm://", 0);
+
+  const EventCoalescingStats& stats = context->eventCoalescer()->stats();
+  EXPECT_EQ(stats.queued, 6);
+  EXPECT_EQ(stats.dispatched, 3);
+  EXPECT_EQ(stats.merged, 2);
+  EXPECT_EQ(stats.dropped, 1);
+  EXPECT_EQ(errorCalled, false);
+  EXPECT_EQ(logCalled, true);
+}
+
+TEST(EventCoalescer, touchMovesWhichCanBeCanceledAreNotCoalesced) {
+  auto bridge = TEST_init();
+  auto context = bridge->GetExecutingContext();
+  MemberMutationScope mutation_scope{context};
+  auto init = EventInit::Create();
+  init->setCancelable(true);
+  Event* cancelable = Event::Create(context, event_type_names::ktouchmove, init, ASSERT_NO_EXCEPTION());
+  EXPECT_FALSE(context->eventCoalescer()->ShouldCoalesce(*cancelable));
+  Event* passive = Event::Create(context, event_type_names::ktouchmove, ASSERT_NO_EXCEPTION());
+  EXPECT_TRUE(context->eventCoalescer()->ShouldCoalesce(*passive));
+}
@@ -51,29 +51,83 @@ static bool RemoveListenerFromVector(EventListenerVector* listener_vector,
   return true;
 }
 
+static inline size_t IndexSlot(JSAtom atom, size_t mask) {
+  // Atoms are mostly consecutive numbers, multiplying by an odd constant spreads them over the table.
+  return (static_cast<uint32_t>(atom) * 0x9E3779B1u) & mask;
+}
+
+int EventListenerMap::FindEntry(const AtomicString& event_type) const {
+  if (index_.empty()) {
+    for (size_t i = 0; i < entries_.size(); i++) {
+      if (entries_[i].first == event_type)
+        return i;
+    }
+    return -1;
+  }
+
+  size_t mask = index_.size() - 1;
+  for (size_t slot = IndexSlot(event_type.Impl(), mask);; slot = (slot + 1) & mask) {
+    uint32_t position = index_[slot];
+    if (position == 0)
+      return -1;
+    if (entries_[position - 1].first == event_type)
+      return position - 1;
+  }
+}
+
+void EventListenerMap::AddToIndex(size_t position) {
+  size_t mask = index_.size() - 1;
+  size_t slot = IndexSlot(entries_[position].first.Impl(), mask);
+  while (index_[slot] != 0) {
+    slot = (slot + 1) & mask;
+  }
+  index_[slot] = position + 1;
+}
+
+void EventListenerMap::RebuildIndex() {
+  index_.clear();
+  if (entries_.size() <= kIndexThreshold)
+    return;
+
+  // At most half of the slots are taken, which keeps the probe sequences short.
+  size_t capacity = 2 * kIndexThreshold;
+  while (capacity < 2 * entries_.size()) {
+    capacity *= 2;
+  }
+  index_.resize(capacity, 0);
+  for (size_t i = 0; i < entries_.size(); i++) {
+    AddToIndex(i);
+  }
+}
+
 bool EventListenerMap::Contains(const AtomicString& event_type) const {
-  for (const auto& entry : entries_) {
-    if (entry.first == event_type)
+  return FindEntry(event_type) != -1;
+}
+
+bool EventListenerMap::ContainsCapturing(const AtomicString& event_type) const {
+  int position = FindEntry(event_type);
+  if (position == -1)
+    return false;
+
+  for (const auto& event_listener : *entries_[position].second) {
+    if (event_listener.Capture())
       return true;
   }
   return false;
 }
 
-bool EventListenerMap::ContainsCapturing(const AtomicString& event_type) const {
+std::vector<AtomicString> EventListenerMap::EventTypes() const {
+  std::vector<AtomicString> event_types;
+  event_types.reserve(entries_.size());
   for (const auto& entry : entries_) {
-    if (entry.first == event_type) {
-      for (const auto& event_listener : *entry.second) {
-        if (event_listener.Capture())
-          return true;
-      }
-      return false;
-    }
+    event_types.emplace_back(entry.first);
   }
-  return false;
+  return event_types;
 }
 
 void EventListenerMap::Clear() {
   entries_.clear();
+  index_.clear();
 }
 
 bool EventListenerMap::Add(const AtomicString& event_type,
@@ -81,12 +135,17 @@ bool EventListenerMap::Add(const AtomicString& event_type,
                            const std::shared_ptr<AddEventListenerOptions>& options,
                            RegisteredEventListener* registered_event_listener,
                            uint32_t* listener_count) {
-  for (const auto& entry : entries_) {
-    if (entry.first == event_type)
-      return AddListenerToVector(entry.second.get(), listener, options, registered_event_listener, listener_count);
-  }
+  int position = FindEntry(event_type);
+  if (position != -1)
+    return AddListenerToVector(entries_[position].second.get(), listener, options, registered_event_listener,
+                               listener_count);
 
   entries_.emplace_back(event_type, std::make_unique<EventListenerVector>());
+  if (2 * entries_.size() > index_.size()) {
+    RebuildIndex();
+  } else {
+    AddToIndex(entries_.size() - 1);
+  }
   return AddListenerToVector(entries_.back().second.get(), listener, options, registered_event_listener,
                              listener_count);
 }
@@ -97,27 +156,27 @@ bool EventListenerMap::Remove(const AtomicString& event_type,
                               size_t* index_of_removed_listener,
                               RegisteredEventListener* registered_event_listener,
                               uint32_t* listener_count) {
-  for (unsigned i = 0; i < entries_.size(); ++i) {
-    if (entries_[i].first == event_type) {
-      bool was_removed = RemoveListenerFromVector(entries_[i].second.get(), listener, options,
-                                                  index_of_removed_listener, registered_event_listener, listener_count);
-      if (entries_[i].second->empty()) {
-        entries_.erase(entries_.begin() + i);
-      }
-      return was_removed;
+  int position = FindEntry(event_type);
+  if (position == -1)
+    return false;
+
+  bool was_removed = RemoveListenerFromVector(entries_[position].second.get(), listener, options,
+                                              index_of_removed_listener, registered_event_listener, listener_count);
+  if (entries_[position].second->empty()) {
+    entries_.erase(entries_.begin() + position);
+    // The entries behind the removed one moved. Event types are removed far less often than they are looked up.
+    if (!index_.empty()) {
+      RebuildIndex();
     }
   }
-
-  return false;
+  return was_removed;
 }
 
 EventListenerVector* EventListenerMap::Find(const AtomicString& event_type) const {
-  for (const auto& entry : entries_) {
-    if (entry.first == event_type)
-      return entry.second.get();
-  }
-
-  return nullptr;
+  int position = FindEntry(event_type);
+  if (position == -1)
+    return nullptr;
+  return entries_[position].second.get();
 }
 
 void EventListenerMap::Trace(GCVisitor* visitor) const {
@@ -33,6 +33,7 @@ class EventListenerMap final {
   bool Contains(const AtomicString& event_type) const;
   bool ContainsCapturing(const AtomicString& event_type) const;
   void Clear();
+  std::vector<AtomicString> EventTypes() const;
   bool Add(const AtomicString& event_type,
            const std::shared_ptr<EventListener>& listener,
            const std::shared_ptr<AddEventListenerOptions>& options,
@@ -49,12 +50,24 @@ class EventListenerMap final {
   void Trace(GCVisitor* visitor) const;
 
  private:
+  // Above this many event types, entries are found through |index_| instead of a linear scan.
+  static constexpr size_t kIndexThreshold = 8;
+
+  // The position of |event_type| in |entries_|, or -1.
+  int FindEntry(const AtomicString& event_type) const;
+  void AddToIndex(size_t position);
+  void RebuildIndex();
+
   // EventListener handlers registered with addEventListener API.
   // We use vector instead of hashMap because
   //  - vector is much more space efficient than hashMap.
   //  - An EventTarget rarely has event listeners for many event types, and
   //    vector is faster in such cases.
   std::vector<std::pair<AtomicString, std::unique_ptr<EventListenerVector>>> entries_;
+  // For the targets which do have many event types, like window and document with delegated handlers: an open
+  // addressing table keyed by the atom of the event type, holding positions in |entries_| plus one and zero for free
+  // slots. Empty up to kIndexThreshold event types.
+  std::vector<uint32_t> index_;
 };
 
 }  // namespace webf
@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "event_pool.h"
+#include "bindings/qjs/cppgc/mutation_scope.h"
+#include "core/executing_context.h"
+#include "event_factory.h"
+
+namespace webf {
+
+EventPool::EventPool(ExecutingContext* context) : context_(context) {}
+
+Event* EventPool::Create(const AtomicString& type, RawEvent* raw_event) {
+  if (raw_event == nullptr || raw_event->is_custom_event) {
+    stats_.created++;
+    return EventFactory::Create(context_, type, raw_event);
+  }
+
+  auto wrapper_type = wrapper_types_.find(type);
+  if (wrapper_type != wrapper_types_.end()) {
+    std::vector<Event*>& events = pooled_events_[wrapper_type->second];
+    if (!events.empty()) {
+      Event* event = events.back();
+      events.pop_back();
+      event->ReinitializeFromRawEvent(type, raw_event);
+      // The reference the pool held goes to the current scope, the same as the one MakeGarbageCollected hands out.
+      context_->mutationScope()->RecordFree(event);
+      stats_.reused++;
+      return event;
+    }
+  }
+
+  stats_.created++;
+  Event* event = EventFactory::Create(context_, type, raw_event);
+  if (wrapper_type == wrapper_types_.end()) {
+    wrapper_types_.emplace(type, event->GetWrapperTypeInfo());
+  }
+  return event;
+}
+
+void EventPool::Recycle(Event* event) {
+  // Whatever script holds on to, or stored on the event, must not show up in a later one.
+  if (!event->IsReusable() || !event->HasOneReference() || HasScriptState(event))
+    return;
+
+  std::vector<Event*>& events = pooled_events_[event->GetWrapperTypeInfo()];
+  if (events.size() >= kMaxPooledEvents)
+    return;
+
+  // The pooled event must not keep its targets alive.
+  event->SetTarget(nullptr);
+  event->SetCurrentTarget(nullptr);
+  event->RetainReference();
+  events.emplace_back(event);
+}
+
+void EventPool::Clear() {
+  for (auto& [wrapper_type, events] : pooled_events_) {
+    for (Event* event : events) {
+      event->ReleaseReference();
+    }
+  }
+  pooled_events_.clear();
+}
+
+bool EventPool::HasScriptState(Event* event) const {
+  // Script never saw an event whose JS object was not created.
+  if (event->HasDeferredWrapper())
+    return false;
+
+  JSContext* ctx = context_->ctx();
+  JSValue object = event->ToQuickJSUnsafe();
+  if (JS_GetOwnShapePropertyCount(object) != 0 || !JS_IsExtensible(ctx, object))
+    return true;
+
+  JSValue prototype = JS_GetPrototype(ctx, object);
+  bool prototype_changed = JS_VALUE_GET_PTR(prototype) !=
+                           JS_VALUE_GET_PTR(context_->contextData()->prototypeForType(event->GetWrapperTypeInfo()));
+  JS_FreeValue(ctx, prototype);
+  return prototype_changed;
+}
+
+}  // namespace webf
@@ -0,0 +1,59 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef BRIDGE_CORE_DOM_EVENTS_EVENT_POOL_H_
+#define BRIDGE_CORE_DOM_EVENTS_EVENT_POOL_H_
+
+#include <cinttypes>
+#include <unordered_map>
+#include <vector>
+#include "bindings/qjs/atomic_string.h"
+
+namespace webf {
+
+class ExecutingContext;
+class Event;
+struct RawEvent;
+struct WrapperTypeInfo;
+
+struct EventPoolStats {
+  // Events created because none of their kind was left in the pool.
+  int64_t created{0};
+  // Events handed out again instead of being created.
+  int64_t reused{0};
+};
+
+// Keeps the events dispatched from dart side which nobody held on to after the dispatch, and hands them out again for
+// the next event of the same kind, so that a stream of touch moves does not create and collect a JS object for every
+// event and touch.
+class EventPool {
+ public:
+  // The events of a kind kept at most.
+  static constexpr size_t kMaxPooledEvents = 8;
+
+  explicit EventPool(ExecutingContext* context);
+
+  // The same as EventFactory::Create(), the event is released at the end of the current MemberMutationScope.
+  Event* Create(const AtomicString& type, RawEvent* raw_event);
+  // Takes |event| back once it was dispatched, when nobody but the caller holds it. |event| must come from Create().
+  void Recycle(Event* event);
+  // Releases the pooled events.
+  void Clear();
+
+  const EventPoolStats& stats() const { return stats_; }
+  void ResetStats() { stats_ = EventPoolStats(); }
+
+ private:
+  bool HasScriptState(Event* event) const;
+
+  ExecutingContext* context_;
+  // The class an event type was created with, learned when an event of the type is recycled first.
+  std::unordered_map<AtomicString, const WrapperTypeInfo*, AtomicString::KeyHasher> wrapper_types_;
+  std::unordered_map<const WrapperTypeInfo*, std::vector<Event*>> pooled_events_;
+  EventPoolStats stats_;
+};
+
+}  // namespace webf
+
+#endif  // BRIDGE_CORE_DOM_EVENTS_EVENT_POOL_H_
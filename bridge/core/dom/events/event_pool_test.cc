@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "event_pool.h"
+#include "core/dom/document.h"
+#include "core/html/html_body_element.h"
+#include "gtest/gtest.h"
+#include "qjs_touch_event.h"
+#include "webf_test_env.h"
+
+using namespace webf;
+
+// Dispatches a touch move to |target| the way dart side does, with one finger at |client_x|.
+static void DispatchTouchMove(EventTarget* target, double client_x) {
+  NativeTouch touch{};
+  touch.identifier = 1;
+  touch.clientX = client_x;
+  NativeTouchList touch_list{1, &touch};
+  NativeTouchEvent native_event{};
+  native_event.native_event.native_event.bubbles = 1;
+  // Moves which can be canceled are dispatched at once rather than at the next animation frame.
+  native_event.native_event.native_event.cancelable = 1;
+  native_event.touches = &touch_list;
+  native_event.targetTouches = &touch_list;
+  native_event.changedTouches = &touch_list;
+
+  RawEvent raw_event;
+  raw_event.bytes = reinterpret_cast<uint64_t*>(&native_event);
+  raw_event.length = sizeof(NativeTouchEvent) / sizeof(int64_t);
+  raw_event.is_custom_event = 0;
+
+  NativeValue method = Native_NewCString("dispatchEvent");
+  NativeValue argv[] = {Native_NewCString("touchmove"), Native_NewPtr(JSPointerType::Others, &raw_event),
+                        Native_NewBool(true)};
+  NativeValue result;
+  NativeBindingObject::HandleCallFromDartSide(target->bindingObject(), &result, &method, 3, argv);
+  ::operator delete(result.u.ptr);
+}
+
+TEST(EventPool, reuseEventsNobodyHolds) {
+  bool static errorCalled = false;
+  bool static logCalled = false;
+  webf::WebFPage::consoleMessageHandler = [](void* ctx, const std::string& message, int logLevel) {
+    logCalled = true;
+    EXPECT_STREQ(message.c_str(), "10 true,20 true,30 true");
+  };
+  auto bridge = TEST_init([](int32_t contextId, const char* errmsg) {
+    WEBF_LOG(VERBOSE) << errmsg;
+    errorCalled = true;
+  });
+  auto context = bridge->GetExecutingContext();
+  std::string code =
+      "let log = [];"
+      "document.body.addEventListener('touchmove', e => {"
+      "  log.push(e.touches[0].clientX + ' ' + (e.target === document.body)); });";
+  bridge->evaluateScript(code.c_str(), code.size(), "vm://", 0);
+
+  EventTarget* body = context->document()->body();
+  DispatchTouchMove(body, 10);
+  DispatchTouchMove(body, 20);
+  DispatchTouchMove(body, 30);
+
+  code = "console.log(log.join(','));";
+  bridge->evaluateScript(code.c_str(), code.size(), "vm://", 0);
+
+  EXPECT_EQ(context->eventPool()->stats().created, 1);
+  EXPECT_EQ(context->eventPool()->stats().reused, 2);
+  EXPECT_EQ(errorCalled, false);
+  EXPECT_EQ(logCalled, true);
+}
+
+TEST(EventPool, keepWhatScriptHolds) {
+  bool static errorCalled = false;
+  bool static logCalled = false;
+  webf::WebFPage::consoleMessageHandler = [](void* ctx, const std::string& message, int logLevel) {
+    logCalled = true;
+    EXPECT_STREQ(message.c_str(), "10 20 30");
+  };
+  auto bridge = TEST_init([](int32_t contextId, const char* errmsg) {
+    WEBF_LOG(VERBOSE) << errmsg;
+    errorCalled = true;
+  });
+  auto context = bridge->GetExecutingContext();
+  std::string code =
+      "let kept = [];"
+      "document.body.addEventListener('touchmove', e => {"
+      "  let x = e.touches[0].clientX;"
+      "  if (x == 10) kept.push(e);"
+      "  if (x == 20) kept.push(e.touches);"
+      "  if (x == 30) { e.expando = true; kept.push(e.touches[0]); }"
+      "});";
+  bridge->evaluateScript(code.c_str(), code.size(), "vm://", 0);
+
+  EventTarget* body = context->document()->body();
+  DispatchTouchMove(body, 10);
+  DispatchTouchMove(body, 20);
+  DispatchTouchMove(body, 30);
+  DispatchTouchMove(body, 40);
+  DispatchTouchMove(body, 50);
+
+  code = "console.log([kept[0].touches[0].clientX, kept[1][0].clientX, kept[2].clientX].join(' '));";
+  bridge->evaluateScript(code.c_str(), code.size(), "vm://", 0);
+
+  // The event held by script and the one with an expando are not taken back, the one whose touch list is held is.
+  EXPECT_EQ(context->eventPool()->stats().created, 3);
+  EXPECT_EQ(context->eventPool()->stats().reused, 2);
+  EXPECT_EQ(errorCalled, false);
+  EXPECT_EQ(logCalled, true);
+}
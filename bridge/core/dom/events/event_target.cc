@@ -6,7 +6,9 @@
 #include <cstdint>
 #include "binding_call_methods.h"
 #include "bindings/qjs/converter_impl.h"
-#include "event_factory.h"
+#include "core/dom/container_node.h"
+#include "core/frame/window.h"
+#include "event_type_names.h"
 #include "native_value_converter.h"
 #include "qjs_add_event_listener_options.h"
 #include "qjs_event_target.h"
@@ -27,6 +29,36 @@ struct EventDispatchResult : public DartReadable {
 
 static std::atomic<int32_t> global_event_target_id{0};
 
+uint32_t EventListenerTypeBit(const AtomicString& event_type) {
+  if (event_type == event_type_names::kpointermove)
+    return kPointerMoveEventListenerType;
+  if (event_type == event_type_names::ktouchmove)
+    return kTouchMoveEventListenerType;
+  if (event_type == event_type_names::kmousemove)
+    return kMouseMoveEventListenerType;
+  if (event_type == event_type_names::kscroll)
+    return kScrollEventListenerType;
+  if (event_type == event_type_names::kclick)
+    return kClickEventListenerType;
+  if (event_type == event_type_names::kmousedown)
+    return kMouseDownEventListenerType;
+  if (event_type == event_type_names::kmouseup)
+    return kMouseUpEventListenerType;
+  if (event_type == event_type_names::kpointerdown)
+    return kPointerDownEventListenerType;
+  if (event_type == event_type_names::kpointerup)
+    return kPointerUpEventListenerType;
+  if (event_type == event_type_names::kpointercancel)
+    return kPointerCancelEventListenerType;
+  if (event_type == event_type_names::ktouchstart)
+    return kTouchStartEventListenerType;
+  if (event_type == event_type_names::ktouchend)
+    return kTouchEndEventListenerType;
+  if (event_type == event_type_names::ktouchcancel)
+    return kTouchCancelEventListenerType;
+  return kOtherEventListenerType;
+}
+
 Event::PassiveMode EventPassiveMode(const RegisteredEventListener& event_listener) {
   if (!event_listener.Passive()) {
     return Event::PassiveMode::kNotPassiveDefault;
@@ -219,6 +251,11 @@ bool EventTarget::AddEventListenerInternal(const AtomicString& event_type,
   if (added && listener_count == 1) {
     GetExecutingContext()->uiCommandBuffer()->addCommand(event_target_id_, UICommand::kAddEvent,
                                                          std::move(event_type.ToNativeString()), nullptr);
+    uint32_t type_bit = EventListenerTypeBit(event_type);
+    if ((listener_types_ & type_bit) == 0) {
+      listener_types_ |= type_bit;
+      ListenerTypesChanged();
+    }
   }
 
   return added;
@@ -265,18 +302,89 @@ bool EventTarget::RemoveEventListenerInternal(const AtomicString& event_type,
   if (listener_count == 0) {
     GetExecutingContext()->uiCommandBuffer()->addCommand(event_target_id_, UICommand::kRemoveEvent,
                                                          std::move(event_type.ToNativeString()), nullptr);
+    // Other types may share the bit of the removed one.
+    uint32_t listener_types = 0;
+    for (const AtomicString& type : d->event_listener_map.EventTypes()) {
+      listener_types |= EventListenerTypeBit(type);
+    }
+    if (listener_types != listener_types_) {
+      listener_types_ = listener_types;
+      ListenerTypesChanged();
+    }
   }
 
   return true;
 }
 
+bool EventTarget::HasEventPathListener(const AtomicString& event_type) const {
+  return (EventPathListenerTypes() & EventListenerTypeBit(event_type)) != 0;
+}
+
+void EventTarget::ListenerTypesChanged() {
+  SetEventPathListenerTypes(listener_types_);
+}
+
+void EventTarget::CollectEventPath(const Event& event, std::vector<EventTarget*>& path) {
+  path.emplace_back(this);
+  Node* node = ToNode();
+  if (node == nullptr)
+    return;
+
+  for (ContainerNode* parent = node->parentNode(); parent != nullptr; parent = parent->parentNode()) {
+    node = parent;
+    path.emplace_back(parent);
+  }
+  // The window takes part in the path of every event dispatched in the document, except load events.
+  // https://html.spec.whatwg.org/multipage/webappapis.html#events-and-the-window-object
+  if (node->IsDocumentNode() && event.type() != event_type_names::kload) {
+    path.emplace_back(GetExecutingContext()->window());
+  }
+}
+
 DispatchEventResult EventTarget::DispatchEventInternal(Event& event, ExceptionState& exception_state) {
+  if (!HasEventPathListener(event.type())) {
+    event.SetTarget(this);
+    return GetDispatchEventResult(event);
+  }
+
+  // The path is fixed before any listener runs, and the targets on it stay alive even when listeners remove them from
+  // the tree.
+  std::vector<EventTarget*> event_path;
+  CollectEventPath(event, event_path);
+  for (size_t i = 1; i < event_path.size(); i++) {
+    event_path[i]->RetainReference();
+  }
+
   event.SetTarget(this);
-  event.SetCurrentTarget(this);
-  event.SetEventPhase(Event::kAtTarget);
-  DispatchEventResult dispatch_result = FireEventListeners(event, exception_state);
+
+  event.SetEventPhase(Event::kCapturingPhase);
+  for (size_t i = event_path.size() - 1; i > 0 && !event.propagationStopped(); i--) {
+    event.SetCurrentTarget(event_path[i]);
+    event_path[i]->FireEventListeners(event, exception_state);
+  }
+
+  if (!event.propagationStopped()) {
+    event.SetEventPhase(Event::kAtTarget);
+    event.SetCurrentTarget(this);
+    FireEventListeners(event, exception_state);
+  }
+
+  if (event.bubbles()) {
+    event.SetEventPhase(Event::kBubblingPhase);
+    for (size_t i = 1; i < event_path.size() && !event.propagationStopped(); i++) {
+      event.SetCurrentTarget(event_path[i]);
+      event_path[i]->FireEventListeners(event, exception_state);
+    }
+  }
+
   event.SetEventPhase(0);
-  return dispatch_result;
+  event.SetCurrentTarget(nullptr);
+
+  MemberMutationScope* mutation_scope = GetExecutingContext()->mutationScope();
+  for (size_t i = 1; i < event_path.size(); i++) {
+    mutation_scope->RecordFree(event_path[i]);
+  }
+  return GetDispatchEventResult(event);
 }
 
 NativeValue EventTarget::HandleCallFromDartSide(const NativeValue* native_method,
@@ -293,16 +401,36 @@ NativeValue EventTarget::HandleCallFromDartSide(const NativeValue* native_method
 }
 
 NativeValue EventTarget::HandleDispatchEventFromDart(int32_t argc, const NativeValue* argv) {
-  assert(argc == 2);
+  assert(argc == 2 || argc == 3);
   AtomicString event_type = NativeValueConverter<NativeTypeString>::FromNativeValue(ctx(), argv[0]);
   RawEvent* raw_event = NativeValueConverter<NativeTypePointer<RawEvent>>::FromNativeValue(argv[1]);
+  // Dart walks the tree itself and calls in at each target, unless it asks for the whole event path to be dispatched
+  // here in one call.
+  bool propagate = argc == 3 && NativeValueConverter<NativeTypeBool>::FromNativeValue(argv[2]);
+
+  if (propagate && !HasEventPathListener(event_type)) {
+    return NativeValueConverter<NativeTypePointer<EventDispatchResult>>::ToNativeValue(new EventDispatchResult());
+  }
+
+  Event* event = GetExecutingContext()->eventPool()->Create(event_type, raw_event);
+  EventCoalescer* coalescer = GetExecutingContext()->eventCoalescer();
+  if (propagate && coalescer->ShouldCoalesce(*event)) {
+    coalescer->Enqueue(this, event);
+    return NativeValueConverter<NativeTypePointer<EventDispatchResult>>::ToNativeValue(new EventDispatchResult());
+  }
+  // The moves queued before this event reach the listeners first.
+  coalescer->Flush();
 
-  Event* event = EventFactory::Create(GetExecutingContext(), event_type, raw_event);
   ExceptionState exception_state;
   event->SetTrusted(false);
-  event->SetEventPhase(Event::kAtTarget);
-  DispatchEventResult dispatch_result = FireEventListeners(*event, exception_state);
-  event->SetEventPhase(0);
+  DispatchEventResult dispatch_result;
+  if (propagate) {
+    dispatch_result = DispatchEventInternal(*event, exception_state);
+  } else {
+    event->SetEventPhase(Event::kAtTarget);
+    dispatch_result = FireEventListeners(*event, exception_state);
+    event->SetEventPhase(0);
+  }
 
   if (exception_state.HasException()) {
     JSValue error = JS_GetException(ctx());
@@ -312,6 +440,7 @@ NativeValue EventTarget::HandleDispatchEventFromDart(int32_t argc, const NativeV
 
   auto* result = new EventDispatchResult{.canceled = dispatch_result == DispatchEventResult::kCanceledByEventHandler,
                                          .propagationStopped = event->propagationStopped()};
+  GetExecutingContext()->eventPool()->Recycle(event);
   return NativeValueConverter<NativeTypePointer<EventDispatchResult>>::ToNativeValue(result);
 }
 
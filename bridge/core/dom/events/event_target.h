@@ -43,6 +43,28 @@ enum class DispatchEventResult {
   kCanceledBeforeDispatch,
 };
 
+// Event types dispatched often enough, e.g. once per pointer move, that telling cheaply whether anybody listens to
+// them pays off have a bit of their own. All other types share kOtherEventListenerType.
+// Must match the bits in webf/lib/src/bridge/binding.dart.
+enum EventListenerTypeBits : uint32_t {
+  kClickEventListenerType = 1u << 0,
+  kMouseDownEventListenerType = 1u << 1,
+  kMouseUpEventListenerType = 1u << 2,
+  kMouseMoveEventListenerType = 1u << 3,
+  kPointerDownEventListenerType = 1u << 4,
+  kPointerMoveEventListenerType = 1u << 5,
+  kPointerUpEventListenerType = 1u << 6,
+  kPointerCancelEventListenerType = 1u << 7,
+  kTouchStartEventListenerType = 1u << 8,
+  kTouchMoveEventListenerType = 1u << 9,
+  kTouchEndEventListenerType = 1u << 10,
+  kTouchCancelEventListenerType = 1u << 11,
+  kScrollEventListenerType = 1u << 12,
+  kOtherEventListenerType = 1u << 31,
+};
+
+uint32_t EventListenerTypeBit(const AtomicString& event_type);
+
 struct FiringEventIterator {
   WEBF_DISALLOW_NEW();
 
@@ -126,6 +148,14 @@ class EventTarget : public ScriptWrappable, public BindingObject {
 
   EventListenerVector* GetEventListeners(const AtomicString& event_type);
 
+  // EventListenerTypeBit bits of the event types this target has listeners for.
+  uint32_t ListenerTypes() const { return listener_types_; }
+  // EventListenerTypeBit bits of the event types listened to by any target on the event path of this one.
+  uint32_t EventPathListenerTypes() const { return bindingObject()->event_path_listener_types; }
+  // False when no listener on the event path can be reached by an event of |event_type|, so dispatching it would be a
+  // no-op. Types without a bit of their own may give false positives.
+  bool HasEventPathListener(const AtomicString& event_type) const;
+
   int32_t eventTargetId() const { return event_target_id_; }
 
   virtual bool IsWindowOrWorkerGlobalScope() const { return false; }
@@ -145,6 +175,13 @@ class EventTarget : public ScriptWrappable, public BindingObject {
                                    const std::shared_ptr<EventListener>& listener,
                                    const std::shared_ptr<EventListenerOptions>& options);
 
+  void SetEventPathListenerTypes(uint32_t types) { bindingObject()->event_path_listener_types = types; }
+  // Called when ListenerTypes() changed, updates the event path listener types of this target and the ones whose event
+  // path goes through it.
+  virtual void ListenerTypesChanged();
+
+  // Runs the capture, target and bubble phases of |event| against the listeners of each target on the event path, see
+  // https://dom.spec.whatwg.org/#concept-event-dispatch
   DispatchEventResult DispatchEventInternal(Event& event, ExceptionState& exception_state);
 
   NativeValue HandleCallFromDartSide(const NativeValue* native_method, int32_t argc, const NativeValue* argv) override;
@@ -157,8 +194,13 @@ class EventTarget : public ScriptWrappable, public BindingObject {
 
  private:
   RegisteredEventListener* GetAttributeRegisteredEventListener(const AtomicString& event_type);
+  // This target followed by its ancestors in the tree, up to the window for nodes in the document.
+  void CollectEventPath(const Event& event, std::vector<EventTarget*>& path);
+
+  friend class EventCoalescer;
 
   int32_t event_target_id_;
+  uint32_t listener_types_{0};
   bool FireEventListeners(Event&, EventTargetData*, EventListenerVector&, ExceptionState&);
 };
 
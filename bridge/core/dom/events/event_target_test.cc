@@ -4,7 +4,9 @@
  */
 #include "event_target.h"
 #include "core/dom/container_node.h"
+#include "core/dom/document.h"
 #include "core/dom/events/event.h"
+#include "core/html/html_body_element.h"
 #include "event_type_names.h"
 #include "gtest/gtest.h"
 #include "webf_test_env.h"
@@ -252,3 +254,110 @@ TEST(EventTarget, shouldKeepAtom) {
   bridge->evaluateScript(code3.c_str(), code3.size(), "internal://", 0);
   EXPECT_EQ(logCalled, true);
 }
+
+TEST(EventTarget, dispatchEventAlongPath) {
+  bool static errorCalled = false;
+  bool static logCalled = false;
+  webf::WebFPage::consoleMessageHandler = [](void* ctx, const std::string& message, int logLevel) {
+    logCalled = true;
+    EXPECT_STREQ(message.c_str(),
+                 "window 1,document 1,parent 1,child 2,child 2,parent 3,document 3,window 3,null 0");
+  };
+  auto bridge = TEST_init([](int32_t contextId, const char* errmsg) {
+    WEBF_LOG(VERBOSE) << errmsg;
+    errorCalled = true;
+  });
+  std::string code =
+      "let parent = document.createElement('div'); let child = document.createElement('span');"
+      "parent.appendChild(child); document.body.appendChild(parent); let log = [];"
+      "function listen(target, name, capture) {"
+      "  target.addEventListener('custom', e => log.push(name + ' ' + e.eventPhase), capture); }"
+      "listen(window, 'window', false); listen(window, 'window', true);"
+      "listen(document, 'document', false); listen(document, 'document', true);"
+      "listen(parent, 'parent', false); listen(parent, 'parent', true);"
+      "listen(child, 'child', false); listen(child, 'child', true);"
+      "let event = new Event('custom', {bubbles: true}); child.dispatchEvent(event);"
+      "log.push(event.currentTarget + ' ' + event.eventPhase); console.log(log.join(','));";
+  bridge->evaluateScript(code.c_str(), code.size(), "vm://", 0);
+  EXPECT_EQ(errorCalled, false);
+  EXPECT_EQ(logCalled, true);
+}
+
+TEST(EventTarget, eventPathListenerTypes) {
+  bool static errorCalled = false;
+  auto bridge = TEST_init([](int32_t contextId, const char* errmsg) {
+    WEBF_LOG(VERBOSE) << errmsg;
+    errorCalled = true;
+  });
+  auto context = bridge->GetExecutingContext();
+  std::string code =
+      "let div = document.createElement('div'); div.appendChild(document.createElement('span'));"
+      "document.body.addEventListener('pointermove', () => {}); document.body.appendChild(div);";
+  bridge->evaluateScript(code.c_str(), code.size(), "vm://", 0);
+
+  Node* div = context->document()->body()->firstChild();
+  Node* span = div->firstChild();
+  EXPECT_TRUE(span->HasEventPathListener(event_type_names::kpointermove));
+  EXPECT_FALSE(span->HasEventPathListener(event_type_names::ktouchmove));
+  EXPECT_FALSE(context->document()->HasEventPathListener(event_type_names::kpointermove));
+
+  code = "window.addEventListener('touchmove', () => {}); document.body.removeChild(div);";
+  bridge->evaluateScript(code.c_str(), code.size(), "vm://", 0);
+  EXPECT_FALSE(span->HasEventPathListener(event_type_names::kpointermove));
+  EXPECT_FALSE(span->HasEventPathListener(event_type_names::ktouchmove));
+  EXPECT_TRUE(context->document()->body()->HasEventPathListener(event_type_names::ktouchmove));
+  EXPECT_EQ(errorCalled, false);
+}
+
+TEST(EventTarget, stopPropagationAlongPath) {
+  bool static errorCalled = false;
+  bool static logCalled = false;
+  webf::WebFPage::consoleMessageHandler = [](void* ctx, const std::string& message, int logLevel) {
+    logCalled = true;
+    EXPECT_STREQ(message.c_str(), "parent capture,parent capture,child,parent capture,child");
+  };
+  auto bridge = TEST_init([](int32_t contextId, const char* errmsg) {
+    WEBF_LOG(VERBOSE) << errmsg;
+    errorCalled = true;
+  });
+  std::string code =
+      "let parent = document.createElement('div'); let child = document.createElement('span');"
+      "parent.appendChild(child); let log = []; let stop = true;"
+      "parent.addEventListener('custom', e => { log.push('parent capture'); if (stop) e.stopPropagation(); }, true);"
+      "parent.addEventListener('custom', e => log.push('parent bubble'));"
+      "child.addEventListener('custom', e => log.push('child'));"
+      "child.dispatchEvent(new Event('custom', {bubbles: true}));"
+      "stop = false; child.dispatchEvent(new Event('custom'));"
+      "child.addEventListener('custom', e => e.stopPropagation());"
+      "child.dispatchEvent(new Event('custom', {bubbles: true}));"
+      "console.log(log.join(','));";
+  bridge->evaluateScript(code.c_str(), code.size(), "vm://", 0);
+  EXPECT_EQ(errorCalled, false);
+  EXPECT_EQ(logCalled, true);
+}
+
+TEST(EventTarget, manyEventTypes) {
+  bool static errorCalled = false;
+  bool static logCalled = false;
+  webf::WebFPage::consoleMessageHandler = [](void* ctx, const std::string& message, int logLevel) {
+    logCalled = true;
+    EXPECT_STREQ(message.c_str(), "26 true 1");
+  };
+  auto bridge = TEST_init([](int32_t contextId, const char* errmsg) {
+    WEBF_LOG(VERBOSE) << errmsg;
+    errorCalled = true;
+  });
+  std::string code =
+      "let div = document.createElement('div'); let fired = []; let listeners = [];"
+      "for (let i = 0; i < 40; i++) {"
+      "  listeners.push(e => fired.push(e.type)); div.addEventListener('type' + i, listeners[i]); }"
+      "for (let i = 0; i < 40; i += 3) div.removeEventListener('type' + i, listeners[i]);"
+      "for (let i = 0; i < 40; i++) div.dispatchEvent(new Event('type' + i));"
+      "let count = fired.length; let kept = fired.every(type => Number(type.slice(4)) % 3 != 0);"
+      "for (let i = 0; i < 38; i++) div.removeEventListener('type' + i, listeners[i]);"
+      "fired = []; for (let i = 0; i < 40; i++) div.dispatchEvent(new Event('type' + i));"
+      "console.log(count, kept, fired.length);";
+  bridge->evaluateScript(code.c_str(), code.size(), "vm://", 0);
+  EXPECT_EQ(errorCalled, false);
+  EXPECT_EQ(logCalled, true);
+}
@@ -8,22 +8,20 @@
 
 #include "bindings/qjs/exception_state.h"
 #include "bindings/qjs/script_wrappable.h"
-#include "core/binding_object.h"
 
 namespace webf {
 
 class ExecutingContext;
 
-class BoundingClientRect : public ScriptWrappable, public BindingObject {
+// Built from the geometry snapshot of the element, reading the values never calls dart side.
+class BoundingClientRect : public ScriptWrappable {
   DEFINE_WRAPPERTYPEINFO();
 
  public:
   using ImplType = BoundingClientRect*;
   BoundingClientRect() = delete;
-  static BoundingClientRect* Create(ExecutingContext* context, NativeBindingObject* native_binding_object);
-  explicit BoundingClientRect(ExecutingContext* context, NativeBindingObject* native_binding_object);
-
-  NativeValue HandleCallFromDartSide(const NativeValue* method, int32_t argc, const NativeValue* argv) override;
+  static BoundingClientRect* Create(ExecutingContext* context, double x, double y, double width, double height);
+  explicit BoundingClientRect(ExecutingContext* context, double x, double y, double width, double height);
 
   double x() const { return x_; }
   double y() const { return y_; }
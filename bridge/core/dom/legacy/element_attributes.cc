@@ -7,6 +7,7 @@
 #include "bindings/qjs/exception_state.h"
 #include "built_in_string.h"
 #include "core/dom/element.h"
+#include "core/dom/markup_escape.h"
 #include "foundation/native_value_converter.h"
 
 namespace webf {
@@ -73,6 +74,11 @@ bool ElementAttributes::hasAttribute(const AtomicString& name, ExceptionState& e
   return attributes_.count(name) > 0;
 }
 
+const AtomicString* ElementAttributes::FindAttribute(const AtomicString& name) const {
+  auto it = attributes_.find(name);
+  return it != attributes_.end() ? &it->second : nullptr;
+}
+
 void ElementAttributes::removeAttribute(const AtomicString& name, ExceptionState& exception_state) {
   attributes_.erase(name);
 
@@ -87,15 +93,14 @@ void ElementAttributes::CopyWith(ElementAttributes* attributes) {
   }
 }
 
-std::string ElementAttributes::ToString() {
-  std::string s;
-
+void ElementAttributes::ToString(std::string& result) const {
   for (auto& attr : attributes_) {
-    s += attr.first.ToStdString() + "=";
-    s += "\"" + attr.second.ToStdString() + "\"";
+    result += ' ';
+    result += attr.first.ToStdString();
+    result += "=\"";
+    AppendEscapedMarkup(result, attr.second.ToStdString(), MarkupEscapeMode::kAttributeValue);
+    result += '"';
   }
-
-  return s;
 }
 
 bool ElementAttributes::IsEquivalent(const ElementAttributes& other) const {
@@ -31,14 +31,21 @@ class ElementAttributes : public ScriptWrappable {
   AtomicString getAttribute(const AtomicString& name, ExceptionState& exception_state);
   bool setAttribute(const AtomicString& name, const AtomicString& value, ExceptionState& exception_state);
   bool hasAttribute(const AtomicString& name, ExceptionState& exception_state);
+  // Native lookup without falling back to dart side, return nullptr when the attribute is not set.
+  const AtomicString* FindAttribute(const AtomicString& name) const;
   void removeAttribute(const AtomicString& name, ExceptionState& exception_state);
   void CopyWith(ElementAttributes* attributes);
-  std::string ToString();
+  // Append every attribute as ` name="value"` to |result|, with the values escaped.
+  void ToString(std::string& result) const;
 
   bool IsEquivalent(const ElementAttributes& other) const;
 
   void Trace(GCVisitor* visitor) const override;
 
+ protected:
+  // Created by the HTML parser along with their element, see Element::DidCreateDeferredWrapper.
+  bool CanDeferWrapper() const override { return true; }
+
  private:
   Member<Element> element_;
   std::unordered_map<AtomicString, AtomicString, AtomicString::KeyHasher> attributes_;
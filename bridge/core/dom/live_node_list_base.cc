@@ -23,3 +23,18 @@
  */
 
 #include "live_node_list_base.h"
+
+namespace webf {
+
+ContainerNode& LiveNodeListBase::RootNode() const {
+  if (IsRootedAtTreeScope() && owner_node_->IsInTreeScope())
+    return owner_node_->GetTreeScope().RootNode();
+  return *owner_node_;
+}
+
+void LiveNodeListBase::InvalidateCacheForAttribute(const AtomicString& attr_name) const {
+  if (ShouldInvalidateTypeOnAttributeChange(InvalidationType(), attr_name))
+    InvalidateCache();
+}
+
+}  // namespace webf
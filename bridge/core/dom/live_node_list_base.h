@@ -39,7 +39,8 @@ enum class NodeListSearchRoot {
   kTreeScope,
 };
 
-class LiveNodeListBase : public GarbageCollected<LiveNodeListBase> {
+// Shared by the live collections, which are ScriptWrappables themselves, so this is a plain mixin traced by them.
+class LiveNodeListBase {
  public:
   explicit LiveNodeListBase(ContainerNode* owner_node,
                             NodeListSearchRoot search_root,
@@ -73,7 +74,7 @@ class LiveNodeListBase : public GarbageCollected<LiveNodeListBase> {
 
   static bool ShouldInvalidateTypeOnAttributeChange(NodeListInvalidationType, const AtomicString&);
 
-  void Trace(GCVisitor* visitor) const override { visitor->Trace(owner_node_); }
+  virtual void Trace(GCVisitor* visitor) const { visitor->Trace(owner_node_); }
 
  protected:
   Document& GetDocument() const { return owner_node_->GetDocument(); }
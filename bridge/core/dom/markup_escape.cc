@@ -0,0 +1,54 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "markup_escape.h"
+
+namespace webf {
+
+void AppendEscapedMarkup(std::string& result, const std::string& value, MarkupEscapeMode mode) {
+  size_t length = value.size();
+  size_t last_copied = 0;
+  result.reserve(result.size() + length);
+
+  for (size_t i = 0; i < length; i++) {
+    const char* replacement = nullptr;
+    size_t consumed = 1;
+    switch (value[i]) {
+      case '&':
+        replacement = "&amp;";
+        break;
+      case '"':
+        if (mode == MarkupEscapeMode::kAttributeValue)
+          replacement = "&quot;";
+        break;
+      case '<':
+        if (mode == MarkupEscapeMode::kText)
+          replacement = "&lt;";
+        break;
+      case '>':
+        if (mode == MarkupEscapeMode::kText)
+          replacement = "&gt;";
+        break;
+      case '\xC2':
+        // U+00A0 NO-BREAK SPACE is encoded as C2 A0.
+        if (i + 1 < length && value[i + 1] == '\xA0') {
+          replacement = "&nbsp;";
+          consumed = 2;
+        }
+        break;
+      default:
+        break;
+    }
+
+    if (replacement == nullptr)
+      continue;
+    result.append(value, last_copied, i - last_copied);
+    result.append(replacement);
+    i += consumed - 1;
+    last_copied = i + 1;
+  }
+  result.append(value, last_copied, length - last_copied);
+}
+
+}  // namespace webf
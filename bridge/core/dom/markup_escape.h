@@ -0,0 +1,24 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef BRIDGE_CORE_DOM_MARKUP_ESCAPE_H_
+#define BRIDGE_CORE_DOM_MARKUP_ESCAPE_H_
+
+#include <string>
+
+namespace webf {
+
+enum class MarkupEscapeMode {
+  // Text node data, "&", "<", ">" and no-break spaces are escaped.
+  kText,
+  // Double quoted attribute values, "&", "\"" and no-break spaces are escaped.
+  kAttributeValue,
+};
+
+// Append UTF-8 |value| to |result|, escaped as https://html.spec.whatwg.org/#escapingString describes.
+void AppendEscapedMarkup(std::string& result, const std::string& value, MarkupEscapeMode mode);
+
+}  // namespace webf
+
+#endif  // BRIDGE_CORE_DOM_MARKUP_ESCAPE_H_
@@ -15,6 +15,7 @@
 #include "node_traversal.h"
 #include "qjs_node.h"
 #include "text.h"
+#include "core/frame/window.h"
 
 namespace webf {
 
@@ -39,6 +40,29 @@ void Node::setNodeValue(const AtomicString& value, ExceptionState& exception_sta
   // By default, setting nodeValue has no effect.
 }
 
+void Node::UpdateEventPathListenerTypes() {
+  Node* node = this;
+  while (node) {
+    uint32_t types = node->ListenerTypes();
+    if (ContainerNode* parent = node->parentNode()) {
+      types |= parent->EventPathListenerTypes();
+    } else if (node->IsDocumentNode() && GetExecutingContext()->window()) {
+      types |= GetExecutingContext()->window()->EventPathListenerTypes();
+    }
+    // The subtree of a node whose types stay the same was computed from them already.
+    if (types == node->EventPathListenerTypes()) {
+      node = NodeTraversal::NextSkippingChildren(*node, this);
+      continue;
+    }
+    node->SetEventPathListenerTypes(types);
+    node = NodeTraversal::Next(*node, this);
+  }
+}
+
+void Node::ListenerTypesChanged() {
+  UpdateEventPathListenerTypes();
+}
+
 ContainerNode* Node::parentNode() const {
   return ParentOrShadowHostNode();
 }
@@ -330,6 +354,8 @@ void Node::RemovedFrom(ContainerNode& insertion_point) {
   if (insertion_point.isConnected()) {
     ClearFlag(kIsConnectedFlag);
     insertion_point.GetDocument().DecrementNodeCount();
+    // Only the document tree keeps nodes without a JS object alive. Out of it, the node is owned by the GC again.
+    EnsureWrapper();
   }
 }
 
@@ -142,6 +142,10 @@ class Node : public EventTarget {
 
   [[nodiscard]] bool IsDocumentNode() const;
 
+  // Recomputes the event path listener types of this node and its descendants after its own listener types or its
+  // place in the tree changed.
+  void UpdateEventPathListenerTypes();
+
   // Node's parent, shadow tree host.
   [[nodiscard]] ContainerNode* ParentOrShadowHostNode() const;
   [[nodiscard]] Element* ParentOrShadowHostElement() const;
@@ -286,6 +290,11 @@ class Node : public EventTarget {
   }
 
  protected:
+  // Nodes created by the HTML parser get their JS object when script first reaches them.
+  bool CanDeferWrapper() const override { return true; }
+
+  void ListenerTypesChanged() override;
+
   enum ConstructionType {
     kCreateOther = kDefaultNodeFlags | static_cast<NodeFlags>(DOMNodeType::kOther) |
                    static_cast<NodeFlags>(ElementNamespaceType::kOther),
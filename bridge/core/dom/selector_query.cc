@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "selector_query.h"
+#include "bindings/qjs/exception_state.h"
+#include "core/css/css_selector_parser.h"
+#include "core/css/selector_checker.h"
+#include "core/dom/element_traversal.h"
+#include "html_names.h"
+
+namespace webf {
+
+SelectorQuery::SelectorQuery(std::unique_ptr<CSSSelectorList> selector_list)
+    : selector_list_(std::move(selector_list)) {
+  const std::vector<CSSComplexSelector>& selectors = selector_list_->Selectors();
+  if (selectors.size() != 1 || selectors[0].compounds.size() != 1 ||
+      selectors[0].compounds[0].selectors.size() != 1) {
+    return;
+  }
+
+  const CSSSelector& selector = selectors[0].compounds[0].selectors[0];
+  switch (selector.Match()) {
+    case CSSSelector::MatchType::kId:
+      fast_path_ = FastPath::kId;
+      break;
+    case CSSSelector::MatchType::kClass:
+      fast_path_ = FastPath::kClass;
+      break;
+    case CSSSelector::MatchType::kTag:
+      fast_path_ = FastPath::kTag;
+      break;
+    default:
+      return;
+  }
+  fast_path_value_ = selector.Value();
+}
+
+bool SelectorQuery::Matches(const Element& element) const {
+  switch (fast_path_) {
+    case FastPath::kId: {
+      const AtomicString* id = element.FindAttribute(html_names::kIdAttr);
+      return id != nullptr && *id == fast_path_value_;
+    }
+    case FastPath::kClass:
+      return element.HasClass(fast_path_value_);
+    case FastPath::kTag:
+      return element.HasTagName(fast_path_value_);
+    case FastPath::kNone:
+      break;
+  }
+  return SelectorChecker::Match(*selector_list_, element);
+}
+
+Element* SelectorQuery::QueryFirst(ContainerNode& root) const {
+  std::vector<Element*> result;
+  Execute<true>(root, result);
+  return result.empty() ? nullptr : result[0];
+}
+
+std::vector<Element*> SelectorQuery::QueryAll(ContainerNode& root) const {
+  std::vector<Element*> result;
+  Execute<false>(root, result);
+  return result;
+}
+
+// Descendants of |root| in tree order, |root| itself is never a candidate.
+template <bool first_only>
+void SelectorQuery::Execute(ContainerNode& root, std::vector<Element*>& result) const {
+  if (fast_path_ == FastPath::kId && root.isConnected()) {
+    ExecuteWithId<first_only>(root, result);
+    return;
+  }
+
+  for (Element& element : ElementTraversal::DescendantsOf(root)) {
+    if (Matches(element)) {
+      result.emplace_back(&element);
+      if (first_only)
+        return;
+    }
+  }
+}
+
+// Connected elements are indexed by id in their tree scope, look them up instead of walking the whole subtree.
+template <bool first_only>
+void SelectorQuery::ExecuteWithId(ContainerNode& root, std::vector<Element*>& result) const {
+  const TreeScope& scope = root.GetTreeScope();
+  bool root_is_scope = &scope.RootNode() == &root;
+  if (!scope.ContainsMultipleElementsWithId(fast_path_value_)) {
+    Element* element = scope.getElementById(fast_path_value_);
+    if (element != nullptr && (root_is_scope || element->IsDescendantOf(&root)))
+      result.emplace_back(element);
+    return;
+  }
+
+  for (Element* element : scope.GetAllElementsById(fast_path_value_)) {
+    if (root_is_scope || element->IsDescendantOf(&root)) {
+      result.emplace_back(element);
+      if (first_only)
+        return;
+    }
+  }
+}
+
+SelectorQuery* SelectorQueryCache::Add(JSContext* ctx, const AtomicString& selectors, ExceptionState& exception_state) {
+  auto it = entries_.find(selectors);
+  if (it != entries_.end()) {
+    recency_.splice(recency_.begin(), recency_, it->second);
+    return it->second->second.get();
+  }
+
+  std::unique_ptr<CSSSelectorList> selector_list = CSSSelectorParser::Parse(ctx, selectors.ToStdString());
+  if (selector_list == nullptr) {
+    exception_state.ThrowException(ctx, ErrorType::SyntaxError,
+                                   "'" + selectors.ToStdString() + "' is not a valid selector.");
+    return nullptr;
+  }
+
+  if (entries_.size() >= kMaximumSize) {
+    entries_.erase(recency_.back().first);
+    recency_.pop_back();
+  }
+  recency_.emplace_front(selectors, std::make_unique<SelectorQuery>(std::move(selector_list)));
+  entries_[selectors] = recency_.begin();
+  return recency_.front().second.get();
+}
+
+}  // namespace webf
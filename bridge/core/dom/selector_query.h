@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef BRIDGE_CORE_DOM_SELECTOR_QUERY_H_
+#define BRIDGE_CORE_DOM_SELECTOR_QUERY_H_
+
+#include <list>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+#include "bindings/qjs/atomic_string.h"
+#include "core/css/css_selector.h"
+
+namespace webf {
+
+class ContainerNode;
+class Element;
+class ExceptionState;
+
+// Answers querySelector() and querySelectorAll() by walking the DOM tree at the bridge side.
+class SelectorQuery {
+ public:
+  explicit SelectorQuery(std::unique_ptr<CSSSelectorList> selector_list);
+
+  bool Matches(const Element& element) const;
+  Element* QueryFirst(ContainerNode& root) const;
+  std::vector<Element*> QueryAll(ContainerNode& root) const;
+
+ private:
+  template <bool first_only>
+  void Execute(ContainerNode& root, std::vector<Element*>& result) const;
+  template <bool first_only>
+  void ExecuteWithId(ContainerNode& root, std::vector<Element*>& result) const;
+
+  // Queries of a single #id, .class or type selector are the most common ones, match them without the checker.
+  enum class FastPath { kNone, kId, kClass, kTag };
+
+  std::unique_ptr<CSSSelectorList> selector_list_;
+  FastPath fast_path_{FastPath::kNone};
+  AtomicString fast_path_value_;
+};
+
+// Parsed selectors of a document keyed by the selector text, the least recently used one is dropped when full.
+class SelectorQueryCache {
+ public:
+  // Keep the cache small, pages usually query with a handful of selectors again and again.
+  static constexpr size_t kMaximumSize = 256;
+
+  // Return nullptr and throw a SyntaxError when |selectors| can not be parsed.
+  SelectorQuery* Add(JSContext* ctx, const AtomicString& selectors, ExceptionState& exception_state);
+
+  bool Contains(const AtomicString& selectors) const { return entries_.count(selectors) > 0; }
+  size_t size() const { return entries_.size(); }
+
+ private:
+  using Entry = std::pair<AtomicString, std::unique_ptr<SelectorQuery>>;
+
+  // Most recently used first.
+  std::list<Entry> recency_;
+  std::unordered_map<AtomicString, std::list<Entry>::iterator, AtomicString::KeyHasher> entries_;
+};
+
+}  // namespace webf
+
+#endif  // BRIDGE_CORE_DOM_SELECTOR_QUERY_H_
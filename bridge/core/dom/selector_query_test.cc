@@ -0,0 +1,183 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "selector_query.h"
+#include "bindings/qjs/exception_state.h"
+#include "core/dom/document.h"
+#include "gtest/gtest.h"
+#include "webf_test_env.h"
+
+using namespace webf;
+
+namespace {
+
+const char* kSelectorQueryFixture =
+    "let root = document.createElement('div');"
+    "root.id = 'root';"
+    "for (let i = 0; i < 4; i++) {"
+    "  let section = document.createElement('section');"
+    "  section.className = i % 2 == 0 ? 'item even' : 'item odd';"
+    "  section.setAttribute('data-index', 'index-' + i);"
+    "  for (let j = 0; j < 3; j++) {"
+    "    let span = document.createElement('span');"
+    "    span.id = 'span-' + i + '-' + j;"
+    "    section.appendChild(span);"
+    "  }"
+    "  root.appendChild(section);"
+    "}"
+    "document.body.appendChild(root);"
+    "function ids(list) { return Array.from(list).map(e => e.id || e.className).join(','); }";
+
+}  // namespace
+
+TEST(SelectorQuery, compoundAndCombinators) {
+  bool static errorCalled = false;
+  bool static logCalled = false;
+  webf::WebFPage::consoleMessageHandler = [](void* ctx, const std::string& message, int logLevel) {
+    logCalled = true;
+    EXPECT_STREQ(message.c_str(),
+                 "12 6 span-1-0,span-1-1,span-1-2,span-3-0,span-3-1,span-3-2 span-0-1 span-2-1,span-2-2 item odd");
+  };
+  auto bridge = TEST_init([](int32_t contextId, const char* errmsg) {
+    WEBF_LOG(VERBOSE) << errmsg;
+    errorCalled = true;
+  });
+  std::string code = std::string(kSelectorQueryFixture) +
+                     "console.log("
+                     "  document.querySelectorAll('#root span').length,"
+                     "  document.querySelectorAll('section.even > span').length,"
+                     "  ids(root.querySelectorAll('.odd span')),"
+                     "  ids(document.querySelectorAll('#span-0-0 + span')),"
+                     "  ids(document.querySelectorAll('.even:not(:first-child) #span-2-0 ~ span')),"
+                     "  root.querySelector('.even + section').className"
+                     ");";
+  bridge->evaluateScript(code.c_str(), code.size(), "vm://", 0);
+  EXPECT_EQ(errorCalled, false);
+  EXPECT_EQ(logCalled, true);
+}
+
+TEST(SelectorQuery, attributeAndPseudoClasses) {
+  bool static errorCalled = false;
+  bool static logCalled = false;
+  webf::WebFPage::consoleMessageHandler = [](void* ctx, const std::string& message, int logLevel) {
+    logCalled = true;
+    EXPECT_STREQ(message.c_str(), "4 1 1 0 item even,item even 4 span-0-2 true");
+  };
+  auto bridge = TEST_init([](int32_t contextId, const char* errmsg) {
+    WEBF_LOG(VERBOSE) << errmsg;
+    errorCalled = true;
+  });
+  std::string code = std::string(kSelectorQueryFixture) +
+                     "console.log("
+                     "  document.querySelectorAll('[data-index^=index-]').length,"
+                     "  document.querySelectorAll('[data-index=\"INDEX-3\" i]').length,"
+                     "  document.querySelectorAll('section[class~=odd][data-index$=\"3\"]').length,"
+                     "  document.querySelectorAll('[class|=item]').length,"
+                     "  ids(root.querySelectorAll('section:nth-child(odd)')),"
+                     "  root.querySelectorAll('span:nth-child(2n+1):not(:last-child)').length,"
+                     "  root.querySelector('section:first-child span:last-child').id,"
+                     "  root.querySelector('span:empty') !== null"
+                     ");";
+  bridge->evaluateScript(code.c_str(), code.size(), "vm://", 0);
+  EXPECT_EQ(errorCalled, false);
+  EXPECT_EQ(logCalled, true);
+}
+
+TEST(SelectorQuery, getElementsBy) {
+  bool static errorCalled = false;
+  bool static logCalled = false;
+  webf::WebFPage::consoleMessageHandler = [](void* ctx, const std::string& message, int logLevel) {
+    logCalled = true;
+    EXPECT_STREQ(message.c_str(), "span-2-1 2 4 12 true");
+  };
+  auto bridge = TEST_init([](int32_t contextId, const char* errmsg) {
+    WEBF_LOG(VERBOSE) << errmsg;
+    errorCalled = true;
+  });
+  std::string code = std::string(kSelectorQueryFixture) +
+                     "console.log("
+                     "  document.getElementById('span-2-1').id,"
+                     "  document.getElementsByClassName(' odd  item ').length,"
+                     "  root.getElementsByTagName('section').length,"
+                     "  root.getElementsByTagName('span').length,"
+                     "  document.getElementById('missing') === null"
+                     ");";
+  bridge->evaluateScript(code.c_str(), code.size(), "vm://", 0);
+  EXPECT_EQ(errorCalled, false);
+  EXPECT_EQ(logCalled, true);
+}
+
+TEST(SelectorQuery, invalidSelectorThrowsSyntaxError) {
+  bool static errorCalled = false;
+  bool static logCalled = false;
+  webf::WebFPage::consoleMessageHandler = [](void* ctx, const std::string& message, int logLevel) {
+    logCalled = true;
+    EXPECT_STREQ(message.c_str(), "SyntaxError SyntaxError SyntaxError");
+  };
+  auto bridge = TEST_init([](int32_t contextId, const char* errmsg) {
+    WEBF_LOG(VERBOSE) << errmsg;
+    errorCalled = true;
+  });
+  const char* code =
+      "function errorName(selectors) {"
+      "  try { document.querySelectorAll(selectors); } catch (e) { return e.name; }"
+      "  return 'no error';"
+      "}"
+      "console.log(errorName('div >'), errorName('[data-x'), errorName(':nth-child(x)'));";
+  bridge->evaluateScript(code, strlen(code), "vm://", 0);
+  EXPECT_EQ(errorCalled, false);
+  EXPECT_EQ(logCalled, true);
+}
+
+TEST(SelectorQuery, matchesAndClosest) {
+  bool static errorCalled = false;
+  bool static logCalled = false;
+  webf::WebFPage::consoleMessageHandler = [](void* ctx, const std::string& message, int logLevel) {
+    logCalled = true;
+    EXPECT_STREQ(message.c_str(), "true false true item odd span-1-2 root true SyntaxError");
+  };
+  auto bridge = TEST_init([](int32_t contextId, const char* errmsg) {
+    WEBF_LOG(VERBOSE) << errmsg;
+    errorCalled = true;
+  });
+  std::string code = std::string(kSelectorQueryFixture) +
+                     "let span = document.getElementById('span-1-2');"
+                     "let name;"
+                     "try { span.matches('span >'); } catch (e) { name = e.name; }"
+                     "console.log("
+                     "  span.matches('.odd > span:last-child'),"
+                     "  span.matches('.even span'),"
+                     "  span.matches('#root span'),"
+                     "  span.closest('section').className,"
+                     "  span.closest('span').id,"
+                     "  span.closest('div').id,"
+                     "  span.closest('.missing') === null,"
+                     "  name"
+                     ");";
+  bridge->evaluateScript(code.c_str(), code.size(), "vm://", 0);
+  EXPECT_EQ(errorCalled, false);
+  EXPECT_EQ(logCalled, true);
+}
+
+TEST(SelectorQuery, cacheEvictsLeastRecentlyUsed) {
+  auto bridge = TEST_init();
+  auto context = bridge->GetExecutingContext();
+  SelectorQueryCache& cache = context->document()->GetSelectorQueryCache();
+  auto selector = [&](size_t i) { return AtomicString(context->ctx(), ".item-" + std::to_string(i)); };
+
+  for (size_t i = 0; i < SelectorQueryCache::kMaximumSize; i++) {
+    EXPECT_NE(cache.Add(context->ctx(), selector(i), ASSERT_NO_EXCEPTION()), nullptr);
+  }
+  EXPECT_EQ(cache.size(), SelectorQueryCache::kMaximumSize);
+
+  // Touch the oldest entry so the second oldest becomes the one to drop.
+  cache.Add(context->ctx(), selector(0), ASSERT_NO_EXCEPTION());
+  cache.Add(context->ctx(), selector(SelectorQueryCache::kMaximumSize), ASSERT_NO_EXCEPTION());
+
+  EXPECT_EQ(cache.size(), SelectorQueryCache::kMaximumSize);
+  EXPECT_TRUE(cache.Contains(selector(0)));
+  EXPECT_FALSE(cache.Contains(selector(1)));
+  EXPECT_TRUE(cache.Contains(selector(2)));
+  EXPECT_TRUE(cache.Contains(selector(SelectorQueryCache::kMaximumSize)));
+}
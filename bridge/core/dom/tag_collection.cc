@@ -0,0 +1,20 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "tag_collection.h"
+#include "core/dom/element.h"
+
+namespace webf {
+
+TagCollection::TagCollection(ContainerNode* root_node, const AtomicString& qualified_name)
+    : HTMLCollection(root_node, kTagCollectionType),
+      match_all_(qualified_name == AtomicString(root_node->ctx(), "*")),
+      qualified_name_(qualified_name),
+      lowercase_qualified_name_(qualified_name.ToLowerIfNecessary()) {}
+
+bool TagCollection::ElementMatches(const Element& element) const {
+  return match_all_ || element.HasTagName(lowercase_qualified_name_) || element.HasTagName(qualified_name_);
+}
+
+}  // namespace webf
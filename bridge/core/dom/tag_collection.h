@@ -0,0 +1,27 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef BRIDGE_CORE_DOM_TAG_COLLECTION_H_
+#define BRIDGE_CORE_DOM_TAG_COLLECTION_H_
+
+#include "core/html/legacy/html_collection.h"
+
+namespace webf {
+
+// https://dom.spec.whatwg.org/#concept-getelementsbytagname
+class TagCollection final : public HTMLCollection {
+ public:
+  TagCollection(ContainerNode* root_node, const AtomicString& qualified_name);
+
+  bool ElementMatches(const Element&) const override;
+
+ private:
+  bool match_all_;
+  AtomicString qualified_name_;
+  AtomicString lowercase_qualified_name_;
+};
+
+}  // namespace webf
+
+#endif  // BRIDGE_CORE_DOM_TAG_COLLECTION_H_
@@ -30,8 +30,7 @@ std::string Text::nodeName() const {
 
 Node* Text::Clone(Document& document, CloneChildrenFlag flag) const {
   Node* copy = Create(document, data());
-  std::unique_ptr<NativeString> args_01 = stringToNativeString(std::to_string(copy->eventTargetId()));
-  GetExecutingContext()->uiCommandBuffer()->addCommand(eventTargetId(), UICommand::kCloneNode, std::move(args_01),
+  GetExecutingContext()->uiCommandBuffer()->addCommand(eventTargetId(), UICommand::kCloneNode, copy->eventTargetId(),
                                                        nullptr);
   return copy;
 }
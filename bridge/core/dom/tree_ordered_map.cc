@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "tree_ordered_map.h"
+#include "core/dom/element.h"
+#include "core/dom/element_traversal.h"
+#include "core/dom/tree_scope.h"
+#include "html_names.h"
+
+namespace webf {
+
+namespace {
+
+bool KeyMatchesId(const AtomicString& key, const Element& element) {
+  const AtomicString* id = element.FindAttribute(html_names::kIdAttr);
+  return id != nullptr && *id == key;
+}
+
+}  // namespace
+
+void TreeOrderedMap::Add(const AtomicString& key, Element& element) {
+  assert(!key.IsEmpty());
+  auto it = map_.find(key);
+  if (it == map_.end()) {
+    map_.emplace(key, MapEntry(element));
+    return;
+  }
+
+  MapEntry& entry = it->second;
+  assert(entry.count);
+  entry.element = nullptr;
+  entry.count++;
+}
+
+void TreeOrderedMap::Remove(const AtomicString& key, Element& element) {
+  assert(!key.IsEmpty());
+  auto it = map_.find(key);
+  if (it == map_.end())
+    return;
+
+  MapEntry& entry = it->second;
+  assert(entry.count);
+  if (entry.count == 1) {
+    assert(!entry.element || entry.element == &element);
+    map_.erase(it);
+  } else {
+    if (entry.element == &element)
+      entry.element = nullptr;
+    entry.count--;
+  }
+}
+
+bool TreeOrderedMap::ContainsMultiple(const AtomicString& key) const {
+  auto it = map_.find(key);
+  return it != map_.end() && it->second.count > 1;
+}
+
+Element* TreeOrderedMap::GetElementById(const AtomicString& key, const TreeScope& scope) const {
+  auto it = map_.find(key);
+  if (it == map_.end())
+    return nullptr;
+
+  MapEntry& entry = it->second;
+  assert(entry.count);
+  if (entry.element)
+    return entry.element;
+
+  // Several elements share the key, cache the first one in tree order until the entry changes again.
+  for (Element& element : ElementTraversal::DescendantsOf(scope.RootNode())) {
+    if (KeyMatchesId(key, element)) {
+      entry.element = &element;
+      return &element;
+    }
+  }
+
+  // The map is updated when an element is inserted or removed and when its id changes, it can not be stale.
+  assert(false);
+  return nullptr;
+}
+
+std::vector<Element*> TreeOrderedMap::GetAllElementsById(const AtomicString& key, const TreeScope& scope) const {
+  std::vector<Element*> elements;
+  auto it = map_.find(key);
+  if (it == map_.end())
+    return elements;
+
+  const MapEntry& entry = it->second;
+  if (entry.count == 1 && entry.element) {
+    elements.emplace_back(entry.element);
+    return elements;
+  }
+
+  elements.reserve(entry.count);
+  for (Element& element : ElementTraversal::DescendantsOf(scope.RootNode())) {
+    if (KeyMatchesId(key, element)) {
+      elements.emplace_back(&element);
+    }
+  }
+  assert(elements.size() == entry.count);
+  return elements;
+}
+
+}  // namespace webf
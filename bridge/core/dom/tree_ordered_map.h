@@ -0,0 +1,46 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef BRIDGE_CORE_DOM_TREE_ORDERED_MAP_H_
+#define BRIDGE_CORE_DOM_TREE_ORDERED_MAP_H_
+
+#include <unordered_map>
+#include <vector>
+#include "bindings/qjs/atomic_string.h"
+
+namespace webf {
+
+class Element;
+class TreeScope;
+
+// Maps a key (the id attribute) to the connected elements carrying it. Most keys are unique, so an entry keeps the
+// element directly and only counts duplicates, the first one in tree order is resolved lazily when asked for.
+//
+// Elements are removed from the map before they leave the tree, so the raw pointers never outlive their elements.
+class TreeOrderedMap {
+ public:
+  void Add(const AtomicString& key, Element& element);
+  void Remove(const AtomicString& key, Element& element);
+
+  bool Contains(const AtomicString& key) const { return map_.count(key) > 0; }
+  bool ContainsMultiple(const AtomicString& key) const;
+  // The first element with |key| in tree order under |scope|.
+  Element* GetElementById(const AtomicString& key, const TreeScope& scope) const;
+  // All the elements with |key| in tree order under |scope|.
+  std::vector<Element*> GetAllElementsById(const AtomicString& key, const TreeScope& scope) const;
+
+ private:
+  struct MapEntry {
+    explicit MapEntry(Element& first_element) : element(&first_element), count(1) {}
+    // nullptr when the entry has duplicates and the first one in tree order is not resolved yet.
+    Element* element;
+    unsigned count;
+  };
+
+  mutable std::unordered_map<AtomicString, MapEntry, AtomicString::KeyHasher> map_;
+};
+
+}  // namespace webf
+
+#endif  // BRIDGE_CORE_DOM_TREE_ORDERED_MAP_H_
@@ -5,6 +5,7 @@
 
 #include "tree_scope.h"
 #include "document.h"
+#include "tree_ordered_map.h"
 
 namespace webf {
 
@@ -12,4 +13,39 @@ TreeScope::TreeScope(Document& document) : root_node_(&document), document_(&doc
   root_node_->SetTreeScope(this);
 }
 
+TreeScope::~TreeScope() = default;
+
+Element* TreeScope::getElementById(const AtomicString& element_id) const {
+  if (element_id.IsEmpty() || !elements_by_id_)
+    return nullptr;
+  return elements_by_id_->GetElementById(element_id, *this);
+}
+
+std::vector<Element*> TreeScope::GetAllElementsById(const AtomicString& element_id) const {
+  if (element_id.IsEmpty() || !elements_by_id_)
+    return {};
+  return elements_by_id_->GetAllElementsById(element_id, *this);
+}
+
+bool TreeScope::HasElementWithId(const AtomicString& id) const {
+  assert(!id.IsEmpty());
+  return elements_by_id_ && elements_by_id_->Contains(id);
+}
+
+bool TreeScope::ContainsMultipleElementsWithId(const AtomicString& id) const {
+  return elements_by_id_ && elements_by_id_->ContainsMultiple(id);
+}
+
+void TreeScope::AddElementById(const AtomicString& element_id, Element& element) {
+  if (!elements_by_id_)
+    elements_by_id_ = std::make_unique<TreeOrderedMap>();
+  elements_by_id_->Add(element_id, element);
+}
+
+void TreeScope::RemoveElementById(const AtomicString& element_id, Element& element) {
+  if (!elements_by_id_)
+    return;
+  elements_by_id_->Remove(element_id, element);
+}
+
 }  // namespace webf
@@ -7,11 +7,16 @@
 #define BRIDGE_CORE_DOM_TREE_SCOPE_H_
 
 #include <cassert>
+#include <memory>
+#include <vector>
+#include "bindings/qjs/atomic_string.h"
 
 namespace webf {
 
 class ContainerNode;
 class Document;
+class Element;
+class TreeOrderedMap;
 
 // The root node of a document tree (in which case this is a Document) or of a
 // shadow tree (in which case this is a ShadowRoot). Various things, like
@@ -28,14 +33,26 @@ class TreeScope {
     assert(document_);
     return *document_;
   }
+  ContainerNode& RootNode() const { return *root_node_; }
+
+  // The first connected element in tree order whose id is |element_id|.
+  Element* getElementById(const AtomicString& element_id) const;
+  std::vector<Element*> GetAllElementsById(const AtomicString& element_id) const;
+  bool HasElementWithId(const AtomicString& id) const;
+  bool ContainsMultipleElementsWithId(const AtomicString& id) const;
+  // Called by Element when a connected element gains or loses an id.
+  void AddElementById(const AtomicString& element_id, Element& element);
+  void RemoveElementById(const AtomicString& element_id, Element& element);
 
  protected:
   explicit TreeScope(Document&);
+  ~TreeScope();
 
  private:
   ContainerNode* root_node_;
   Document* document_;
   TreeScope* parent_tree_scope_;
+  std::unique_ptr<TreeOrderedMap> elements_by_id_;
 };
 
 }  // namespace webf
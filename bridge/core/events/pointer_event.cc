@@ -3,6 +3,7 @@
  */
 
 #include "pointer_event.h"
+#include "event_type_names.h"
 #include "qjs_pointer_event.h"
 
 namespace webf {
@@ -90,8 +91,33 @@ double PointerEvent::width() const {
   return width_;
 };
 
+std::vector<PointerEvent*> PointerEvent::getCoalescedEvents(ExceptionState& exception_state) {
+  std::vector<PointerEvent*> coalesced_events;
+  if (type() != event_type_names::kpointermove)
+    return coalesced_events;
+
+  coalesced_events.reserve(coalesced_events_.size() + 1);
+  for (auto& coalesced_event : coalesced_events_) {
+    coalesced_events.emplace_back(coalesced_event.Get());
+  }
+  // The dispatched event carries the latest sample.
+  coalesced_events.emplace_back(this);
+  return coalesced_events;
+}
+
+void PointerEvent::SetCoalescedEvents(const std::vector<PointerEvent*>& coalesced_events) {
+  coalesced_events_.assign(coalesced_events.begin(), coalesced_events.end());
+}
+
 bool PointerEvent::IsPointerEvent() const {
   return true;
 }
 
+void PointerEvent::Trace(GCVisitor* visitor) const {
+  for (auto& coalesced_event : coalesced_events_) {
+    visitor->Trace(coalesced_event);
+  }
+  MouseEvent::Trace(visitor);
+}
+
 }  // namespace webf
\ No newline at end of file
@@ -13,5 +13,6 @@ interface PointerEvent extends MouseEvent {
     readonly tiltY: number;
     readonly twist: number;
     readonly width: number;
+    getCoalescedEvents(): PointerEvent[];
     new(type: string, init?: PointerEventInit): PointerEvent;
 }
\ No newline at end of file
@@ -44,9 +44,15 @@ class PointerEvent : public MouseEvent {
   double tiltY() const;
   double twist() const;
   double width() const;
+  std::vector<PointerEvent*> getCoalescedEvents(ExceptionState& exception_state);
+
+  // The pointer moves this one was dispatched in place of, oldest first.
+  void SetCoalescedEvents(const std::vector<PointerEvent*>& coalesced_events);
 
   bool IsPointerEvent() const override;
 
+  void Trace(GCVisitor* visitor) const override;
+
  private:
   double height_;
   bool is_primary;
@@ -58,6 +64,7 @@ class PointerEvent : public MouseEvent {
   double tilt_y_;
   double twist_;
   double width_;
+  std::vector<Member<PointerEvent>> coalesced_events_;
 };
 
 }  // namespace webf
@@ -61,6 +61,44 @@ TouchEvent::TouchEvent(ExecutingContext* context, const AtomicString& type, Nati
 {
 }
 
+static void ReinitializeTouchList(ExecutingContext* context,
+                                  Member<TouchList>& touch_list,
+                                  NativeTouchList* native_touch_list) {
+  // Script may still hold the list of an earlier dispatch, which must not change under it.
+  if (touch_list != nullptr && touch_list->HasOneReference()) {
+    touch_list->ReinitializeFromNative(context, native_touch_list);
+  } else {
+    touch_list = MakeGarbageCollected<TouchList>(context, native_touch_list);
+  }
+}
+
+bool TouchEvent::IsReusable() const {
+  return GetWrapperTypeInfo() == TouchEvent::GetStaticWrapperTypeInfo();
+}
+
+void TouchEvent::ReinitializeFromRawEvent(const AtomicString& type, RawEvent* raw_event) {
+  assert(raw_event->length == sizeof(NativeTouchEvent) / sizeof(int64_t));
+  auto* native_touch_event = toNativeEvent<NativeTouchEvent>(raw_event);
+  UIEvent::ReinitializeFromNative(type, &native_touch_event->native_event);
+  alt_key_ = native_touch_event->altKey;
+  ctrl_key_ = native_touch_event->ctrlKey;
+  meta_key_ = native_touch_event->metaKey;
+  shift_key_ = native_touch_event->shiftKey;
+
+  ExecutingContext* context = GetExecutingContext();
+#if ANDROID_32_BIT
+  ReinitializeTouchList(context, changed_touches_,
+                        reinterpret_cast<NativeTouchList*>(native_touch_event->changedTouches));
+  ReinitializeTouchList(context, target_touches_,
+                        reinterpret_cast<NativeTouchList*>(native_touch_event->targetTouches));
+  ReinitializeTouchList(context, touches_, reinterpret_cast<NativeTouchList*>(native_touch_event->touches));
+#else
+  ReinitializeTouchList(context, changed_touches_, static_cast<NativeTouchList*>(native_touch_event->changedTouches));
+  ReinitializeTouchList(context, target_touches_, static_cast<NativeTouchList*>(native_touch_event->targetTouches));
+  ReinitializeTouchList(context, touches_, static_cast<NativeTouchList*>(native_touch_event->touches));
+#endif
+}
+
 bool TouchEvent::altKey() const {
   return alt_key_;
 }
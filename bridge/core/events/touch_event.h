@@ -47,6 +47,9 @@ class TouchEvent : public UIEvent {
 
   bool IsTouchEvent() const override;
 
+  bool IsReusable() const override;
+  void ReinitializeFromRawEvent(const AtomicString& type, RawEvent* raw_event) override;
+
  private:
   bool alt_key_;
   bool ctrl_key_;
@@ -61,6 +61,17 @@ UIEvent::UIEvent(ExecutingContext* context, const AtomicString& type, NativeUIEv
       which_(native_ui_event->which) {
 }
 
+void UIEvent::ReinitializeFromNative(const AtomicString& type, NativeUIEvent* native_ui_event) {
+  Event::ReinitializeFromNative(type, &native_ui_event->native_event);
+  detail_ = native_ui_event->detail;
+#if ANDROID_32_BIT
+  view_ = DynamicTo<Window>(BindingObject::From(reinterpret_cast<NativeBindingObject*>(native_ui_event->view)));
+#else
+  view_ = DynamicTo<Window>(BindingObject::From(static_cast<NativeBindingObject*>(native_ui_event->view)));
+#endif
+  which_ = native_ui_event->which;
+}
+
 double UIEvent::detail() const {
   return detail_;
 }
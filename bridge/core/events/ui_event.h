@@ -59,6 +59,10 @@ class UIEvent : public Event {
 
   void Trace(GCVisitor* visitor) const override;
 
+ protected:
+  // Event::ReinitializeFromNative() together with the fields of UIEvent.
+  void ReinitializeFromNative(const AtomicString& type, NativeUIEvent* native_ui_event);
+
  private:
   double detail_;
   Member<Window> view_;
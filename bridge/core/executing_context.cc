@@ -8,6 +8,7 @@
 #include "bindings/qjs/converter_impl.h"
 #include "built_in_string.h"
 #include "core/dom/document.h"
+#include "core/dom/node_traversal.h"
 #include "core/events/error_event.h"
 #include "core/events/promise_rejection_event.h"
 #include "event_type_names.h"
@@ -98,6 +99,18 @@ ExecutingContext::~ExecutingContext() {
     assert_m(false, "Unhandled exception found when Dispose JSContext.");
   }
 
+  // The nodes which still have no JS object are only reachable from the document tree. Create their JS objects, so
+  // that the objects are freed with the tree.
+  if (!deferred_wrappers_.empty() && document_ != nullptr) {
+    for (Node& node : NodeTraversal::InclusiveDescendantsOf(*document_)) {
+      node.EnsureWrapper();
+    }
+  }
+
+  // The moves waiting for the next frame are never dispatched.
+  event_coalescer_.Clear();
+  event_pool_.Clear();
+
   JS_FreeValue(script_state_.ctx(), global_object_);
 
   // Free active wrappers.
@@ -302,9 +315,17 @@ static void DispatchPromiseRejectionEvent(const AtomicString& event_type,
 }
 
 void ExecutingContext::FlushUICommand() {
-  if (!uiCommandBuffer()->empty()) {
-    dartMethodPtr()->flushUICommand(context_id_);
-  }
+  if (uiCommandBuffer()->empty())
+    return;
+
+  // Only called when a binding needs dart side to be up to date.
+  uiCommandBuffer()->setFlushReason(UICommandFlushReason::kSyncBinding);
+
+  // The consumer thread applies published segments by itself, dart side takes what could not be published.
+  if (uiCommandBuffer()->publishingEnabled() && uiCommandBuffer()->publish())
+    return;
+
+  dartMethodPtr()->flushUICommand(context_id_);
 }
 
 void ExecutingContext::DispatchErrorEvent(ErrorEvent* error_event) {
@@ -15,6 +15,7 @@
 #include <memory>
 #include <mutex>
 #include <unordered_map>
+#include <unordered_set>
 #include "bindings/qjs/binding_initializer.h"
 #include "bindings/qjs/rejected_promises.h"
 #include "bindings/qjs/script_value.h"
@@ -22,6 +23,8 @@
 #include "foundation/ui_command_buffer.h"
 
 #include "dart_methods.h"
+#include "dom/events/event_coalescer.h"
+#include "dom/events/event_pool.h"
 #include "executing_context_data.h"
 #include "frame/dom_timer_coordinator.h"
 #include "frame/module_context_coordinator.h"
@@ -108,10 +111,20 @@ class ExecutingContext {
   MemberMutationScope* mutationScope() const { return active_mutation_scope; }
   void ClearMutationScope();
 
+  // Whether the JS objects of newly created nodes are created lazily, see DeferredWrapperScope.
+  bool IsDeferringWrappers() const { return deferring_wrappers_; }
+  void SetDeferringWrappers(bool deferring) { deferring_wrappers_ = deferring; }
+  void DidDeferWrapper(const ScriptWrappable* wrappable) { deferred_wrappers_.insert(wrappable); }
+  void DidCreateDeferredWrapper(const ScriptWrappable* wrappable) { deferred_wrappers_.erase(wrappable); }
+  // Looks the pointer up without reading the object, so it is safe to call with objects the GC may have freed.
+  bool IsDeferredWrapper(const ScriptWrappable* wrappable) const { return deferred_wrappers_.count(wrappable) > 0; }
+
   FORCE_INLINE Document* document() const { return document_; };
   FORCE_INLINE Window* window() const { return window_; }
   FORCE_INLINE Performance* performance() const { return performance_; }
   FORCE_INLINE UICommandBuffer* uiCommandBuffer() { return &ui_command_buffer_; };
+  FORCE_INLINE EventCoalescer* eventCoalescer() { return &event_coalescer_; }
+  FORCE_INLINE EventPool* eventPool() { return &event_pool_; }
   FORCE_INLINE const std::unique_ptr<DartMethodPointer>& dartMethodPtr() { return dart_method_ptr_; }
   FORCE_INLINE std::chrono::time_point<std::chrono::system_clock> timeOrigin() const { return time_origin_; }
 
@@ -148,6 +161,8 @@ class ExecutingContext {
   // Members first initialized and destructed at the last.
   // Dart methods ptr should keep alive when ExecutingContext is disposing.
   const std::unique_ptr<DartMethodPointer> dart_method_ptr_ = nullptr;
+  // Members destroyed while ScriptState frees the JSContext still look up their pointees here.
+  std::unordered_set<const ScriptWrappable*> deferred_wrappers_;
   // Keep uiCommandBuffer below dartMethod ptr to make sure we can flush all disposeEventTarget when UICommandBuffer
   // release.
   UICommandBuffer ui_command_buffer_{this};
@@ -172,11 +187,14 @@ class ExecutingContext {
   DOMTimerCoordinator timers_;
   ModuleListenerContainer module_listener_container_;
   ModuleContextCoordinator module_contexts_;
+  EventCoalescer event_coalescer_{this};
+  EventPool event_pool_{this};
   ExecutionContextData context_data_{this};
   bool in_dispatch_error_event_{false};
   RejectedPromises rejected_promises_;
   MemberMutationScope* active_mutation_scope{nullptr};
   std::vector<ScriptWrappable*> active_wrappers_;
+  bool deferring_wrappers_{false};
 };
 
 class ObjectProperty {
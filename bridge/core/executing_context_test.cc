@@ -278,7 +278,7 @@ TEST(Context, accessGetUICommandItemsAfterDisposed) {
     contextId = bridge->GetExecutingContext()->contextId();
   }
 
-  EXPECT_EQ(getUICommandItems(contextId), nullptr);
+  EXPECT_EQ(getUICommandItems(contextId, 0), nullptr);
 }
 
 TEST(Context, disposeContext) {
@@ -140,6 +140,14 @@ bool Window::IsWindowOrWorkerGlobalScope() const {
   return true;
 }
 
+void Window::ListenerTypesChanged() {
+  EventTarget::ListenerTypesChanged();
+  // The window ends the event path of every node in the document.
+  if (Document* document = GetExecutingContext()->document()) {
+    document->UpdateEventPathListenerTypes();
+  }
+}
+
 void Window::Trace(GCVisitor* visitor) const {
   visitor->Trace(screen_);
   EventTargetWithInlineData::Trace(visitor);
@@ -52,6 +52,9 @@ class Window : public EventTargetWithInlineData {
   // Override default ToQuickJS() to return Global object when access `window` property.
   JSValue ToQuickJS() const override;
 
+ protected:
+  void ListenerTypesChanged() override;
+
  private:
   Member<Screen> screen_;
 };
@@ -137,3 +137,20 @@ TEST(Window, onloadShouldExist) {
   bridge->evaluateScript(code.c_str(), code.size(), "vm://", 0);
   EXPECT_EQ(errorCalled, false);
 }
+
+TEST(Window, layoutIndependentPropertiesDoNotFlush) {
+  auto bridge = TEST_init();
+  auto context = bridge->GetExecutingContext();
+  context->FlushUICommand();
+
+  // Dart side isn't attached in unit tests, binding calls throw after deciding whether to flush.
+  const char* code =
+      "let div = document.createElement('div');"
+      "try { window.devicePixelRatio; } catch(e) {}";
+  bridge->evaluateScript(code, strlen(code), "vm://", 0);
+  EXPECT_EQ(context->uiCommandBuffer()->empty(), false);
+
+  const char* layout_code = "try { window.scrollX; } catch(e) {}";
+  bridge->evaluateScript(layout_code, strlen(layout_code), "vm://", 0);
+  EXPECT_EQ(context->uiCommandBuffer()->empty(), true);
+}
@@ -4,10 +4,10 @@ import {GlobalEventHandlers} from "../dom/global_event_handlers";
 export interface HTMLElement extends Element, GlobalEventHandlers {
   // CSSOM View Module
   // https://drafts.csswg.org/cssom-view/#extensions-to-the-htmlelement-interface
-  readonly offsetTop: DartImpl<double>;
-  readonly offsetLeft: DartImpl<double>;
-  readonly offsetWidth: DartImpl<double>;
-  readonly offsetHeight: DartImpl<double>;
+  readonly offsetTop: double;
+  readonly offsetLeft: double;
+  readonly offsetWidth: double;
+  readonly offsetHeight: double;
 
   click(): DartImpl<void>;
 
@@ -18,6 +18,11 @@ class HTMLElement : public Element {
   using ImplType = HTMLElement*;
   HTMLElement(const AtomicString& tag_name, Document* document, ConstructionType);
 
+  double offsetTop() { return GetGeometry(ElementGeometryProperty::kOffsetTop); }
+  double offsetLeft() { return GetGeometry(ElementGeometryProperty::kOffsetLeft); }
+  double offsetWidth() { return GetGeometry(ElementGeometryProperty::kOffsetWidth); }
+  double offsetHeight() { return GetGeometry(ElementGeometryProperty::kOffsetHeight); }
+
   bool IsAttributeDefinedInternal(const AtomicString& key) const override;
 
  private:
@@ -4,54 +4,97 @@
  */
 
 #include "html_collection.h"
+#include <algorithm>
+#include <cctype>
 #include "bindings/qjs/cppgc/gc_visitor.h"
 #include "core/dom/container_node.h"
 
 namespace webf {
 
-HTMLCollection::HTMLCollection(ContainerNode* base, CollectionType type)
-    : base_(base), type_(type), ScriptWrappable(base->ctx()) {}
+HTMLCollection::HTMLCollection(ContainerNode* base,
+                               CollectionType type,
+                               NodeListInvalidationType invalidation_type)
+    : ScriptWrappable(base->ctx()),
+      LiveNodeListBase(base,
+                       type == CollectionType::kDocAll ? NodeListSearchRoot::kTreeScope
+                                                       : NodeListSearchRoot::kOwnerNode,
+                       invalidation_type,
+                       type),
+      cached_dom_tree_version_(base->GetDocument().DomTreeVersion()),
+      cached_invalidation_version_(base->GetDocument().NodeListInvalidationVersion(invalidation_type)) {}
 
 unsigned int HTMLCollection::length() const {
-  int32_t length = 0;
-
-  if (type_ == CollectionType::kDocAll) {
-    auto* document = DynamicTo<Document>(*base_);
-    for (const Node& child : NodeTraversal::InclusiveDescendantsOf(*document->documentElement())) {
-      length++;
-    }
-  }
-
-  return length;
+  InvalidateCacheIfNeeded();
+  return collection_items_cache_.NodeCount(*this);
 }
 
 Element* HTMLCollection::item(unsigned int offset, ExceptionState& exception_state) const {
-  if (type_ == CollectionType::kDocAll) {
-    int32_t i = 0;
-    auto* document = DynamicTo<Document>(*base_);
-    for (Node& child : ElementTraversal ::InclusiveDescendantsOf(*document->documentElement())) {
-      if (i == offset) {
-        return DynamicTo<Element>(child);
-      }
-      i++;
-    }
-  }
-
-  return nullptr;
+  InvalidateCacheIfNeeded();
+  return collection_items_cache_.NodeAt(*this, offset);
 }
 
-bool HTMLCollection::NamedPropertyQuery(const AtomicString& key, ExceptionState&) {
-  int32_t index = std::stoi(key.ToStdString());
-  return index >= 0 && index < nodes_.size();
+bool HTMLCollection::NamedPropertyQuery(const AtomicString& key, ExceptionState& exception_state) {
+  std::string string = key.ToStdString();
+  if (string.empty() || !std::all_of(string.begin(), string.end(), ::isdigit))
+    return false;
+  return item(std::stoul(string), exception_state) != nullptr;
 }
 
 void HTMLCollection::NamedPropertyEnumerator(std::vector<AtomicString>& names, ExceptionState&) {
+  unsigned size = length();
   names.emplace_back(AtomicString(ctx(), "length"));
-  for (int i = 0; i < nodes_.size(); i++) {
+  for (unsigned i = 0; i < size; i++) {
     names.emplace_back(AtomicString(ctx(), std::to_string(i)));
   }
 }
 
-void HTMLCollection::Trace(GCVisitor* visitor) const {}
+bool HTMLCollection::ElementMatches(const Element& element) const {
+  // document.all matches every element, named collections override this.
+  return true;
+}
+
+void HTMLCollection::InvalidateCache(Document* old_document) const {
+  collection_items_cache_.Invalidate();
+}
+
+void HTMLCollection::InvalidateCacheIfNeeded() const {
+  Document& document = GetDocument();
+  uint64_t dom_tree_version = document.DomTreeVersion();
+  uint64_t invalidation_version = document.NodeListInvalidationVersion(InvalidationType());
+  if (dom_tree_version == cached_dom_tree_version_ && invalidation_version == cached_invalidation_version_)
+    return;
+
+  InvalidateCache();
+  cached_dom_tree_version_ = dom_tree_version;
+  cached_invalidation_version_ = invalidation_version;
+}
+
+Element* HTMLCollection::TraverseToFirst() const {
+  return ElementTraversal::FirstWithin(RootNode(), [this](const Element& element) { return ElementMatches(element); });
+}
+
+Element* HTMLCollection::TraverseToLast() const {
+  return ElementTraversal::LastWithin(RootNode(), [this](const Element& element) { return ElementMatches(element); });
+}
+
+Element* HTMLCollection::TraverseForwardToOffset(unsigned offset,
+                                                 Element& current_element,
+                                                 unsigned& current_offset) const {
+  return TraverseMatchingElementsForwardToOffset(current_element, &RootNode(), offset, current_offset,
+                                                 [this](const Element& element) { return ElementMatches(element); });
+}
+
+Element* HTMLCollection::TraverseBackwardToOffset(unsigned offset,
+                                                  Element& current_element,
+                                                  unsigned& current_offset) const {
+  return TraverseMatchingElementsBackwardToOffset(current_element, &RootNode(), offset, current_offset,
+                                                  [this](const Element& element) { return ElementMatches(element); });
+}
+
+void HTMLCollection::Trace(GCVisitor* visitor) const {
+  collection_items_cache_.Trace(visitor);
+  LiveNodeListBase::Trace(visitor);
+  ScriptWrappable::Trace(visitor);
+}
 
 }  // namespace webf
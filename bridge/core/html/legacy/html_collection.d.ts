@@ -0,0 +1,8 @@
+import {Element} from "../../dom/element";
+
+interface HTMLCollection {
+  readonly length: int64;
+  item(index: double): Element | null;
+  readonly [key: number]: Element | null;
+  new(): void;
+}
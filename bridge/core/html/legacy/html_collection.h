@@ -1,17 +1,28 @@
+/*
+ * Copyright (C) 2019-2022 The Kraken authors. All rights reserved.
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
 #ifndef BRIDGE_CORE_HTML_HTML_COLLECTION_H_
 #define BRIDGE_CORE_HTML_HTML_COLLECTION_H_
 
-#include "bindings/qjs/heap_hashmap.h"
-#include "bindings/qjs/heap_vector.h"
 #include "bindings/qjs/script_wrappable.h"
-#include "core/dom/collection_items_cache.h"
+#include "core/dom/collection_index_cache.h"
 #include "core/dom/live_node_list_base.h"
 
 namespace webf {
 
-class HTMLCollection : public ScriptWrappable {
+// A live collection of the elements under its root. The position of the last visited element and the length are
+// cached, so walking the collection by index is linear in total, and the caches are dropped lazily when the document
+// reports a mutation which may change the matched elements.
+class HTMLCollection : public ScriptWrappable, public LiveNodeListBase {
+  DEFINE_WRAPPERTYPEINFO();
+
  public:
-  HTMLCollection(ContainerNode* base, CollectionType);
+  using ImplType = HTMLCollection*;
+
+  HTMLCollection(ContainerNode* base,
+                 CollectionType type,
+                 NodeListInvalidationType invalidation_type = kDoNotInvalidateOnAttributeChanges);
 
   // DOM API
   unsigned length() const;
@@ -19,12 +30,25 @@ class HTMLCollection : public ScriptWrappable {
   bool NamedPropertyQuery(const AtomicString&, ExceptionState&);
   void NamedPropertyEnumerator(std::vector<AtomicString>& names, ExceptionState&);
 
+  // Non-DOM API
+  virtual bool ElementMatches(const Element&) const;
+  void InvalidateCache(Document* old_document = nullptr) const override;
+
+  // CollectionIndexCache API.
+  bool CanTraverseBackward() const { return true; }
+  Element* TraverseToFirst() const;
+  Element* TraverseToLast() const;
+  Element* TraverseForwardToOffset(unsigned offset, Element& current_element, unsigned& current_offset) const;
+  Element* TraverseBackwardToOffset(unsigned offset, Element& current_element, unsigned& current_offset) const;
+
   void Trace(GCVisitor*) const override;
 
  private:
-  CollectionType type_;
-  ContainerNode* base_;
-  std::vector<Element> nodes_;
+  void InvalidateCacheIfNeeded() const;
+
+  mutable CollectionIndexCache<HTMLCollection, Element> collection_items_cache_;
+  mutable uint64_t cached_dom_tree_version_;
+  mutable uint64_t cached_invalidation_version_;
 };
 
 }  // namespace webf
@@ -31,3 +31,41 @@ TEST(HTMLCollection, children) {
 
   EXPECT_EQ(errorCalled, false);
 }
+
+TEST(HTMLCollection, liveClassAndTagCollections) {
+  bool static errorCalled = false;
+  bool static logCalled = false;
+  webf::WebFPage::consoleMessageHandler = [](void* ctx, const std::string& message, int logLevel) {
+    EXPECT_STREQ(message.c_str(), "0 2 3 true 2 1 4 3 1 b");
+    logCalled = true;
+  };
+  auto bridge = TEST_init([](int32_t contextId, const char* errmsg) {
+    WEBF_LOG(VERBOSE) << errmsg;
+    errorCalled = true;
+  });
+  const char* code =
+      "let container = document.createElement('div');"
+      "document.body.appendChild(container);"
+      "let items = container.getElementsByClassName('item');"
+      "let paragraphs = document.body.getElementsByTagName('P');"
+      "let result = [items.length];"
+      "for (let i = 0; i < 3; i++) {"
+      "  let p = document.createElement('p');"
+      "  p.id = String.fromCharCode(97 + i);"
+      "  if (i != 1) p.className = 'item';"
+      "  container.appendChild(p);"
+      "}"
+      "result.push(items.length, paragraphs.length, items[1] === document.getElementById('c'));"
+      "container.lastChild.className = 'other';"
+      "container.childNodes[1].className = 'item';"
+      "result.push(items.length, items[1] === container.childNodes[1] ? 1 : 0);"
+      "container.appendChild(document.createElement('p'));"
+      "result.push(paragraphs.length);"
+      "container.removeChild(container.firstChild);"
+      "result.push(paragraphs.length, items.length, items[0].id);"
+      "console.log(result.join(' '));";
+  bridge->evaluateScript(code, strlen(code), "vm://", 0);
+
+  EXPECT_EQ(errorCalled, false);
+  EXPECT_EQ(logCalled, true);
+}
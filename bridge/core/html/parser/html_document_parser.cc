@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "html_document_parser.h"
+#include <algorithm>
+#include <cstring>
+#include "core/dom/element.h"
+
+namespace webf {
+
+HTMLDocumentParser::HTMLDocumentParser(Element* document_element)
+    : gumbo_parser_(gumbo_incremental_parser_create(&kGumboDefaultOptions)), reader_(document_element) {}
+
+HTMLDocumentParser::~HTMLDocumentParser() {
+  if (gumbo_parser_ != nullptr) {
+    gumbo_destroy_output(&kGumboDefaultOptions, gumbo_incremental_parser_finish(gumbo_parser_));
+  }
+}
+
+void HTMLDocumentParser::AppendChunk(const char* data, size_t length) {
+  assert(gumbo_parser_ != nullptr);
+  EnsureCapacity(length_ + length);
+  char* buffer = buffers_.back().get();
+  memcpy(buffer + length_, data, length);
+  length_ += length;
+
+  // The tokenizer can not look ahead past the end of its input, stop after the last complete tag and keep the rest
+  // for the next chunk.
+  size_t parsable = length_;
+  while (parsable > 0 && buffer[parsable - 1] != '>') {
+    parsable--;
+  }
+  if (parsable == 0)
+    return;
+
+  gumbo_incremental_parser_feed(gumbo_parser_, buffer, parsable);
+  UpdateTree(gumbo_incremental_parser_output(gumbo_parser_), gumbo_incremental_parser_open_elements(gumbo_parser_));
+}
+
+void HTMLDocumentParser::Finish() {
+  assert(gumbo_parser_ != nullptr);
+  if (length_ > 0) {
+    gumbo_incremental_parser_feed(gumbo_parser_, buffers_.back().get(), length_);
+  }
+  GumboOutput* output = gumbo_incremental_parser_finish(gumbo_parser_);
+  gumbo_parser_ = nullptr;
+
+  GumboVector no_open_elements = kGumboEmptyVector;
+  UpdateTree(output, &no_open_elements);
+  gumbo_destroy_output(&kGumboDefaultOptions, output);
+  buffers_.clear();
+}
+
+void HTMLDocumentParser::EnsureCapacity(size_t length) {
+  if (length <= capacity_)
+    return;
+
+  size_t capacity = std::max(length, capacity_ * 2);
+  auto buffer = std::make_unique<char[]>(capacity);
+  if (length_ > 0) {
+    memcpy(buffer.get(), buffers_.back().get(), length_);
+  }
+  buffers_.emplace_back(std::move(buffer));
+  capacity_ = capacity;
+}
+
+void HTMLDocumentParser::UpdateTree(const GumboOutput* output, const GumboVector* open_elements) {
+  HTMLNodeStream stream;
+  writer_.Update(output->root, open_elements, stream);
+  reader_.Apply(stream);
+}
+
+}  // namespace webf
@@ -0,0 +1,52 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef BRIDGE_CORE_HTML_PARSER_HTML_DOCUMENT_PARSER_H_
+#define BRIDGE_CORE_HTML_PARSER_HTML_DOCUMENT_PARSER_H_
+
+#include <third_party/gumbo-parser/src/gumbo.h>
+#include <memory>
+#include <vector>
+#include "html_node_stream.h"
+#include "html_node_stream_reader.h"
+
+namespace webf {
+
+class Element;
+
+// Parses a document which arrives in chunks, see parseHTMLChunk and finishParseHTML in webf_bridge.h.
+//
+// Every chunk is handed to an incremental gumbo parse, which stops at the last '>' received so far. The DOM is then
+// brought up to date with the gumbo tree through an HTMLNodeStream: an element which is still open is attached empty,
+// so that its children can follow, and a node which is already closed is built as a complete subtree and attached in
+// one insertion. Inline scripts run as soon as their element closes, before the nodes which follow them are attached.
+class HTMLDocumentParser {
+ public:
+  // The parsed head and body replace the children of |document_element|.
+  explicit HTMLDocumentParser(Element* document_element);
+  ~HTMLDocumentParser();
+
+  void AppendChunk(const char* data, size_t length);
+  // Parses the rest of the input as the end of the document. The parser can not be used after this.
+  void Finish();
+
+ private:
+  void EnsureCapacity(size_t length);
+  void UpdateTree(const GumboOutput* output, const GumboVector* open_elements);
+
+  GumboIncrementalParser* gumbo_parser_;
+
+  // The input is kept contiguous for gumbo. When it outgrows its buffer, the old buffer is kept alive as the nodes
+  // parsed from it still point into it.
+  std::vector<std::unique_ptr<char[]>> buffers_;
+  size_t length_{0};
+  size_t capacity_{0};
+
+  HTMLNodeStreamWriter writer_;
+  HTMLNodeStreamReader reader_;
+};
+
+}  // namespace webf
+
+#endif  // BRIDGE_CORE_HTML_PARSER_HTML_DOCUMENT_PARSER_H_
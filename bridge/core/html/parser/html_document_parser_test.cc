@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include <third_party/gumbo-parser/src/gumbo.h>
+#include "gtest/gtest.h"
+#include "webf_test_env.h"
+
+using namespace webf;
+
+TEST(HTMLDocumentParser, attachesNodesAsChunksArrive) {
+  bool static errorCalled = false;
+  bool static logCalled = false;
+  webf::WebFPage::consoleMessageHandler = [](void* ctx, const std::string& message, int logLevel) {
+    logCalled = true;
+    EXPECT_STREQ(message.c_str(), "2 first null");
+  };
+  auto bridge = TEST_init([](int32_t contextId, const char* errmsg) {
+    WEBF_LOG(VERBOSE) << errmsg;
+    errorCalled = true;
+  });
+  auto context = bridge->GetExecutingContext();
+
+  std::string chunk = "<html><head></head><body><div id=\"a\">first</div><scr";
+  bridge->parseHTMLChunk(chunk.c_str(), chunk.size());
+  ASSERT_NE(context->document()->body(), nullptr);
+  EXPECT_EQ(context->document()->body()->innerHTML(), "<div id=\"a\">first</div>");
+
+  // The script runs once it is closed, before the paragraph after it is attached.
+  chunk =
+      "ipt>console.log(document.body.childNodes.length, document.getElementById('a').textContent, "
+      "document.getElementById('b'))</script><p id=\"b\">sec";
+  bridge->parseHTMLChunk(chunk.c_str(), chunk.size());
+  EXPECT_EQ(logCalled, true);
+
+  chunk = "ond</p></body></html>";
+  bridge->parseHTMLChunk(chunk.c_str(), chunk.size());
+  bridge->finishParseHTML();
+  EXPECT_EQ(context->document()->body()->lastChild()->textContent().ToStdString(), "second");
+  EXPECT_EQ(errorCalled, false);
+}
+
+TEST(HTMLDocumentParser, matchesParseHTML) {
+  bool static errorCalled = false;
+  webf::WebFPage::consoleMessageHandler = [](void* ctx, const std::string& message, int logLevel) {};
+  auto error_handler = [](int32_t contextId, const char* errmsg) {
+    WEBF_LOG(VERBOSE) << errmsg;
+    errorCalled = true;
+  };
+  // Misnested formatting elements and foster parented table content move nodes after they were inserted.
+  std::string html =
+      "<html><body><p>one<b>bold<p>two</b>three</p><table><tr><td>cell</td></tr>stray</table>"
+      "<div title=\"a>b\">x &amp; y<!-- note --></div><ul><li>1<li>2</ul></body></html>";
+
+  auto whole = TEST_init(error_handler);
+  whole->parseHTML(html.c_str(), html.size());
+
+  auto streamed = TEST_init(error_handler);
+  for (size_t i = 0; i < html.size(); i += 7) {
+    streamed->parseHTMLChunk(html.c_str() + i, std::min<size_t>(7, html.size() - i));
+  }
+  streamed->finishParseHTML();
+
+  EXPECT_EQ(streamed->GetExecutingContext()->document()->body()->innerHTML(),
+            whole->GetExecutingContext()->document()->body()->innerHTML());
+  EXPECT_EQ(errorCalled, false);
+}
+
+static void DumpGumboPosition(const GumboSourcePosition& position, std::string& out) {
+  out += "@" + std::to_string(position.offset) + ":" + std::to_string(position.line) + ":" +
+         std::to_string(position.column);
+}
+
+// The text, original text and positions of every node, which must not depend on where the input was split.
+static void DumpGumboNode(const GumboNode* node, std::string& out) {
+  if (node->type == GUMBO_NODE_ELEMENT) {
+    out += "<" + std::to_string(node->v.element.tag) + " " + std::to_string(node->v.element.original_tag.length);
+    DumpGumboPosition(node->v.element.start_pos, out);
+    for (unsigned i = 0; i < node->v.element.attributes.length; i++) {
+      auto* attribute = static_cast<const GumboAttribute*>(node->v.element.attributes.data[i]);
+      out += std::string(" ") + attribute->name + "=" + attribute->value + " " +
+             std::to_string(attribute->original_value.length);
+      DumpGumboPosition(attribute->value_start, out);
+    }
+    out += ">";
+    for (unsigned i = 0; i < node->v.element.children.length; i++) {
+      DumpGumboNode(static_cast<const GumboNode*>(node->v.element.children.data[i]), out);
+    }
+  } else if (node->type != GUMBO_NODE_DOCUMENT) {
+    out += "[" + std::string(node->v.text.text) + " " + std::to_string(node->v.text.original_text.length);
+    DumpGumboPosition(node->v.text.start_pos, out);
+    out += "]";
+  }
+}
+
+TEST(HTMLDocumentParser, chunkBoundariesDoNotChangeSourcePositions) {
+  // CRLF pairs in text, in an attribute value and in a comment, and multi-byte characters.
+  std::string html =
+      "<html><body><p title=\"a\r\nb\">x\r\ny\r\n</p>\r\n<!--c\r\nd--><div>\xE4\xB8\xAD\r\n\xF0\x9F\x98\x80</div>"
+      "</body></html>";
+
+  GumboOutput* whole = gumbo_parse_with_options(&kGumboDefaultOptions, html.data(), html.size());
+  std::string expected;
+  DumpGumboNode(whole->root, expected);
+  gumbo_destroy_output(&kGumboDefaultOptions, whole);
+
+  for (size_t split = 1; split < html.size(); split++) {
+    // Split before and after each carriage return, and inside each multi-byte character.
+    bool at_cr = html[split - 1] == '\r' || html[split] == '\r';
+    bool in_character = (static_cast<unsigned char>(html[split]) & 0xc0) == 0x80;
+    if (!at_cr && !in_character)
+      continue;
+    GumboIncrementalParser* parser = gumbo_incremental_parser_create(&kGumboDefaultOptions);
+    gumbo_incremental_parser_feed(parser, html.data(), split);
+    gumbo_incremental_parser_feed(parser, html.data(), html.size());
+    GumboOutput* output = gumbo_incremental_parser_finish(parser);
+    std::string dump;
+    DumpGumboNode(output->root, dump);
+    gumbo_destroy_output(&kGumboDefaultOptions, output);
+    EXPECT_EQ(dump, expected) << "split at " << split;
+  }
+}
@@ -0,0 +1,206 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "html_fragment_template.h"
+#include <atomic>
+#include "core/dom/comment.h"
+#include "core/dom/document.h"
+#include "core/dom/element.h"
+#include "core/dom/text.h"
+#include "core/executing_context.h"
+#include "core/html/custom/widget_element.h"
+#include "html_parser.h"
+
+namespace webf {
+
+namespace {
+
+constexpr size_t kMaximumFragmentTemplateCacheSize = 64;
+constexpr size_t kMaximumCachedMarkupLength = 16 * 1024;
+
+std::atomic<int64_t> next_fragment_template_id{0};
+
+}  // namespace
+
+HTMLFragmentTemplate::HTMLFragmentTemplate() : id_(next_fragment_template_id++) {}
+
+std::unique_ptr<HTMLFragmentTemplate> HTMLFragmentTemplate::Compile(JSContext* ctx, GumboNode* root) {
+  std::unique_ptr<HTMLFragmentTemplate> fragment_template(new HTMLFragmentTemplate());
+  if (!fragment_template->CompileGumboChildren(ctx, root, kNoParent))
+    return nullptr;
+  fragment_template->Describe();
+  return fragment_template;
+}
+
+Node* HTMLFragmentTemplate::Instantiate(Document& document, ContainerNode* parent) {
+  UICommandBuffer* command_buffer = document.GetExecutingContext()->uiCommandBuffer();
+  std::vector<Node*> nodes;
+  nodes.reserve(nodes_.size());
+  std::vector<UICommandFragmentNode> command_nodes;
+  command_nodes.reserve(nodes_.size());
+
+  command_buffer->beginFragmentInstantiation();
+  uint32_t attribute_begin = 0;
+  uint32_t style_begin = 0;
+  for (const TemplateNode& template_node : nodes_) {
+    Node* node = nullptr;
+    command_buffer->expectInstantiatedTarget();
+    switch (template_node.type) {
+      case NodeType::kElement: {
+        Element* element = document.createElement(template_node.name, ASSERT_NO_EXCEPTION());
+        for (uint32_t i = attribute_begin; i < template_node.attribute_end; i++) {
+          element->setAttribute(attributes_[i].first, attributes_[i].second, ASSERT_NO_EXCEPTION());
+        }
+        if (style_begin < template_node.style_end) {
+          CSSStyleDeclaration* style = element->style();
+          for (uint32_t i = style_begin; i < template_node.style_end; i++) {
+            style->setProperty(styles_[i].first, styles_[i].second, ASSERT_NO_EXCEPTION());
+          }
+        }
+        node = element;
+        break;
+      }
+      case NodeType::kText:
+        node = document.createTextNode(template_node.name, ASSERT_NO_EXCEPTION());
+        break;
+      case NodeType::kComment:
+        node = document.createComment(template_node.name, ASSERT_NO_EXCEPTION());
+        break;
+    }
+    attribute_begin = template_node.attribute_end;
+    style_begin = template_node.style_end;
+
+    ContainerNode* node_parent =
+        template_node.parent == kNoParent ? parent : To<ContainerNode>(nodes[template_node.parent]);
+    if (node_parent != nullptr) {
+      node_parent->AppendChild(node);
+    }
+    nodes.emplace_back(node);
+    command_nodes.emplace_back(UICommandFragmentNode{node->eventTargetId(), node->bindingObject()});
+  }
+  command_buffer->endFragmentInstantiation();
+
+  command_buffer->addInstantiateFragmentCommand(parent != nullptr ? parent->eventTargetId() : -1, id_,
+                                                described_ ? nullptr : &description_, command_nodes);
+  described_ = true;
+  return nodes.empty() ? nullptr : nodes[0];
+}
+
+void HTMLFragmentTemplate::AddNode(NodeType type, uint32_t parent, const AtomicString& name) {
+  nodes_.emplace_back(TemplateNode{type, parent, name, static_cast<uint32_t>(attributes_.size()),
+                                   static_cast<uint32_t>(styles_.size())});
+}
+
+bool HTMLFragmentTemplate::CompileGumboChildren(JSContext* ctx, GumboNode* node, uint32_t parent) {
+  const GumboVector* children = &node->v.element.children;
+  for (unsigned i = 0; i < children->length; i++) {
+    auto* child = static_cast<GumboNode*>(children->data[i]);
+    if (child->type == GUMBO_NODE_ELEMENT) {
+      // Widget elements are created by dart side on their own, names createElement refuses have no element at all.
+      AtomicString tag_name(ctx, tagNameOf(child));
+      if (!Document::IsValidName(tag_name) || WidgetElement::IsValidName(tag_name))
+        return false;
+      // Inline scripts run each time the markup is set, see HTMLParser::parseHTMLFragment.
+      if (child->v.element.tag == GUMBO_TAG_SCRIPT)
+        return false;
+
+      // Split the same way as HTMLParser::parseAttribute.
+      const GumboVector* attributes = &child->v.element.attributes;
+      for (unsigned j = 0; j < attributes->length; j++) {
+        auto* attribute = static_cast<GumboAttribute*>(attributes->data[j]);
+        std::string_view name = attribute->name;
+        if (name == "style") {
+          forEachStyleDeclaration(attribute->value, [this, ctx](std::string_view style_name,
+                                                                std::string_view style_value) {
+            styles_.emplace_back(AtomicString(ctx, CSSStyleDeclaration::CamelCasePropertyName(std::string(style_name))),
+                                 AtomicString(ctx, style_value));
+          });
+        } else {
+          attributes_.emplace_back(AtomicString(ctx, name), AtomicString(ctx, attribute->value));
+        }
+      }
+
+      auto index = static_cast<uint32_t>(nodes_.size());
+      AddNode(NodeType::kElement, parent, tag_name);
+      if (!CompileGumboChildren(ctx, child, index))
+        return false;
+    } else if (child->type == GUMBO_NODE_TEXT) {
+      AddNode(NodeType::kText, parent, AtomicString(ctx, child->v.text.text));
+    } else if (child->type == GUMBO_NODE_COMMENT) {
+      AddNode(NodeType::kComment, parent, AtomicString(ctx, child->v.text.text));
+    }
+  }
+  return true;
+}
+
+void HTMLFragmentTemplate::Describe() {
+  description_.clear();
+  auto append_count = [this](uint32_t count) {
+    description_.emplace_back(static_cast<uint16_t>(count & 0xffff));
+    description_.emplace_back(static_cast<uint16_t>(count >> 16));
+  };
+  auto append_string = [this, &append_count](const AtomicString& string) {
+    std::unique_ptr<NativeString> native_string = string.ToNativeString();
+    append_count(native_string->length());
+    description_.insert(description_.end(), native_string->string(),
+                        native_string->string() + native_string->length());
+  };
+
+  uint32_t attribute_begin = 0;
+  uint32_t style_begin = 0;
+  for (const TemplateNode& node : nodes_) {
+    description_.emplace_back(static_cast<uint16_t>(node.type));
+    append_count(node.parent);
+    append_string(node.name);
+    append_count(node.attribute_end - attribute_begin);
+    for (uint32_t i = attribute_begin; i < node.attribute_end; i++) {
+      append_string(attributes_[i].first);
+      append_string(attributes_[i].second);
+    }
+    append_count(node.style_end - style_begin);
+    for (uint32_t i = style_begin; i < node.style_end; i++) {
+      append_string(styles_[i].first);
+      append_string(styles_[i].second);
+    }
+    attribute_begin = node.attribute_end;
+    style_begin = node.style_end;
+  }
+}
+
+HTMLFragmentTemplate* HTMLFragmentTemplateCache::Find(std::string_view html) {
+  auto it = entries_.find(std::hash<std::string_view>{}(html));
+  if (it == entries_.end() || it->second->source() != html)
+    return nullptr;
+  return it->second.get();
+}
+
+HTMLFragmentTemplate* HTMLFragmentTemplateCache::Add(std::string_view html,
+                                                     std::unique_ptr<HTMLFragmentTemplate> fragment_template) {
+  fragment_template->SetSource(html);
+  return Store(std::hash<std::string_view>{}(html), std::move(fragment_template));
+}
+
+bool HTMLFragmentTemplateCache::IsCacheable(std::string_view html) {
+  return html.size() <= kMaximumCachedMarkupLength;
+}
+
+HTMLFragmentTemplate* HTMLFragmentTemplateCache::Store(size_t key,
+                                                       std::unique_ptr<HTMLFragmentTemplate> fragment_template) {
+  auto it = entries_.find(key);
+  if (it == entries_.end() && entries_.size() >= kMaximumFragmentTemplateCacheSize) {
+    it = entries_.begin();
+  }
+  if (it != entries_.end()) {
+    if (it->second->IsDescribed()) {
+      context_->uiCommandBuffer()->addCommand(-1, UICommand::kDisposeFragmentTemplate, it->second->id(), nullptr);
+    }
+    entries_.erase(it);
+  }
+
+  auto& entry = entries_[key];
+  entry = std::move(fragment_template);
+  return entry.get();
+}
+
+}  // namespace webf
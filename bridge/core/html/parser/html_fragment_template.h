@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef BRIDGE_CORE_HTML_PARSER_HTML_FRAGMENT_TEMPLATE_H_
+#define BRIDGE_CORE_HTML_PARSER_HTML_FRAGMENT_TEMPLATE_H_
+
+#include <third_party/gumbo-parser/src/gumbo.h>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "bindings/qjs/atomic_string.h"
+
+namespace webf {
+
+class ContainerNode;
+class Document;
+class ExecutingContext;
+class Node;
+
+// A parsed fragment flattened into a table of nodes in tree order, each one referring to its parent by index. Creating
+// its nodes is a single pass over the table, and dart side is told about all of them by one kInstantiateFragment
+// command instead of a create, insert and attribute command per node.
+//
+// The description sent to dart side, once per template, is a list of uint16_t units. For each node: its type, the
+// index of its parent in two units (0xffffffff for the top level nodes), the tag name or the character data, the count
+// of attributes in two units followed by their names and values, then the count of inline style declarations in two
+// units followed by their camel cased names and values. Every string is prefixed by its length in two units, low bits
+// first, the same as in kSetStyleBatch.
+class HTMLFragmentTemplate {
+ public:
+  enum class NodeType : uint16_t { kElement, kText, kComment };
+  static constexpr uint32_t kNoParent = std::numeric_limits<uint32_t>::max();
+
+  // Flattens the elements, texts and comments which gumbo parsed under |root|, the same nodes
+  // HTMLParser::parseHTMLFragment builds. Returns nullptr for markup with widget elements, which dart side creates on
+  // their own, or with inline scripts, which run each time the markup is set.
+  static std::unique_ptr<HTMLFragmentTemplate> Compile(JSContext* ctx, GumboNode* root);
+
+  // Creates the nodes and appends the top level ones to |parent|, or leaves them without parent when it is null.
+  // Returns the first top level node.
+  Node* Instantiate(Document& document, ContainerNode* parent);
+
+  int64_t id() const { return id_; }
+  const std::vector<uint16_t>& description() const { return description_; }
+  // Whether dart side had been sent the description.
+  bool IsDescribed() const { return described_; }
+  // The markup the template was parsed from.
+  const std::string& source() const { return source_; }
+  void SetSource(std::string_view source) { source_ = source; }
+
+ private:
+  struct TemplateNode {
+    NodeType type;
+    uint32_t parent;
+    // The tag name of an element, the data of a text or a comment.
+    AtomicString name;
+    // The attributes and styles of a node follow the ones of the node before it.
+    uint32_t attribute_end;
+    uint32_t style_end;
+  };
+
+  HTMLFragmentTemplate();
+
+  void AddNode(NodeType type, uint32_t parent, const AtomicString& name);
+  bool CompileGumboChildren(JSContext* ctx, GumboNode* node, uint32_t parent);
+  void Describe();
+
+  std::vector<TemplateNode> nodes_;
+  std::vector<std::pair<AtomicString, AtomicString>> attributes_;
+  std::vector<std::pair<AtomicString, AtomicString>> styles_;
+  std::vector<uint16_t> description_;
+  std::string source_;
+  int64_t id_;
+  bool described_{false};
+};
+
+// The templates of the fragments parsed in a document, looked up by the hash of their markup, so that dart side only
+// needs to be sent the description of each template once.
+class HTMLFragmentTemplateCache {
+ public:
+  explicit HTMLFragmentTemplateCache(ExecutingContext* context) : context_(context) {}
+
+  // Returns nullptr when |html| was not parsed before.
+  HTMLFragmentTemplate* Find(std::string_view html);
+  HTMLFragmentTemplate* Add(std::string_view html, std::unique_ptr<HTMLFragmentTemplate> fragment_template);
+
+  // Only short markup is cached, longer documents are rarely parsed twice.
+  static bool IsCacheable(std::string_view html);
+
+ private:
+  HTMLFragmentTemplate* Store(size_t key, std::unique_ptr<HTMLFragmentTemplate> fragment_template);
+
+  ExecutingContext* context_;
+  std::unordered_map<size_t, std::unique_ptr<HTMLFragmentTemplate>> entries_;
+};
+
+}  // namespace webf
+
+#endif  // BRIDGE_CORE_HTML_PARSER_HTML_FRAGMENT_TEMPLATE_H_
@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "html_fragment_template.h"
+#include "core/dom/document.h"
+#include "core/dom/element.h"
+#include "core/html/html_body_element.h"
+#include "foundation/ui_command_buffer.h"
+#include "gtest/gtest.h"
+#include "webf_test_env.h"
+
+using namespace webf;
+
+TEST(HTMLFragmentTemplate, repeatedInnerHTMLIsInstantiatedFromTemplate) {
+  bool static errorCalled = false;
+  int static logCount = 0;
+  webf::WebFPage::consoleMessageHandler = [](void* ctx, const std::string& message, int logLevel) {
+    logCount++;
+    EXPECT_STREQ(message.c_str(), "true");
+  };
+  auto bridge = TEST_init([](int32_t contextId, const char* errmsg) {
+    WEBF_LOG(VERBOSE) << errmsg;
+    errorCalled = true;
+  });
+  auto* buffer = bridge->GetExecutingContext()->uiCommandBuffer();
+  buffer->acquire();
+  buffer->clear();
+
+  const char* code =
+      "const markup = '<li class=\"item\" style=\"background-color: red; width: 10px\"><b>bold</b><!--c-->text</li>';"
+      "const list = document.createElement('ul');"
+      "document.body.appendChild(list);"
+      "const html = [];"
+      "for (let i = 0; i < 3; i ++) {"
+      "  const item = document.createElement('div');"
+      "  list.appendChild(item);"
+      "  item.innerHTML = markup;"
+      "  html.push(item.innerHTML);"
+      "}"
+      "console.log(html[0] === html[1] && html[1] === html[2]);"
+      "console.log(list.firstChild.firstChild.style.backgroundColor === 'red');"
+      "console.log(list.lastChild.querySelector('b').textContent === 'bold');";
+  bridge->evaluateScript(code, strlen(code), "vm://", 0);
+
+  UICommandBatch* batch = buffer->acquire();
+  int instantiate_count = 0;
+  int described_count = 0;
+  for (int64_t i = 0; i < batch->size(); i++) {
+    UICommandItem& item = batch->item(i);
+    // The nodes of the fragments are only described by kInstantiateFragment.
+    EXPECT_NE(item.type, static_cast<int32_t>(UICommand::kCreateTextNode));
+    EXPECT_NE(item.type, static_cast<int32_t>(UICommand::kCreateComment));
+    if (item.type == static_cast<int32_t>(UICommand::kInstantiateFragment)) {
+      instantiate_count++;
+      // <li>, <b>, "bold", the comment and "text".
+      EXPECT_EQ(item.args_01_length, 5 * 6);
+      if (item.string_02 != UI_COMMAND_NO_STRING) {
+        described_count++;
+      }
+    }
+  }
+  EXPECT_EQ(instantiate_count, 3);
+  EXPECT_EQ(described_count, 1);
+  buffer->clear();
+
+  EXPECT_EQ(logCount, 3);
+  EXPECT_EQ(errorCalled, false);
+}
+
+TEST(HTMLFragmentTemplate, deepClonesMatchTheirSource) {
+  bool static errorCalled = false;
+  int static logCount = 0;
+  webf::WebFPage::consoleMessageHandler = [](void* ctx, const std::string& message, int logLevel) {
+    logCount++;
+    EXPECT_STREQ(message.c_str(), "true");
+  };
+  auto bridge = TEST_init([](int32_t contextId, const char* errmsg) {
+    WEBF_LOG(VERBOSE) << errmsg;
+    errorCalled = true;
+  });
+  auto* buffer = bridge->GetExecutingContext()->uiCommandBuffer();
+
+  const char* code =
+      "const template = document.createElement('template');"
+      "template.content.appendChild(document.createElement('p'));"
+      "template.content.firstChild.setAttribute('id', 'row');"
+      "template.content.firstChild.style.color = 'blue';"
+      "template.content.firstChild.appendChild(document.createTextNode('cell'));"
+      "template.content.appendChild(document.createComment('end'));"
+      "const first = template.content.cloneNode(true);"
+      "const second = template.content.cloneNode(true);"
+      "console.log(first.childNodes.length === 2 && first.firstChild !== template.content.firstChild);"
+      "console.log(first.firstChild.outerHTML === template.content.firstChild.outerHTML &&"
+      "            second.firstChild.outerHTML === first.firstChild.outerHTML);"
+      "const div = document.createElement('div');"
+      "div.innerHTML = '<span title=\"a\">x<i>y</i></span>';"
+      "div.firstChild.style.width = '10px';"
+      "const clone = div.cloneNode(true);"
+      "console.log(clone.outerHTML === div.outerHTML && clone.parentNode === null);"
+      "clone.firstChild.firstChild.data = 'changed';"
+      "console.log(div.firstChild.firstChild.data === 'x');";
+  buffer->acquire();
+  buffer->clear();
+  bridge->evaluateScript(code, strlen(code), "vm://", 0);
+
+  // Clones go through the Clone hooks of each node, so dart side copies what it keeps of the source by kCloneNode.
+  UICommandBatch* batch = buffer->acquire();
+  int clone_count = 0;
+  int instantiate_count = 0;
+  for (int64_t i = 0; i < batch->size(); i++) {
+    UICommandItem& item = batch->item(i);
+    if (item.type == static_cast<int32_t>(UICommand::kCloneNode)) {
+      clone_count++;
+    } else if (item.type == static_cast<int32_t>(UICommand::kInstantiateFragment)) {
+      instantiate_count++;
+    }
+  }
+  // Only the innerHTML assignment is created from a template.
+  EXPECT_EQ(instantiate_count, 1);
+  // Two clones of the fragment with its <p>, "cell" and comment, then <div>, <span>, "x", <i> and "y".
+  EXPECT_EQ(clone_count, 2 * 4 + 5);
+  buffer->clear();
+
+  EXPECT_EQ(logCount, 4);
+  EXPECT_EQ(errorCalled, false);
+}
+
+TEST(HTMLFragmentTemplate, innerHTMLWithWidgetElementsIsNotTemplated) {
+  bool static errorCalled = false;
+  int static logCount = 0;
+  webf::WebFPage::consoleMessageHandler = [](void* ctx, const std::string& message, int logLevel) {
+    logCount++;
+    EXPECT_STREQ(message.c_str(), "true");
+  };
+  auto bridge = TEST_init([](int32_t contextId, const char* errmsg) {
+    WEBF_LOG(VERBOSE) << errmsg;
+    errorCalled = true;
+  });
+  auto context = bridge->GetExecutingContext();
+  auto* buffer = context->uiCommandBuffer();
+  buffer->acquire();
+  buffer->clear();
+
+  const char* code =
+      "const div = document.createElement('div');"
+      "document.body.appendChild(div);"
+      "div.innerHTML = '<p><flutter-button>ok</flutter-button></p>';"
+      "div.innerHTML = '<p><flutter-button>ok</flutter-button></p>';"
+      "console.log(div.firstChild.firstChild.tagName === 'FLUTTER-BUTTON');";
+  bridge->evaluateScript(code, strlen(code), "vm://", 0);
+
+  auto* div = To<Element>(context->document()->body()->lastChild());
+  EXPECT_TRUE(To<Element>(div->firstChild()->firstChild())->IsWidgetElement());
+
+  UICommandBatch* batch = buffer->acquire();
+  for (int64_t i = 0; i < batch->size(); i++) {
+    EXPECT_NE(batch->item(i).type, static_cast<int32_t>(UICommand::kInstantiateFragment));
+  }
+  buffer->clear();
+
+  EXPECT_EQ(logCount, 1);
+  EXPECT_EQ(errorCalled, false);
+}
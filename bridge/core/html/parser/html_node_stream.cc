@@ -0,0 +1,273 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "html_node_stream.h"
+#include <cassert>
+#include "html_parser.h"
+
+namespace webf {
+
+namespace {
+
+using Op = HTMLNodeStream::Op;
+
+// Whitespace only text is dropped, the same as HTMLParser::parseHTML does.
+bool IsParsedNode(const GumboNode* node) {
+  return node->type == GUMBO_NODE_ELEMENT || node->type == GUMBO_NODE_TEXT || node->type == GUMBO_NODE_COMMENT;
+}
+
+bool IsOpen(const GumboVector* open_elements, const GumboNode* node) {
+  // The stack is only as deep as the element nesting, and the elements near its top are asked for most.
+  for (unsigned i = open_elements->length; i > 0; i--) {
+    if (open_elements->data[i - 1] == node)
+      return true;
+  }
+  return false;
+}
+
+bool IsScript(const GumboNode* node) {
+  return node->type == GUMBO_NODE_ELEMENT && node->v.element.tag == GUMBO_TAG_SCRIPT;
+}
+
+HTMLNodeStream::Record MakeRecord(Op op, uint32_t node) {
+  constexpr uint32_t kNoNode = HTMLNodeStream::kNoNode;
+  return HTMLNodeStream::Record{op, node, kNoNode, kNoNode, kNoNode, {0, 0}, {0, 0}};
+}
+
+}  // namespace
+
+HTMLNodeStream::StringRange HTMLNodeStream::AddString(std::string_view string) {
+  StringRange range{static_cast<uint32_t>(strings.size()), static_cast<uint32_t>(string.size())};
+  strings.append(string.data(), string.size());
+  return range;
+}
+
+void HTMLNodeStreamWriter::Update(GumboNode* root, const GumboVector* open_elements, HTMLNodeStream& stream) {
+  if (root == nullptr)
+    return;
+
+  current_open_elements_ = open_elements;
+  if (tracked_nodes_.count(root) == 0) {
+    tracked_nodes_.emplace(root, TrackedNode{0, nullptr, nullptr, nullptr});
+    open_elements_.emplace(root, ChildList{nullptr, nullptr});
+  }
+
+  UpdateChildren(root, stream);
+
+  if (!IsOpen(open_elements, root)) {
+    // The document is complete.
+    Close(root, stream);
+    tracked_nodes_.clear();
+    open_elements_.clear();
+    free_ids_.clear();
+    next_id_ = 1;
+  }
+  current_open_elements_ = nullptr;
+}
+
+uint32_t HTMLNodeStreamWriter::AllocateId() {
+  if (free_ids_.empty())
+    return next_id_++;
+  uint32_t id = free_ids_.back();
+  free_ids_.pop_back();
+  return id;
+}
+
+void HTMLNodeStreamWriter::UpdateChildren(GumboNode* gumbo_parent, HTMLNodeStream& stream) {
+  GumboNode* last_placed = nullptr;
+
+  const GumboVector* children = &gumbo_parent->v.element.children;
+  for (unsigned i = 0; i < children->length; i++) {
+    auto* child = static_cast<GumboNode*>(children->data[i]);
+    if (!IsParsedNode(child))
+      continue;
+
+    bool is_open = IsOpen(current_open_elements_, child);
+    if (tracked_nodes_.count(child) == 0) {
+      uint32_t id = AllocateId();
+      std::vector<uint32_t> scripts;
+      CreateNode(child, id, is_open, scripts, stream);
+      tracked_nodes_.emplace(child, TrackedNode{id, nullptr, nullptr, nullptr});
+      PlaceAt(gumbo_parent, child, last_placed, stream);
+
+      for (uint32_t script : scripts) {
+        stream.records.emplace_back(MakeRecord(Op::kRunScript, script));
+        if (script != id) {
+          stream.records.emplace_back(MakeRecord(Op::kRelease, script));
+          free_ids_.emplace_back(script);
+        }
+      }
+      if (is_open) {
+        open_elements_.emplace(child, ChildList{nullptr, nullptr});
+        UpdateChildren(child, stream);
+      }
+      continue;
+    }
+
+    PlaceAt(gumbo_parent, child, last_placed, stream);
+    if (open_elements_.count(child) == 0)
+      continue;
+
+    UpdateChildren(child, stream);
+    if (!is_open) {
+      Close(child, stream);
+      if (IsScript(child)) {
+        stream.records.emplace_back(MakeRecord(Op::kRunScript, tracked_nodes_.at(child).id));
+      }
+    }
+  }
+}
+
+void HTMLNodeStreamWriter::CreateNode(GumboNode* node,
+                                      uint32_t id,
+                                      bool is_open,
+                                      std::vector<uint32_t>& scripts,
+                                      HTMLNodeStream& stream) {
+  if (node->type != GUMBO_NODE_ELEMENT) {
+    auto record = MakeRecord(node->type == GUMBO_NODE_TEXT ? Op::kText : Op::kComment, id);
+    record.value = stream.AddString(node->v.text.text);
+    stream.records.emplace_back(record);
+    return;
+  }
+
+  auto record = MakeRecord(Op::kStartElement, id);
+  record.name = stream.AddString(tagNameOf(node));
+  stream.records.emplace_back(record);
+
+  const GumboVector* attributes = &node->v.element.attributes;
+  for (unsigned i = 0; i < attributes->length; i++) {
+    auto* attribute = static_cast<GumboAttribute*>(attributes->data[i]);
+    auto attribute_record = MakeRecord(Op::kAttribute, HTMLNodeStream::kNoNode);
+    attribute_record.name = stream.AddString(attribute->name);
+    attribute_record.value = stream.AddString(attribute->value);
+    stream.records.emplace_back(attribute_record);
+  }
+
+  if (!is_open) {
+    if (IsScript(node)) {
+      scripts.emplace_back(id);
+    }
+
+    const GumboVector* children = &node->v.element.children;
+    for (unsigned i = 0; i < children->length; i++) {
+      auto* child = static_cast<GumboNode*>(children->data[i]);
+      if (!IsParsedNode(child))
+        continue;
+
+      if (tracked_nodes_.count(child) == 0) {
+        // Only scripts are referred to again, the rest of a closed subtree is final once it is described.
+        CreateNode(child, IsScript(child) ? AllocateId() : HTMLNodeStream::kNoNode, false, scripts, stream);
+        continue;
+      }
+
+      // Moved in by the tree builder. Bring the node up to date where it was, then take it along.
+      bool closes_script = false;
+      if (open_elements_.count(child) > 0) {
+        UpdateChildren(child, stream);
+        Close(child, stream);
+        closes_script = IsScript(child);
+      }
+      TrackedNode& tracked = tracked_nodes_.at(child);
+      stream.records.emplace_back(MakeRecord(Op::kAppendNode, tracked.id));
+      if (closes_script) {
+        // The number is given up once the script ran.
+        scripts.emplace_back(tracked.id);
+        Unlink(child, tracked);
+        tracked_nodes_.erase(child);
+      } else {
+        Release(child, stream);
+      }
+    }
+  }
+
+  stream.records.emplace_back(MakeRecord(Op::kEndElement, HTMLNodeStream::kNoNode));
+}
+
+void HTMLNodeStreamWriter::PlaceAt(GumboNode* gumbo_parent,
+                                   GumboNode* node,
+                                   GumboNode*& last_placed,
+                                   HTMLNodeStream& stream) {
+  ChildList& list = open_elements_.at(gumbo_parent);
+  GumboNode* cursor = last_placed != nullptr ? tracked_nodes_.at(last_placed).next : list.first;
+  last_placed = node;
+
+  TrackedNode& tracked = tracked_nodes_.at(node);
+  if (cursor == node)
+    return;
+
+  auto record = MakeRecord(Op::kInsert, tracked.id);
+  if (tracked.parent != nullptr) {
+    record.previous_parent = tracked_nodes_.at(tracked.parent).id;
+    Unlink(node, tracked);
+  }
+
+  tracked.parent = gumbo_parent;
+  tracked.next = cursor;
+  tracked.previous = cursor != nullptr ? tracked_nodes_.at(cursor).previous : list.last;
+  if (tracked.previous != nullptr) {
+    tracked_nodes_.at(tracked.previous).next = node;
+  } else {
+    list.first = node;
+  }
+  if (cursor != nullptr) {
+    tracked_nodes_.at(cursor).previous = node;
+  } else {
+    list.last = node;
+  }
+
+  record.parent = tracked_nodes_.at(gumbo_parent).id;
+  record.before = cursor != nullptr ? tracked_nodes_.at(cursor).id : HTMLNodeStream::kNoNode;
+  stream.records.emplace_back(record);
+}
+
+void HTMLNodeStreamWriter::Unlink(GumboNode* node, TrackedNode& tracked) {
+  if (tracked.parent == nullptr)
+    return;
+
+  auto list = open_elements_.find(tracked.parent);
+  if (tracked.previous != nullptr) {
+    tracked_nodes_.at(tracked.previous).next = tracked.next;
+  } else if (list != open_elements_.end()) {
+    list->second.first = tracked.next;
+  }
+  if (tracked.next != nullptr) {
+    tracked_nodes_.at(tracked.next).previous = tracked.previous;
+  } else if (list != open_elements_.end()) {
+    list->second.last = tracked.previous;
+  }
+  tracked.parent = nullptr;
+  tracked.previous = nullptr;
+  tracked.next = nullptr;
+}
+
+void HTMLNodeStreamWriter::Close(GumboNode* element, HTMLNodeStream& stream) {
+  auto it = open_elements_.find(element);
+  if (it == open_elements_.end())
+    return;
+
+  GumboNode* child = it->second.first;
+  open_elements_.erase(it);
+  while (child != nullptr) {
+    TrackedNode& tracked = tracked_nodes_.at(child);
+    GumboNode* next = tracked.next;
+    if (child->parent == element) {
+      Release(child, stream);
+    } else {
+      // The tree builder moved the node to a parent which is not visited yet, it keeps its number until then.
+      Unlink(child, tracked);
+    }
+    child = next;
+  }
+}
+
+void HTMLNodeStreamWriter::Release(GumboNode* node, HTMLNodeStream& stream) {
+  auto it = tracked_nodes_.find(node);
+  assert(it != tracked_nodes_.end());
+  Unlink(node, it->second);
+  stream.records.emplace_back(MakeRecord(Op::kRelease, it->second.id));
+  free_ids_.emplace_back(it->second.id);
+  tracked_nodes_.erase(it);
+}
+
+}  // namespace webf
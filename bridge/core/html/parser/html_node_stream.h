@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef BRIDGE_CORE_HTML_PARSER_HTML_NODE_STREAM_H_
+#define BRIDGE_CORE_HTML_PARSER_HTML_NODE_STREAM_H_
+
+#include <third_party/gumbo-parser/src/gumbo.h>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace webf {
+
+// A batch of parser output which refers to nodes by number and to strings by offset instead of by pointer, so that it
+// can be produced away from the JS thread and replayed on it by HTMLNodeStreamReader.
+//
+// Node 0 is the root which the document is parsed into. Other numbers are handed out to the nodes which later records
+// still refer to, and are reused once a kRelease record gave them up.
+struct HTMLNodeStream {
+  static constexpr uint32_t kNoNode = std::numeric_limits<uint32_t>::max();
+
+  enum class Op : uint8_t {
+    // Creates the element |name|, followed by a kAttribute record for each of its attributes. The nodes created up to
+    // the matching kEndElement are appended to it.
+    kStartElement,
+    kAttribute,
+    kEndElement,
+    kText,
+    kComment,
+    // Appends the existing |node| to the element being created.
+    kAppendNode,
+    // Inserts |node| under |parent| before |before|, or at the end when |before| is kNoNode. When |previous_parent| is
+    // not kNoNode the node is only moved if it is still a child of that node, otherwise a script moved it.
+    kInsert,
+    kRunScript,
+    kRelease,
+  };
+
+  struct StringRange {
+    uint32_t offset;
+    uint32_t length;
+  };
+
+  struct Record {
+    Op op;
+    uint32_t node;
+    uint32_t parent;
+    uint32_t before;
+    uint32_t previous_parent;
+    // The tag or attribute name.
+    StringRange name;
+    // The attribute value, or the data of a text or comment.
+    StringRange value;
+  };
+
+  std::string_view StringAt(StringRange range) const {
+    return std::string_view(strings.data() + range.offset, range.length);
+  }
+  StringRange AddString(std::string_view string);
+
+  std::vector<Record> records;
+  std::string strings;
+};
+
+// Turns a gumbo tree, complete or still being parsed, into HTMLNodeStream records. It only reads the gumbo tree, so it
+// runs on whichever thread drives the gumbo parse.
+//
+// An element which is still open is described empty, so that its children can follow in later updates, and a node
+// which is already closed is described with its complete subtree, to be inserted in one go. The children of open
+// elements keep their numbers, as the tree builder may still move them, e.g. by the adoption agency algorithm for
+// misnested formatting elements or by foster parenting. A script element is run once it is closed and attached,
+// before the nodes which follow it are inserted.
+class HTMLNodeStreamWriter {
+ public:
+  // Appends the records which bring the reader up to date with the tree under |root|, which is null until the first
+  // element is parsed. Elements which are not in |open_elements| are final.
+  void Update(GumboNode* root, const GumboVector* open_elements, HTMLNodeStream& stream);
+
+ private:
+  struct TrackedNode {
+    uint32_t id;
+    // The gumbo parent which the node was last inserted under.
+    GumboNode* parent;
+    // The siblings in the order the reader has them, which differs from the gumbo order until the next insertion.
+    GumboNode* previous;
+    GumboNode* next;
+  };
+
+  struct ChildList {
+    GumboNode* first;
+    GumboNode* last;
+  };
+
+  uint32_t AllocateId();
+  void UpdateChildren(GumboNode* gumbo_parent, HTMLNodeStream& stream);
+  // Describes a new node, with its subtree when it is closed. The scripts which become runnable once the node is
+  // inserted are collected into |scripts|.
+  void CreateNode(GumboNode* node, uint32_t id, bool is_open, std::vector<uint32_t>& scripts, HTMLNodeStream& stream);
+  void PlaceAt(GumboNode* gumbo_parent, GumboNode* node, GumboNode*& last_placed, HTMLNodeStream& stream);
+  void Unlink(GumboNode* node, TrackedNode& tracked);
+  // The element is final, its children no longer need numbers.
+  void Close(GumboNode* element, HTMLNodeStream& stream);
+  void Release(GumboNode* node, HTMLNodeStream& stream);
+
+  std::unordered_map<GumboNode*, TrackedNode> tracked_nodes_;
+  // The tracked children of the elements which were open when last visited.
+  std::unordered_map<GumboNode*, ChildList> open_elements_;
+  const GumboVector* current_open_elements_{nullptr};
+  std::vector<uint32_t> free_ids_;
+  uint32_t next_id_{1};
+};
+
+}  // namespace webf
+
+#endif  // BRIDGE_CORE_HTML_PARSER_HTML_NODE_STREAM_H_
@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "html_node_stream_reader.h"
+#include <cassert>
+#include "core/dom/comment.h"
+#include "core/dom/document.h"
+#include "core/dom/element.h"
+#include "core/dom/text.h"
+#include "core/executing_context.h"
+#include "html_parser.h"
+
+namespace webf {
+
+namespace {
+
+using Op = HTMLNodeStream::Op;
+
+void RunScript(Element& script) {
+  std::string code;
+  for (Node* child = script.firstChild(); child != nullptr; child = child->nextSibling()) {
+    if (auto* text = DynamicTo<Text>(child)) {
+      code += text->data().ToStdString();
+    }
+  }
+  if (code.empty())
+    return;
+
+  ExecutingContext* context = script.GetExecutingContext();
+  DeferredWrapperScope eager_wrappers{context, false};
+  context->FlushUICommand();
+  context->EvaluateJavaScript(code.c_str(), code.size(), "vm://", 0);
+}
+
+}  // namespace
+
+HTMLNodeStreamReader::HTMLNodeStreamReader(ContainerNode* root) {
+  root->RemoveChildren();
+  nodes_.emplace_back(root);
+}
+
+HTMLNodeStreamReader::~HTMLNodeStreamReader() {
+  for (auto& node : nodes_) {
+    node.Clear();
+  }
+}
+
+void HTMLNodeStreamReader::Apply(const HTMLNodeStream& stream) {
+  auto* root = To<ContainerNode>(nodes_[0].Get());
+  Document& document = root->GetDocument();
+  JSContext* ctx = root->ctx();
+  // Only nodes which end up in the document tree may defer their JS objects, see Node::RemovedFrom.
+  DeferredWrapperScope deferred_wrappers{root->GetExecutingContext(), root->isConnected()};
+
+  // The elements of the subtree being created, innermost last.
+  std::vector<ContainerNode*> building;
+
+  const std::vector<HTMLNodeStream::Record>& records = stream.records;
+  for (size_t i = 0; i < records.size(); i++) {
+    const HTMLNodeStream::Record& record = records[i];
+    switch (record.op) {
+      case Op::kStartElement: {
+        auto* element = document.createElement(AtomicString(ctx, stream.StringAt(record.name)), ASSERT_NO_EXCEPTION());
+        while (i + 1 < records.size() && records[i + 1].op == Op::kAttribute) {
+          i++;
+          HTMLParser::parseAttribute(element, stream.StringAt(records[i].name), stream.StringAt(records[i].value));
+        }
+        Attach(element, record.node, building);
+        building.emplace_back(element);
+        break;
+      }
+      case Op::kAttribute:
+        // Consumed with its element.
+        assert(false);
+        break;
+      case Op::kEndElement:
+        building.pop_back();
+        break;
+      case Op::kText:
+        Attach(document.createTextNode(AtomicString(ctx, stream.StringAt(record.value)), ASSERT_NO_EXCEPTION()),
+               record.node, building);
+        break;
+      case Op::kComment:
+        Attach(document.createComment(AtomicString(ctx, stream.StringAt(record.value)), ASSERT_NO_EXCEPTION()),
+               record.node, building);
+        break;
+      case Op::kAppendNode:
+        building.back()->AppendChild(NodeAt(record.node));
+        break;
+      case Op::kInsert: {
+        Node* node = NodeAt(record.node);
+        if (record.previous_parent != HTMLNodeStream::kNoNode && node->parentNode() != NodeAt(record.previous_parent)) {
+          // Leave the node where a script put it.
+          break;
+        }
+        auto* parent = To<ContainerNode>(NodeAt(record.parent));
+        Node* before = record.before != HTMLNodeStream::kNoNode ? NodeAt(record.before) : nullptr;
+        if (before != nullptr && before->parentNode() != parent) {
+          before = nullptr;
+        }
+        parent->InsertBefore(node, before, ASSERT_NO_EXCEPTION());
+        break;
+      }
+      case Op::kRunScript:
+        RunScript(*To<Element>(NodeAt(record.node)));
+        break;
+      case Op::kRelease:
+        nodes_[record.node].Clear();
+        break;
+    }
+  }
+}
+
+Node* HTMLNodeStreamReader::NodeAt(uint32_t id) const {
+  assert(id < nodes_.size() && nodes_[id].Get() != nullptr);
+  return nodes_[id].Get();
+}
+
+void HTMLNodeStreamReader::Attach(Node* node, uint32_t id, std::vector<ContainerNode*>& building) {
+  if (id != HTMLNodeStream::kNoNode) {
+    if (id >= nodes_.size()) {
+      nodes_.resize(id + 1);
+    }
+    nodes_[id] = node;
+  }
+  if (!building.empty()) {
+    building.back()->AppendChild(node);
+  }
+}
+
+}  // namespace webf
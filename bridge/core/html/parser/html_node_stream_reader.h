@@ -0,0 +1,38 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef BRIDGE_CORE_HTML_PARSER_HTML_NODE_STREAM_READER_H_
+#define BRIDGE_CORE_HTML_PARSER_HTML_NODE_STREAM_READER_H_
+
+#include <vector>
+#include "bindings/qjs/cppgc/member.h"
+#include "html_node_stream.h"
+
+namespace webf {
+
+class ContainerNode;
+class Node;
+
+// Replays HTMLNodeStream records into the DOM on the JS thread. It only creates the nodes, sets their attributes, puts
+// them where the records say and runs the inline scripts, all parsing decisions were taken by HTMLNodeStreamWriter.
+class HTMLNodeStreamReader {
+ public:
+  // |root| is node 0 of the stream, its children are replaced.
+  explicit HTMLNodeStreamReader(ContainerNode* root);
+  // Gives up the nodes which are still numbered, which needs a MemberMutationScope.
+  ~HTMLNodeStreamReader();
+
+  void Apply(const HTMLNodeStream& stream);
+
+ private:
+  Node* NodeAt(uint32_t id) const;
+  // Numbers |node| and appends it to the element being created, if any.
+  void Attach(Node* node, uint32_t id, std::vector<ContainerNode*>& building);
+
+  std::vector<Member<Node>> nodes_;
+};
+
+}  // namespace webf
+
+#endif  // BRIDGE_CORE_HTML_PARSER_HTML_NODE_STREAM_READER_H_
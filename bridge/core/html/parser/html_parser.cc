@@ -3,48 +3,64 @@
  * Copyright (C) 2022-present The WebF authors. All rights reserved.
  */
 
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <utility>
 
+#include "core/dom/comment.h"
 #include "core/dom/document.h"
+#include "core/dom/document_fragment.h"
 #include "core/dom/element.h"
 #include "core/dom/text.h"
 #include "foundation/logging.h"
+#include "html_fragment_template.h"
+#include "html_node_stream.h"
+#include "html_node_stream_reader.h"
 #include "html_parser.h"
 
 namespace webf {
 
-inline std::string trim(const std::string& str) {
-  std::string tmp = str;
-  tmp.erase(0, tmp.find_first_not_of(' '));  // prefixing spaces
-  tmp.erase(tmp.find_last_not_of(' ') + 1);  // surfixing spaces
-  return tmp;
+// https://infra.spec.whatwg.org/#ascii-whitespace
+constexpr std::string_view kASCIIWhitespace = " \t\n\f\r";
+
+inline std::string_view trim(std::string_view str) {
+  size_t start = str.find_first_not_of(kASCIIWhitespace);
+  if (start == std::string_view::npos)
+    return std::string_view();
+  size_t end = str.find_last_not_of(kASCIIWhitespace);
+  return str.substr(start, end - start + 1);
+}
+
+inline bool isWhitespaceOnly(std::string_view str) {
+  return str.find_first_not_of(kASCIIWhitespace) == std::string_view::npos;
+}
+
+std::string_view tagNameOf(GumboNode* node) {
+  if (node->v.element.tag != GUMBO_TAG_UNKNOWN) {
+    return gumbo_normalized_tagname(node->v.element.tag);
+  }
+  GumboStringPiece piece = node->v.element.original_tag;
+  gumbo_tag_from_original_text(&piece);
+  return std::string_view(piece.data, piece.length);
 }
 
 // Parse html,isHTMLFragment should be false if need to automatically complete html, head, and body when they are
 // missing.
-GumboOutput* parse(const std::string& html, bool isHTMLFragment = false) {
+GumboOutput* parse(std::string_view html, bool isHTMLFragment = false) {
   // Gumbo-parser parse HTML.
-  GumboOutput* htmlTree = gumbo_parse_with_options(&kGumboDefaultOptions, html.c_str(), html.length());
+  GumboOutput* htmlTree = gumbo_parse_with_options(&kGumboDefaultOptions, html.data(), html.length());
 
   if (isHTMLFragment) {
     // Find body.
     const GumboVector* children = &htmlTree->root->v.element.children;
     for (int i = 0; i < children->length; ++i) {
       auto* child = (GumboNode*)children->data[i];
-      if (child->type == GUMBO_NODE_ELEMENT) {
-        std::string tagName;
-        if (child->v.element.tag != GUMBO_TAG_UNKNOWN) {
-          tagName = gumbo_normalized_tagname(child->v.element.tag);
-        } else {
-          GumboStringPiece piece = child->v.element.original_tag;
-          gumbo_tag_from_original_text(&piece);
-          tagName = std::string(piece.data, piece.length);
-        }
-
-        if (tagName.compare("body") == 0) {
-          htmlTree->root = child;
-          break;
-        }
+      if (child->type == GUMBO_NODE_ELEMENT && child->v.element.tag == GUMBO_TAG_BODY) {
+        htmlTree->root = child;
+        break;
       }
     }
   }
@@ -52,6 +68,72 @@ GumboOutput* parse(const std::string& html, bool isHTMLFragment = false) {
   return htmlTree;
 }
 
+namespace {
+
+// The input handed to gumbo at a time by parseHTMLOffThread. Larger slices keep the JS thread waiting longer for the
+// first nodes, smaller ones have the writer walk the open elements more often.
+constexpr size_t kOffThreadSliceSize = 256 * 1024;
+
+// Passes the slices parsed on the parser thread to the JS thread, a null stream ends the document.
+class HTMLNodeStreamQueue {
+ public:
+  void Push(std::unique_ptr<HTMLNodeStream> stream) {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      streams_.emplace_back(std::move(stream));
+    }
+    condition_.notify_one();
+  }
+
+  std::unique_ptr<HTMLNodeStream> Pop() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    condition_.wait(lock, [this] { return !streams_.empty(); });
+    std::unique_ptr<HTMLNodeStream> stream = std::move(streams_.front());
+    streams_.pop_front();
+    return stream;
+  }
+
+ private:
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  std::deque<std::unique_ptr<HTMLNodeStream>> streams_;
+};
+
+void ParseOnParserThread(std::string_view html, HTMLNodeStreamQueue* queue) {
+  GumboIncrementalParser* parser = gumbo_incremental_parser_create(&kGumboDefaultOptions);
+  HTMLNodeStreamWriter writer;
+
+  size_t parsed = 0;
+  while (html.size() - parsed > kOffThreadSliceSize) {
+    // The tokenizer can not look ahead past the end of its input, every slice ends after a '>'.
+    size_t end = html.rfind('>', parsed + kOffThreadSliceSize - 1);
+    if (end == std::string_view::npos || end < parsed) {
+      end = html.find('>', parsed + kOffThreadSliceSize);
+      if (end == std::string_view::npos)
+        break;
+    }
+    parsed = end + 1;
+
+    gumbo_incremental_parser_feed(parser, html.data(), parsed);
+    auto stream = std::make_unique<HTMLNodeStream>();
+    writer.Update(gumbo_incremental_parser_output(parser)->root, gumbo_incremental_parser_open_elements(parser),
+                  *stream);
+    queue->Push(std::move(stream));
+  }
+
+  gumbo_incremental_parser_feed(parser, html.data(), html.size());
+  GumboOutput* output = gumbo_incremental_parser_finish(parser);
+  GumboVector no_open_elements = kGumboEmptyVector;
+  auto stream = std::make_unique<HTMLNodeStream>();
+  writer.Update(output->root, &no_open_elements, *stream);
+  gumbo_destroy_output(&kGumboDefaultOptions, output);
+
+  queue->Push(std::move(stream));
+  queue->Push(nullptr);
+}
+
+}  // namespace
+
 void HTMLParser::traverseHTML(Node* root_node, GumboNode* node) {
   auto* context = root_node->GetExecutingContext();
   JSContext* ctx = root_node->GetExecutingContext()->ctx();
@@ -62,14 +144,7 @@ void HTMLParser::traverseHTML(Node* root_node, GumboNode* node) {
 
     if (auto* root_container = DynamicTo<ContainerNode>(root_node)) {
       if (child->type == GUMBO_NODE_ELEMENT) {
-        std::string tagName;
-        if (child->v.element.tag != GUMBO_TAG_UNKNOWN) {
-          tagName = gumbo_normalized_tagname(child->v.element.tag);
-        } else {
-          GumboStringPiece piece = child->v.element.original_tag;
-          gumbo_tag_from_original_text(&piece);
-          tagName = std::string(piece.data, piece.length);
-        }
+        std::string_view tagName = tagNameOf(child);
 
         auto* element = context->document()->createElement(AtomicString(ctx, tagName), ASSERT_NO_EXCEPTION());
         root_container->AppendChild(element);
@@ -79,6 +154,7 @@ void HTMLParser::traverseHTML(Node* root_node, GumboNode* node) {
         if (child->v.element.children.length > 0) {
           if (child->v.element.tag == GUMBO_TAG_SCRIPT) {
             const char* code = ((GumboNode*)child->v.element.children.data[0])->v.text.text;
+            DeferredWrapperScope eager_wrappers{context, false};
             context->FlushUICommand();
             context->EvaluateJavaScript(code, strlen(code), "vm://", 0);
           } else {
@@ -93,12 +169,99 @@ void HTMLParser::traverseHTML(Node* root_node, GumboNode* node) {
   }
 }
 
-bool HTMLParser::parseHTML(const std::string& html, Node* root_node, bool isHTMLFragment) {
+void HTMLParser::buildFragment(ContainerNode* parent, GumboNode* node, std::vector<const char*>& scripts) {
+  auto* context = parent->GetExecutingContext();
+  JSContext* ctx = context->ctx();
+
+  const GumboVector* children = &node->v.element.children;
+  for (int i = 0; i < children->length; ++i) {
+    auto* child = (GumboNode*)children->data[i];
+
+    if (child->type == GUMBO_NODE_ELEMENT) {
+      auto* element = context->document()->createElement(AtomicString(ctx, tagNameOf(child)), ASSERT_NO_EXCEPTION());
+      parseProperty(element, &child->v.element);
+      if (child->v.element.tag == GUMBO_TAG_SCRIPT && child->v.element.children.length > 0) {
+        scripts.emplace_back(((GumboNode*)child->v.element.children.data[0])->v.text.text);
+      }
+      buildFragment(element, child, scripts);
+      parent->AppendChild(element);
+    } else if (child->type == GUMBO_NODE_TEXT) {
+      auto* text = context->document()->createTextNode(AtomicString(ctx, child->v.text.text), ASSERT_NO_EXCEPTION());
+      parent->AppendChild(text);
+    } else if (child->type == GUMBO_NODE_COMMENT) {
+      auto* comment = context->document()->createComment(AtomicString(ctx, child->v.text.text), ASSERT_NO_EXCEPTION());
+      parent->AppendChild(comment);
+    }
+  }
+}
+
+bool HTMLParser::parseHTMLFragment(std::string_view html, Node* root_node) {
+  auto* root_container_node = DynamicTo<ContainerNode>(root_node);
+  if (root_container_node == nullptr) {
+    WEBF_LOG(ERROR) << "Root node is null.";
+    return true;
+  }
+
+  root_container_node->RemoveChildren();
+  if (isWhitespaceOnly(html))
+    return true;
+
+  // Build the whole subtree under a detached fragment, so nothing is attached to the live tree until the final
+  // insertion moves every top level node in at once.
+  DeferredWrapperScope deferred_wrappers{root_container_node->GetExecutingContext(),
+                                         root_container_node->isConnected()};
+  Document& document = root_container_node->GetDocument();
+  auto* fragment = DocumentFragment::Create(document);
+  HTMLFragmentTemplate* fragment_template = nullptr;
+  GumboOutput* htmlTree = nullptr;
+  if (HTMLFragmentTemplateCache::IsCacheable(html)) {
+    // Markup which is set again and again is parsed once, later fragments are created from its template.
+    HTMLFragmentTemplateCache& cache = document.GetFragmentTemplateCache();
+    fragment_template = cache.Find(html);
+    if (fragment_template == nullptr) {
+      htmlTree = parse(html, true);
+      if (auto compiled = HTMLFragmentTemplate::Compile(root_container_node->ctx(), htmlTree->root)) {
+        fragment_template = cache.Add(html, std::move(compiled));
+      }
+    }
+  }
+  std::vector<const char*> scripts;
+  if (fragment_template != nullptr) {
+    fragment_template->Instantiate(document, fragment);
+  } else {
+    if (htmlTree == nullptr) {
+      htmlTree = parse(html, true);
+    }
+    buildFragment(fragment, htmlTree->root, scripts);
+  }
+
+  root_container_node->AppendChild(fragment);
+
+  // Inline scripts run in document order once all the nodes are in place.
+  if (!scripts.empty()) {
+    ExecutingContext* context = root_container_node->GetExecutingContext();
+    DeferredWrapperScope eager_wrappers{context, false};
+    context->FlushUICommand();
+    for (const char* code : scripts) {
+      context->EvaluateJavaScript(code, strlen(code), "vm://", 0);
+    }
+  }
+
+  if (htmlTree != nullptr) {
+    gumbo_destroy_output(&kGumboDefaultOptions, htmlTree);
+  }
+  return true;
+}
+
+bool HTMLParser::parseHTML(std::string_view html, Node* root_node, bool isHTMLFragment) {
   if (root_node != nullptr) {
     if (auto* root_container_node = DynamicTo<ContainerNode>(root_node)) {
       root_container_node->RemoveChildren();
 
-      if (!trim(html).empty()) {
+      if (!isWhitespaceOnly(html)) {
+        // The JS objects of the parsed nodes are created when scripts reach them.
+        DeferredWrapperScope deferred_wrappers{root_container_node->GetExecutingContext(),
+                                               root_container_node->isConnected()};
         GumboOutput* htmlTree = parse(html, isHTMLFragment);
         traverseHTML(root_container_node, htmlTree->root);
         // Free gumbo parse nodes.
@@ -112,56 +275,70 @@ bool HTMLParser::parseHTML(const std::string& html, Node* root_node, bool isHTML
   return true;
 }
 
-bool HTMLParser::parseHTML(const std::string& html, Node* root_node) {
+bool HTMLParser::parseHTMLOffThread(std::string_view html, Node* root_node) {
+  auto* root_container_node = DynamicTo<ContainerNode>(root_node);
+  if (root_container_node == nullptr) {
+    WEBF_LOG(ERROR) << "Root node is null.";
+    return true;
+  }
+
+  HTMLNodeStreamReader reader(root_container_node);
+  if (isWhitespaceOnly(html))
+    return true;
+
+  HTMLNodeStreamQueue queue;
+  std::thread parser_thread(ParseOnParserThread, html, &queue);
+  while (std::unique_ptr<HTMLNodeStream> stream = queue.Pop()) {
+    reader.Apply(*stream);
+  }
+  parser_thread.join();
+  return true;
+}
+
+bool HTMLParser::parseHTML(std::string_view html, Node* root_node) {
   return parseHTML(html, root_node, false);
 }
 
 bool HTMLParser::parseHTML(const char* code, size_t codeLength, Node* root_node) {
-  std::string html = std::string(code, codeLength);
-  return parseHTML(html, root_node, false);
+  return parseHTML(std::string_view(code, codeLength), root_node, false);
 }
 
 bool HTMLParser::parseHTMLFragment(const char* code, size_t codeLength, Node* rootNode) {
-  std::string html = std::string(code, codeLength);
-  return parseHTML(html, rootNode, true);
+  return parseHTMLFragment(std::string_view(code, codeLength), rootNode);
 }
 
 void HTMLParser::parseProperty(Element* element, GumboElement* gumboElement) {
-  auto* context = element->GetExecutingContext();
-  JSContext* ctx = context->ctx();
-
   GumboVector* attributes = &gumboElement->attributes;
   for (int j = 0; j < attributes->length; ++j) {
     auto* attribute = (GumboAttribute*)attributes->data[j];
+    parseAttribute(element, attribute->name, attribute->value);
+  }
+}
 
-    if (strcmp(attribute->name, "style") == 0) {
-      std::vector<std::string> arrStyles;
-      std::string::size_type prev_pos = 0, pos = 0;
-      std::string strStyles = attribute->value;
+void HTMLParser::parseAttribute(Element* element, std::string_view name, std::string_view value) {
+  JSContext* ctx = element->ctx();
 
-      while ((pos = strStyles.find(';', pos)) != std::string::npos) {
-        arrStyles.push_back(strStyles.substr(prev_pos, pos - prev_pos));
-        prev_pos = ++pos;
-      }
-      arrStyles.push_back(strStyles.substr(prev_pos, pos - prev_pos));
-
-      auto* style = element->style();
-
-      for (auto& s : arrStyles) {
-        std::string::size_type position = s.find(':');
-        if (position != std::basic_string<char>::npos) {
-          std::string styleKey = s.substr(0, position);
-          trim(styleKey);
-          std::string styleValue = s.substr(position + 1, s.length());
-          trim(styleValue);
-          style->setProperty(AtomicString(ctx, styleKey), AtomicString(ctx, styleValue), ASSERT_NO_EXCEPTION());
-        }
-      }
+  if (name == "style") {
+    auto* style = element->style();
+    forEachStyleDeclaration(value, [style, ctx](std::string_view style_name, std::string_view style_value) {
+      style->setProperty(AtomicString(ctx, style_name), AtomicString(ctx, style_value), ASSERT_NO_EXCEPTION());
+    });
+  } else {
+    element->setAttribute(AtomicString(ctx, name), AtomicString(ctx, value), ASSERT_NO_EXCEPTION());
+  }
+}
+
+void forEachStyleDeclaration(std::string_view styles,
+                             const std::function<void(std::string_view name, std::string_view value)>& callback) {
+  // Split the declarations in place, only the resulting names and values are copied into atoms.
+  while (!styles.empty()) {
+    size_t end = styles.find(';');
+    std::string_view declaration = styles.substr(0, end);
+    styles = end == std::string_view::npos ? std::string_view() : styles.substr(end + 1);
 
-    } else {
-      std::string strName = attribute->name;
-      std::string strValue = attribute->value;
-      element->setAttribute(AtomicString(ctx, strName), AtomicString(ctx, strValue), ASSERT_NO_EXCEPTION());
+    size_t position = declaration.find(':');
+    if (position != std::string_view::npos) {
+      callback(trim(declaration.substr(0, position)), trim(declaration.substr(position + 1)));
     }
   }
 }
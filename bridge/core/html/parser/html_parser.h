@@ -6,27 +6,52 @@
 #define BRIDGE_HTML_PARSER_H
 
 #include <third_party/gumbo-parser/src/gumbo.h>
+#include <functional>
 #include <string>
+#include <string_view>
+#include <vector>
 #include "foundation/native_string.h"
 
 namespace webf {
 
 class Node;
+class ContainerNode;
 class Element;
 class ExecutingContext;
 
+// The lowercase tag name of a gumbo element, including unknown tags. Points into gumbo's static names or into the
+// parsed input.
+std::string_view tagNameOf(GumboNode* node);
+
+// Calls |callback| with the trimmed property name and value of each declaration of a style attribute.
+void forEachStyleDeclaration(std::string_view styles,
+                             const std::function<void(std::string_view name, std::string_view value)>& callback);
+
 class HTMLParser {
  public:
+  // The input is parsed in place, it is not copied.
   static bool parseHTML(const char* code, size_t codeLength, Node* rootNode);
-  static bool parseHTML(const std::string& html, Node* rootNode);
+  static bool parseHTML(std::string_view html, Node* rootNode);
   static bool parseHTMLFragment(const char* code, size_t codeLength, Node* rootNode);
+  // The innerHTML setter. The parsed nodes are built under a detached fragment which is attached to |rootNode| in a
+  // single insertion, inline scripts are executed after it.
+  static bool parseHTMLFragment(std::string_view html, Node* rootNode);
+  // Runs gumbo on a thread of its own, which hands the parsed nodes over in slices as an HTMLNodeStream. The calling
+  // thread creates the nodes of one slice while the next is parsed, and runs inline scripts in document order. The
+  // input must outlive the call, and a MemberMutationScope must be active.
+  static bool parseHTMLOffThread(std::string_view html, Node* rootNode);
 
  private:
+  friend class HTMLNodeStreamReader;
+
   ExecutingContext* context_;
   static void traverseHTML(Node* root, GumboNode* node);
+  // Collects the code of the inline scripts into |scripts|, it points into the gumbo output.
+  static void buildFragment(ContainerNode* parent, GumboNode* node, std::vector<const char*>& scripts);
   static void parseProperty(Element* element, GumboElement* gumboElement);
+  static void parseAttribute(Element* element, std::string_view name, std::string_view value);
 
-  static bool parseHTML(const std::string& html, Node* rootNode, bool isHTMLFragment);
+  static bool parseHTML(std::string_view html, Node* rootNode, bool isHTMLFragment);
 };
 }  // namespace webf
 
@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "html_parser.h"
+#include "core/dom/document.h"
+#include "core/dom/element.h"
+#include "core/html/html_body_element.h"
+#include "gtest/gtest.h"
+#include "webf_test_env.h"
+
+using namespace webf;
+
+// Several slices of the parser thread.
+static std::string Filler(int index) {
+  std::string html;
+  for (int i = 0; html.size() < 300 * 1024; i++) {
+    std::string id = std::to_string(index) + "-" + std::to_string(i);
+    html += "<div id=\"d" + id + "\" style=\"color: red\"><b>bold<i>misnested " + id + "</b>&amp;</i></div>";
+  }
+  return html;
+}
+
+TEST(HTMLParser, parseHTMLOffThreadMatchesParseHTML) {
+  bool static errorCalled = false;
+  webf::WebFPage::consoleMessageHandler = [](void* ctx, const std::string& message, int logLevel) {};
+  auto error_handler = [](int32_t contextId, const char* errmsg) {
+    WEBF_LOG(VERBOSE) << errmsg;
+    errorCalled = true;
+  };
+  std::string html = "<html><body>" + Filler(0) + "<table><tr><td>cell</td></tr>stray</table>" + Filler(1) +
+                     "<ul><li>1<li>2</ul></body></html>";
+
+  auto on_thread = TEST_init(error_handler);
+  auto on_thread_context = on_thread->GetExecutingContext();
+  auto reference = TEST_init(error_handler);
+  auto reference_context = reference->GetExecutingContext();
+  {
+    MemberMutationScope scope{on_thread_context};
+    HTMLParser::parseHTMLOffThread(html, on_thread_context->document()->documentElement());
+  }
+  {
+    MemberMutationScope scope{reference_context};
+    HTMLParser::parseHTML(html, reference_context->document()->documentElement());
+  }
+
+  EXPECT_EQ(on_thread_context->document()->body()->innerHTML(), reference_context->document()->body()->innerHTML());
+  EXPECT_EQ(errorCalled, false);
+}
+
+TEST(HTMLParser, parseHTMLOffThreadRunsScriptsInOrder) {
+  bool static errorCalled = false;
+  int static logCount = 0;
+  webf::WebFPage::consoleMessageHandler = [](void* ctx, const std::string& message, int logLevel) {
+    logCount++;
+    EXPECT_STREQ(message.c_str(), "true");
+  };
+  auto bridge = TEST_init([](int32_t contextId, const char* errmsg) {
+    WEBF_LOG(VERBOSE) << errmsg;
+    errorCalled = true;
+  });
+
+  // Each script sees the nodes before it, and none of the nodes after it.
+  std::string html = "<html><body>";
+  for (int i = 0; i < 3; i++) {
+    std::string index = std::to_string(i);
+    html += Filler(i) + "<p id=\"before-" + index + "\"></p><script>console.log(document.getElementById('before-" +
+            index + "') !== null && document.getElementById('after-" + index + "') === null)</script><p id=\"after-" +
+            index + "\"></p>";
+  }
+  html += "</body></html>";
+
+  bridge->parseHTML(html.c_str(), html.size());
+  EXPECT_EQ(logCount, 3);
+  EXPECT_EQ(errorCalled, false);
+}
+
+TEST(HTMLParser, parsedNodesCreateJSObjectsOnFirstAccess) {
+  bool static errorCalled = false;
+  int static logCount = 0;
+  webf::WebFPage::consoleMessageHandler = [](void* ctx, const std::string& message, int logLevel) {
+    logCount++;
+    EXPECT_STREQ(message.c_str(), "true");
+  };
+  auto bridge = TEST_init([](int32_t contextId, const char* errmsg) {
+    WEBF_LOG(VERBOSE) << errmsg;
+    errorCalled = true;
+  });
+  auto context = bridge->GetExecutingContext();
+
+  std::string html =
+      "<html><body><div id=\"a\" style=\"color: red\"><p>first</p></div><div id=\"b\"><p>second</p></div></body></html>";
+  bridge->parseHTML(html.c_str(), html.size());
+
+  Element* a = context->document()->getElementById(AtomicString(context->ctx(), "a"), ASSERT_NO_EXCEPTION());
+  Node* b = a->nextSibling();
+  EXPECT_TRUE(a->HasDeferredWrapper());
+  EXPECT_TRUE(b->HasDeferredWrapper());
+
+  const char* code =
+      "const a = document.getElementById('a');"
+      "console.log(a === document.body.firstChild && a.style.color === 'red');"
+      "document.body.removeChild(a.nextSibling);"
+      "console.log(document.body.childNodes.length === 1 && a.firstChild.textContent === 'first');";
+  bridge->evaluateScript(code, strlen(code), "vm://", 0);
+
+  EXPECT_FALSE(a->HasDeferredWrapper());
+  EXPECT_FALSE(a->firstChild()->HasDeferredWrapper());
+  EXPECT_EQ(logCount, 2);
+  EXPECT_EQ(errorCalled, false);
+}
+
+TEST(HTMLParser, removedSubtreeWithDeferredNodesIsCollected) {
+  bool static errorCalled = false;
+  auto bridge = TEST_init([](int32_t contextId, const char* errmsg) {
+    WEBF_LOG(VERBOSE) << errmsg;
+    errorCalled = true;
+  });
+  auto context = bridge->GetExecutingContext();
+
+  std::string html = "<html><body><div id=\"c\"><p>1</p><p>2</p><p>3</p></div></body></html>";
+  bridge->parseHTML(html.c_str(), html.size());
+
+  Element* c = context->document()->getElementById(AtomicString(context->ctx(), "c"), ASSERT_NO_EXCEPTION());
+  Node* second = c->firstChild()->nextSibling();
+  EXPECT_TRUE(context->IsDeferredWrapper(second));
+
+  // The Members between the paragraphs were set while the paragraphs had no JS object. Once the subtree leaves the
+  // document the GC frees the paragraphs together, in any order.
+  const char* code = "document.getElementById('c').remove();";
+  bridge->evaluateScript(code, strlen(code), "vm://", 0);
+  EXPECT_FALSE(context->IsDeferredWrapper(second));
+  JS_RunGC(JS_GetRuntime(context->ctx()));
+
+  EXPECT_EQ(context->document()->body()->firstChild(), nullptr);
+  EXPECT_EQ(errorCalled, false);
+}
@@ -54,6 +54,22 @@ Touch::Touch(ExecutingContext* context, NativeTouch* native_touch)
       altitude_angle_(native_touch->altitudeAngle),
       azimuth_angle_(native_touch->azimuthAngle) {}
 
+void Touch::ReinitializeFromNative(NativeTouch* native_touch) {
+  identifier_ = native_touch->identifier;
+  clientX_ = native_touch->clientX;
+  clientY_ = native_touch->clientY;
+  screenX_ = native_touch->screenX;
+  screenY_ = native_touch->screenY;
+  pageX_ = native_touch->pageX;
+  pageY_ = native_touch->pageY;
+  radiusX_ = native_touch->radiusX;
+  radiusY_ = native_touch->radiusY;
+  rotationAngle_ = native_touch->rotationAngle;
+  force_ = native_touch->force;
+  altitude_angle_ = native_touch->altitudeAngle;
+  azimuth_angle_ = native_touch->azimuthAngle;
+}
+
 double Touch::altitudeAngle() const {
   return altitude_angle_;
 }
@@ -61,6 +61,9 @@ class Touch : public ScriptWrappable {
   double screenY() const;
   EventTarget* target() const;
 
+  // Takes the fields of |native_touch| the way the constructor does.
+  void ReinitializeFromNative(NativeTouch* native_touch);
+
   void Trace(GCVisitor* visitor) const override;
 
  private:
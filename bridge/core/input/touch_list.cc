@@ -3,6 +3,7 @@
  */
 
 #include "touch_list.h"
+#include <algorithm>
 #include "touch.h"
 
 namespace webf {
@@ -21,6 +22,26 @@ TouchList::TouchList(ExecutingContext* context, NativeTouchList* native_touch_li
   FromNativeTouchList(context, this, native_touch_list);
 }
 
+void TouchList::ReinitializeFromNative(ExecutingContext* context, NativeTouchList* native_touch_list) {
+  MemberMutationScope mutation_scope{context};
+  size_t length = native_touch_list->length;
+  for (size_t i = length; i < values_.size(); i++) {
+    values_[i].Clear();
+  }
+  values_.resize(std::min(values_.size(), length));
+
+  for (size_t i = 0; i < length; i++) {
+    NativeTouch* native_touch = &native_touch_list->touches[i];
+    if (i == values_.size()) {
+      values_.emplace_back(Touch::Create(context, native_touch));
+    } else if (values_[i]->HasOneReference()) {
+      values_[i]->ReinitializeFromNative(native_touch);
+    } else {
+      values_[i] = Touch::Create(context, native_touch);
+    }
+  }
+}
+
 uint32_t TouchList::length() const {
   return values_.size();
 }
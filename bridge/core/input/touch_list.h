@@ -25,6 +25,10 @@ class TouchList : public ScriptWrappable {
   TouchList() = delete;
   explicit TouchList(ExecutingContext* context, NativeTouchList* native_touch_list);
 
+  // Takes the touches of |native_touch_list|, updating the Touch objects nobody else holds instead of creating new
+  // ones.
+  void ReinitializeFromNative(ExecutingContext* context, NativeTouchList* native_touch_list);
+
   uint32_t length() const;
   Touch* item(uint32_t index, ExceptionState& exception_state) const;
   bool SetItem(uint32_t index, Touch* touch, ExceptionState& exception_state);
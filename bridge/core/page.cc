@@ -11,6 +11,7 @@
 #include "core/dom/document.h"
 #include "core/frame/window.h"
 #include "core/html/html_html_element.h"
+#include "core/html/parser/html_document_parser.h"
 #include "core/html/parser/html_parser.h"
 #include "event_factory.h"
 #include "foundation/logging.h"
@@ -39,6 +40,9 @@ WebFPage::WebFPage(int32_t contextId,
       this, dart_methods, dart_methods_length);
 }
 
+// Below this size, handing the document to a parser thread costs more than it saves.
+constexpr size_t kOffThreadParseThreshold = 512 * 1024;
+
 bool WebFPage::parseHTML(const char* code, size_t length) {
   if (!context_->IsContextValid())
     return false;
@@ -50,11 +54,45 @@ bool WebFPage::parseHTML(const char* code, size_t length) {
     return false;
   }
 
-  HTMLParser::parseHTML(code, length, context_->document()->documentElement());
+  // A new document replaces the one which is still streaming.
+  document_parser_ = nullptr;
+  if (length >= kOffThreadParseThreshold) {
+    HTMLParser::parseHTMLOffThread(std::string_view(code, length), document_element);
+  } else {
+    HTMLParser::parseHTML(code, length, document_element);
+  }
 
   return true;
 }
 
+bool WebFPage::parseHTMLChunk(const char* code, size_t length) {
+  if (!context_->IsContextValid())
+    return false;
+
+  MemberMutationScope scope{context_};
+
+  if (document_parser_ == nullptr) {
+    auto document_element = context_->document()->documentElement();
+    if (!document_element) {
+      return false;
+    }
+    document_parser_ = std::make_unique<HTMLDocumentParser>(document_element);
+  }
+
+  document_parser_->AppendChunk(code, length);
+  return true;
+}
+
+bool WebFPage::finishParseHTML() {
+  if (!context_->IsContextValid() || document_parser_ == nullptr)
+    return false;
+
+  MemberMutationScope scope{context_};
+  document_parser_->Finish();
+  document_parser_ = nullptr;
+  return true;
+}
+
 NativeValue* WebFPage::invokeModuleEvent(const NativeString* native_module_name,
                                          const char* eventType,
                                          void* ptr,
@@ -148,6 +186,10 @@ WebFPage::~WebFPage() {
     disposeCallback(this);
   }
 #endif
+  if (document_parser_ != nullptr) {
+    MemberMutationScope scope{context_};
+    document_parser_ = nullptr;
+  }
   delete context_;
   WebFPage::pageContextPool[contextId] = nullptr;
 }
@@ -9,6 +9,7 @@
 #include <quickjs/quickjs.h>
 #include <atomic>
 #include <deque>
+#include <memory>
 #include <thread>
 #include <vector>
 
@@ -18,6 +19,7 @@
 namespace webf {
 
 class WebFPage;
+class HTMLDocumentParser;
 
 using JSBridgeDisposeCallback = void (*)(WebFPage* bridge);
 using ConsoleMessageHandler = std::function<void(void* ctx, const std::string& message, int logLevel)>;
@@ -45,6 +47,9 @@ class WebFPage final {
   void evaluateScript(const NativeString* script, const char* url, int startLine);
   void evaluateScript(const uint16_t* script, size_t length, const char* url, int startLine);
   bool parseHTML(const char* code, size_t length);
+  // Parse a document which arrives in chunks, nodes are attached as soon as the chunks allow.
+  bool parseHTMLChunk(const char* code, size_t length);
+  bool finishParseHTML();
   void evaluateScript(const char* script, size_t length, const char* url, int startLine);
   uint8_t* dumpByteCode(const char* script, size_t length, const char* url, size_t* byteLength);
   void evaluateByteCode(uint8_t* bytes, size_t byteLength);
@@ -72,6 +77,7 @@ class WebFPage final {
   // maintainable.
   ExecutingContext* context_;
   JSExceptionHandler handler_;
+  std::unique_ptr<HTMLDocumentParser> document_parser_;
 };
 
 }  // namespace webf
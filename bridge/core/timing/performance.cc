@@ -47,6 +47,60 @@ AtomicString Performance::___webf_navigation_summary__(ExceptionState& exception
   return AtomicString::Empty();
 }
 
+ScriptValue Performance::___webf_ui_command_stats__(ExceptionState& exception_state) const {
+  // In the order of UICommand.
+  static const char* command_names[] = {"createElement",   "createTextNode",  "createComment",
+                                        "createDocument",  "createWindow",    "disposeEventTarget",
+                                        "addEvent",        "removeNode",      "insertAdjacentNode",
+                                        "setStyle",        "setAttribute",    "removeAttribute",
+                                        "cloneNode",       "removeEvent",     "createDocumentFragment",
+                                        "createPerformance", "setStyleBatch",  "instantiateFragment",
+                                        "disposeFragmentTemplate"};
+  static_assert(sizeof(command_names) / sizeof(command_names[0]) ==
+                    static_cast<int>(UICommand::kDisposeFragmentTemplate) + 1,
+                "Every UICommand type should be named.");
+
+  const UICommandStats& stats = GetExecutingContext()->uiCommandBuffer()->stats();
+  JSValue object = JS_NewObject(ctx());
+
+  JSValue commands = JS_NewObject(ctx());
+  for (size_t i = 0; i < sizeof(command_names) / sizeof(command_names[0]); i++) {
+    JS_SetPropertyStr(ctx(), commands, command_names[i], Converter<IDLInt64>::ToValue(ctx(), stats.command_counts[i]));
+  }
+  JS_SetPropertyStr(ctx(), object, "commands", commands);
+  JS_SetPropertyStr(ctx(), object, "stringBytes", Converter<IDLInt64>::ToValue(ctx(), stats.string_bytes));
+
+  JSValue flushes = JS_NewObject(ctx());
+  JS_SetPropertyStr(ctx(), flushes, "frame", Converter<IDLInt64>::ToValue(ctx(), stats.frame_flushes));
+  JS_SetPropertyStr(ctx(), flushes, "syncBinding", Converter<IDLInt64>::ToValue(ctx(), stats.sync_binding_flushes));
+  JS_SetPropertyStr(ctx(), flushes, "segmentFull", Converter<IDLInt64>::ToValue(ctx(), stats.segment_full_flushes));
+  JS_SetPropertyStr(ctx(), object, "flushes", flushes);
+
+  // Index i counts flushes took less than 2^i microseconds.
+  JSValue histogram = JS_NewArray(ctx());
+  for (uint32_t i = 0; i < UI_COMMAND_FLUSH_LATENCY_BUCKETS; i++) {
+    JS_SetPropertyUint32(ctx(), histogram, i, Converter<IDLInt64>::ToValue(ctx(), stats.flush_latency_histogram[i]));
+  }
+  JS_SetPropertyStr(ctx(), object, "flushLatencyHistogram", histogram);
+
+  ScriptValue result = ScriptValue(ctx(), object);
+  JS_FreeValue(ctx(), object);
+  return result;
+}
+
+ScriptValue Performance::___webf_event_coalescing_stats__(ExceptionState& exception_state) const {
+  const EventCoalescingStats& stats = GetExecutingContext()->eventCoalescer()->stats();
+  JSValue object = JS_NewObject(ctx());
+  JS_SetPropertyStr(ctx(), object, "queued", Converter<IDLInt64>::ToValue(ctx(), stats.queued));
+  JS_SetPropertyStr(ctx(), object, "dispatched", Converter<IDLInt64>::ToValue(ctx(), stats.dispatched));
+  JS_SetPropertyStr(ctx(), object, "merged", Converter<IDLInt64>::ToValue(ctx(), stats.merged));
+  JS_SetPropertyStr(ctx(), object, "dropped", Converter<IDLInt64>::ToValue(ctx(), stats.dropped));
+
+  ScriptValue result = ScriptValue(ctx(), object);
+  JS_FreeValue(ctx(), object);
+  return result;
+}
+
 std::vector<Member<PerformanceEntry>> Performance::getEntries(ExceptionState& exception_state) {
   return entries_;
 }
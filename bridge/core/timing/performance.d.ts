@@ -4,6 +4,8 @@ import {PerformanceMeasureOptions} from "./performance_measure_options";
 interface Performance {
   now(): int64;
   __webf_navigation_summary__(): string;
+  __webf_ui_command_stats__(): any;
+  __webf_event_coalescing_stats__(): any;
   toJSON(): any;
 
   getEntries(): PerformanceEntry[];
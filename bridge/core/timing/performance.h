@@ -34,6 +34,8 @@ class Performance : public ScriptWrappable {
   int64_t timeOrigin() const;
   ScriptValue toJSON(ExceptionState& exception_state) const;
   AtomicString ___webf_navigation_summary__(ExceptionState& exception_state) const;
+  ScriptValue ___webf_ui_command_stats__(ExceptionState& exception_state) const;
+  ScriptValue ___webf_event_coalescing_stats__(ExceptionState& exception_state) const;
   std::vector<Member<PerformanceEntry>> getEntries(ExceptionState& exception_state);
   std::vector<Member<PerformanceEntry>> getEntriesByType(const AtomicString& entry_type,
                                                          ExceptionState& exception_state);
@@ -209,3 +209,45 @@ setTimeout(() => {
   EXPECT_EQ(errorCalled, false);
   EXPECT_EQ(logCalled, true);
 }
+
+TEST(Performance, uiCommandStats) {
+  bool static errorCalled = false;
+  bool static logCalled = false;
+  webf::WebFPage::consoleMessageHandler = [](void* ctx, const std::string& message, int logLevel) {
+    logCalled = true;
+    EXPECT_STREQ(message.c_str(), "2 1 true 20");
+  };
+  auto bridge = TEST_init([](int32_t contextId, const char* errmsg) {
+    WEBF_LOG(VERBOSE) << errmsg;
+    errorCalled = true;
+  });
+  bridge->GetExecutingContext()->uiCommandBuffer()->resetStats();
+  const char* code =
+      "document.createElement('div');"
+      "document.createElement('p').setAttribute('id', 'hello');"
+      "let stats = performance.__webf_ui_command_stats__();"
+      "console.log(stats.commands.createElement, stats.commands.setAttribute, stats.stringBytes > 0, "
+      "stats.flushLatencyHistogram.length);";
+  bridge->evaluateScript(code, strlen(code), "vm://", 0);
+  EXPECT_EQ(errorCalled, false);
+  EXPECT_EQ(logCalled, true);
+}
+
+TEST(Performance, eventCoalescingStats) {
+  bool static errorCalled = false;
+  bool static logCalled = false;
+  webf::WebFPage::consoleMessageHandler = [](void* ctx, const std::string& message, int logLevel) {
+    logCalled = true;
+    EXPECT_STREQ(message.c_str(), "0 0 0 0");
+  };
+  auto bridge = TEST_init([](int32_t contextId, const char* errmsg) {
+    WEBF_LOG(VERBOSE) << errmsg;
+    errorCalled = true;
+  });
+  const char* code =
+      "let stats = performance.__webf_event_coalescing_stats__();"
+      "console.log(stats.queued, stats.dispatched, stats.merged, stats.dropped);";
+  bridge->evaluateScript(code, strlen(code), "vm://", 0);
+  EXPECT_EQ(errorCalled, false);
+  EXPECT_EQ(logCalled, true);
+}
@@ -0,0 +1,74 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef BRIDGE_FOUNDATION_SPSC_QUEUE_H_
+#define BRIDGE_FOUNDATION_SPSC_QUEUE_H_
+
+#include <atomic>
+#include <cstddef>
+#include "foundation/macros.h"
+
+namespace webf {
+
+// A bounded lock-free queue for exactly one producer thread and one consumer thread.
+// Push() must only be called from the producer and Pop() only from the consumer.
+// Capacity must be a power of two, one slot is never used to tell a full queue from an empty one.
+template <typename T, size_t Capacity>
+class SPSCQueue {
+  static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two.");
+
+ public:
+  SPSCQueue() = default;
+  WEBF_DISALLOW_COPY_AND_ASSIGN(SPSCQueue);
+
+  // Return false when the queue is full.
+  bool Push(const T& value) {
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    size_t next = (tail + 1) & kMask;
+    if (next == head_cache_) {
+      head_cache_ = head_.load(std::memory_order_acquire);
+      if (next == head_cache_)
+        return false;
+    }
+    slots_[tail] = value;
+    tail_.store(next, std::memory_order_release);
+    return true;
+  }
+
+  // Return false when the queue is empty.
+  bool Pop(T& value) {
+    size_t head = head_.load(std::memory_order_relaxed);
+    if (head == tail_cache_) {
+      tail_cache_ = tail_.load(std::memory_order_acquire);
+      if (head == tail_cache_)
+        return false;
+    }
+    value = slots_[head];
+    head_.store((head + 1) & kMask, std::memory_order_release);
+    return true;
+  }
+
+  // Approximate when called while the other side is running.
+  // Only meaningful on the producer thread, the consumer may make room at any time.
+  bool Full() const {
+    return ((tail_.load(std::memory_order_relaxed) + 1) & kMask) == head_.load(std::memory_order_acquire);
+  }
+
+  bool Empty() const { return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire); }
+
+ private:
+  static constexpr size_t kMask = Capacity - 1;
+  static constexpr size_t kCacheLineSize = 64;
+
+  // The consumer side and the producer side are kept in different cache lines to avoid false sharing.
+  alignas(kCacheLineSize) std::atomic<size_t> head_{0};
+  size_t tail_cache_{0};
+  alignas(kCacheLineSize) std::atomic<size_t> tail_{0};
+  size_t head_cache_{0};
+  alignas(kCacheLineSize) T slots_[Capacity];
+};
+
+}  // namespace webf
+
+#endif  // BRIDGE_FOUNDATION_SPSC_QUEUE_H_
@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "spsc_queue.h"
+#include <thread>
+#include "gtest/gtest.h"
+
+using namespace webf;
+
+TEST(SPSCQueue, pushAndPopInOrder) {
+  SPSCQueue<int, 4> queue;
+  EXPECT_EQ(queue.Empty(), true);
+  EXPECT_EQ(queue.Push(1), true);
+  EXPECT_EQ(queue.Push(2), true);
+  EXPECT_EQ(queue.Push(3), true);
+  // One slot is kept empty.
+  EXPECT_EQ(queue.Push(4), false);
+
+  int value;
+  EXPECT_EQ(queue.Pop(value), true);
+  EXPECT_EQ(value, 1);
+  EXPECT_EQ(queue.Push(4), true);
+  for (int expected = 2; expected <= 4; expected++) {
+    EXPECT_EQ(queue.Pop(value), true);
+    EXPECT_EQ(value, expected);
+  }
+  EXPECT_EQ(queue.Pop(value), false);
+  EXPECT_EQ(queue.Empty(), true);
+}
+
+TEST(SPSCQueue, stressProducerAndConsumer) {
+  const int64_t count = 1000000;
+  SPSCQueue<int64_t, 64> queue;
+
+  int64_t mismatches = 0;
+  std::thread consumer([&]() {
+    int64_t value;
+    for (int64_t expected = 0; expected < count;) {
+      if (!queue.Pop(value)) {
+        std::this_thread::yield();
+        continue;
+      }
+      if (value != expected) {
+        mismatches++;
+      }
+      expected++;
+    }
+  });
+
+  for (int64_t i = 0; i < count; i++) {
+    while (!queue.Push(i)) {
+      std::this_thread::yield();
+    }
+  }
+  consumer.join();
+  EXPECT_EQ(mismatches, 0);
+}
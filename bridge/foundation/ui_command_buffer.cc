@@ -4,6 +4,9 @@
  */
 
 #include "ui_command_buffer.h"
+#include <algorithm>
+#include <cstring>
+#include <thread>
 #include "core/dart_methods.h"
 #include "core/executing_context.h"
 #include "foundation/logging.h"
@@ -11,6 +14,25 @@
 
 namespace webf {
 
+namespace {
+
+bool AffectsLayout(UICommand type) {
+  switch (type) {
+    case UICommand::kRemoveNode:
+    case UICommand::kInsertAdjacentNode:
+    case UICommand::kSetStyle:
+    case UICommand::kSetStyleBatch:
+    case UICommand::kSetAttribute:
+    case UICommand::kRemoveAttribute:
+    case UICommand::kInstantiateFragment:
+      return true;
+    default:
+      return false;
+  }
+}
+
+}  // namespace
+
 UICommandBuffer::UICommandBuffer(ExecutingContext* context) : context_(context) {}
 
 UICommandBuffer::~UICommandBuffer() {
@@ -20,17 +42,97 @@ UICommandBuffer::~UICommandBuffer() {
     context_->dartMethodPtr()->flushUICommand(context_->contextId());
   }
 #endif
+
+  // The consumer had stopped polling, segments never consumed are dropped along with the reusable ones.
+  UICommandPublishedSegment* published;
+  while (published_segments_.Pop(published)) {
+    delete published;
+  }
+  while (released_segments_.Pop(published)) {
+    delete published;
+  }
+}
+
+void UICommandBatch::add(const UICommandItem& item) {
+  if (segment_count_ == 0 || segments_[segment_count_ - 1]->size == UI_COMMAND_SEGMENT_SIZE) {
+    if (segment_count_ == static_cast<int64_t>(segments_.size())) {
+      segments_.emplace_back(std::make_unique<UICommandSegment>());
+    }
+    segments_[segment_count_]->size = 0;
+    segment_count_++;
+  }
+
+  UICommandSegment* segment = segments_[segment_count_ - 1].get();
+  segment->items[segment->size] = item;
+  segment->size++;
+  size_++;
+}
+
+void UICommandBatch::compact(const std::vector<bool>& removed) {
+  int64_t new_size = 0;
+  for (int64_t i = 0; i < size_; i++) {
+    if (removed[i])
+      continue;
+    if (new_size != i) {
+      item(new_size) = item(i);
+    }
+    new_size++;
+  }
+
+  segment_count_ = (new_size + UI_COMMAND_SEGMENT_SIZE - 1) / UI_COMMAND_SEGMENT_SIZE;
+  for (int64_t i = 0; i < segment_count_; i++) {
+    segments_[i]->size = std::min<int64_t>(new_size - i * UI_COMMAND_SEGMENT_SIZE, UI_COMMAND_SEGMENT_SIZE);
+  }
+  size_ = new_size;
+}
+
+UICommandSegment* UICommandBatch::segment(int64_t index) {
+  if (index < 0 || index >= segment_count_)
+    return nullptr;
+  return segments_[index].get();
+}
+
+void UICommandBatch::clear() {
+  // All strings are owned by the arena, items beyond segment size are never read by dart side.
+  if (segments_.size() > MAXIMUM_REUSABLE_UI_COMMAND_SEGMENTS) {
+    segments_.resize(MAXIMUM_REUSABLE_UI_COMMAND_SEGMENTS);
+  }
+  segment_count_ = 0;
+  size_ = 0;
+  strings_.Reset();
+}
+
+void UICommandBatch::publishTo(UICommandPublishedSegment* published) {
+  assert(segment_count_ == 1);
+  std::swap(segments_[0], published->segment);
+  if (segments_[0] == nullptr) {
+    segments_[0] = std::make_unique<UICommandSegment>();
+  }
+  strings_.Swap(published->arena);
+  strings_.Reset();
+  segment_count_ = 0;
+  size_ = 0;
+
+  published->items = published->segment->items;
+  published->size = published->segment->size;
+  published->strings = published->arena.data();
 }
 
 void UICommandBuffer::addCommand(int32_t id, UICommand type, void* nativePtr) {
-  UICommandItem item{id, static_cast<int32_t>(type), nativePtr};
-  addCommand(item);
+  if (UNLIKELY(instantiating_fragment_) && isInstantiatedTarget(id, type, -1))
+    return;
+  prepareCommand(id, type, nullptr);
+  pending()->add(UICommandItem{id, static_cast<int32_t>(type), nativePtr});
 }
 
 void UICommandBuffer::addCommand(int32_t id, UICommand type, std::unique_ptr<NativeString>&& args_01, void* nativePtr) {
   assert(args_01 != nullptr);
-  UICommandItem item{id, static_cast<int32_t>(type), args_01.release(), nativePtr};
-  addCommand(item);
+  if (UNLIKELY(instantiating_fragment_) && isInstantiatedTarget(id, type, -1))
+    return;
+  prepareCommand(id, type, args_01.get());
+  int64_t string_01 = appendString(args_01.get());
+  pending()->add(
+      UICommandItem{id, static_cast<int32_t>(type), string_01, static_cast<int32_t>(args_01->length()), nativePtr});
 }
 
 void UICommandBuffer::addCommand(int32_t id,
@@ -40,20 +142,180 @@ void UICommandBuffer::addCommand(int32_t id,
                                  void* nativePtr) {
   assert(args_01 != nullptr);
   assert(args_02 != nullptr);
-  UICommandItem item{id, static_cast<int32_t>(type), args_01.release(), args_02.release(), nativePtr};
-  addCommand(item);
+  if (UNLIKELY(instantiating_fragment_) && isInstantiatedTarget(id, type, -1))
+    return;
+  prepareCommand(id, type, args_01.get());
+  int64_t string_01 = appendString(args_01.get());
+  int64_t string_02 = appendString(args_02.get());
+  pending()->add(UICommandItem{id,
+                               static_cast<int32_t>(type),
+                               string_01,
+                               static_cast<int32_t>(args_01->length()),
+                               string_02,
+                               static_cast<int32_t>(args_02->length()),
+                               nativePtr});
+}
+
+void UICommandBuffer::addCommand(int32_t id, UICommand type, int64_t node_id, void* nativePtr) {
+  if (UNLIKELY(instantiating_fragment_) && isInstantiatedTarget(id, type, node_id))
+    return;
+  prepareCommand(id, type, nullptr);
+  pending()->add(
+      UICommandItem{id, static_cast<int32_t>(type), node_id, UICommandInsertPosition::kBeforeBegin, nativePtr});
+}
+
+void UICommandBuffer::addCommand(int32_t id,
+                                 UICommand type,
+                                 int64_t node_id,
+                                 UICommandInsertPosition position,
+                                 void* nativePtr) {
+  if (UNLIKELY(instantiating_fragment_) && isInstantiatedTarget(id, type, node_id))
+    return;
+  prepareCommand(id, type, nullptr);
+  pending()->add(UICommandItem{id, static_cast<int32_t>(type), node_id, position, nativePtr});
 }
 
-void UICommandBuffer::addCommand(const UICommandItem& item) {
-  if (size_ >= MAXIMUM_UI_COMMAND_SIZE) {
-    if (UNLIKELY(isDartHotRestart())) {
-      clear();
-    } else {
-      context_->FlushUICommand();
+void UICommandBuffer::addStyleProperty(int32_t id,
+                                       std::unique_ptr<NativeString>&& key,
+                                       std::unique_ptr<NativeString>&& value) {
+  assert(key != nullptr);
+  assert(value != nullptr);
+  if (UNLIKELY(instantiating_fragment_) && isInstantiatedTarget(id, UICommand::kSetStyle, -1))
+    return;
+  requestBatchUpdate();
+  layout_generation_++;
+
+  auto it = pending_styles_.find(id);
+  if (it == pending_styles_.end()) {
+    it = pending_styles_.emplace(id, std::vector<PendingStyleProperty>()).first;
+    pending_style_targets_.emplace_back(id);
+  }
+
+  int64_t value_offset = pending_style_strings_.Append(value->string(), value->length());
+  auto value_length = static_cast<int32_t>(value->length());
+
+  // Only the last value of a property is sent.
+  for (PendingStyleProperty& property : it->second) {
+    if (property.key_length == static_cast<int32_t>(key->length()) &&
+        memcmp(pending_style_strings_.data() + property.key, key->string(), key->length() * sizeof(uint16_t)) == 0) {
+      property.value = value_offset;
+      property.value_length = value_length;
+      return;
     }
-    assert(size_ == 0);
   }
 
+  int64_t key_offset = pending_style_strings_.Append(key->string(), key->length());
+  it->second.emplace_back(
+      PendingStyleProperty{key_offset, static_cast<int32_t>(key->length()), value_offset, value_length});
+}
+
+void UICommandBuffer::addInstantiateFragmentCommand(int32_t parent_id,
+                                                    int64_t template_id,
+                                                    const std::vector<uint16_t>* description,
+                                                    const std::vector<UICommandFragmentNode>& nodes) {
+  prepareCommand(parent_id, UICommand::kInstantiateFragment, nullptr);
+  UICommandStringArena& strings = pending()->strings();
+
+  int64_t nodes_offset = static_cast<int64_t>(strings.size());
+  for (const UICommandFragmentNode& node : nodes) {
+    auto id = static_cast<uint32_t>(node.id);
+    auto native_ptr = static_cast<uint64_t>(reinterpret_cast<uintptr_t>(node.native_ptr));
+    uint16_t units[6] = {static_cast<uint16_t>(id),         static_cast<uint16_t>(id >> 16),
+                         static_cast<uint16_t>(native_ptr), static_cast<uint16_t>(native_ptr >> 16),
+                         static_cast<uint16_t>(native_ptr >> 32), static_cast<uint16_t>(native_ptr >> 48)};
+    strings.Append(units, 6);
+  }
+  auto nodes_length = static_cast<int32_t>(static_cast<int64_t>(strings.size()) - nodes_offset);
+
+  int64_t description_offset = UI_COMMAND_NO_STRING;
+  int32_t description_length = 0;
+  if (description != nullptr) {
+    description_offset = strings.Append(description->data(), description->size());
+    description_length = static_cast<int32_t>(description->size());
+  }
+
+  UICommandItem item{parent_id,
+                     static_cast<int32_t>(UICommand::kInstantiateFragment),
+                     nodes_offset,
+                     nodes_length,
+                     description_offset,
+                     description_length,
+                     nullptr};
+  item.node_id = template_id;
+  pending()->add(item);
+  stats_.string_bytes += (nodes_length + description_length) * sizeof(uint16_t);
+}
+
+void UICommandBuffer::beginFragmentInstantiation() {
+  assert(!instantiating_fragment_);
+  instantiating_fragment_ = true;
+}
+
+void UICommandBuffer::expectInstantiatedTarget() {
+  assert(instantiating_fragment_ && !expecting_instantiated_target_);
+  expecting_instantiated_target_ = true;
+}
+
+void UICommandBuffer::endFragmentInstantiation() {
+  assert(!expecting_instantiated_target_);
+  instantiating_fragment_ = false;
+  instantiated_targets_.clear();
+}
+
+bool UICommandBuffer::isInstantiatedTarget(int32_t id, UICommand type, int64_t node_id) {
+  // Nodes of the fragment may be disposed, their bindings are released like the others.
+  if (type == UICommand::kDisposeEventTarget)
+    return false;
+  // A node records its create command first thing in its constructor, before it could create any other target.
+  if (expecting_instantiated_target_ &&
+      (type == UICommand::kCreateElement || type == UICommand::kCreateTextNode || type == UICommand::kCreateComment)) {
+    expecting_instantiated_target_ = false;
+    instantiated_targets_.insert(id);
+    return true;
+  }
+  return instantiated_targets_.count(id) > 0 ||
+         (node_id >= 0 && instantiated_targets_.count(static_cast<int32_t>(node_id)) > 0);
+}
+
+// Must be called before appending the strings of a command, so that the strings and the command always end up in the
+// same segment when segments are published.
+void UICommandBuffer::prepareCommand(int32_t id, UICommand type, const NativeString* args_01) {
+  requestBatchUpdate();
+  stats_.command_counts[static_cast<int32_t>(type)]++;
+  if (AffectsLayout(type)) {
+    layout_generation_++;
+  }
+
+  if (UNLIKELY(!pending_styles_.empty()) && pending_styles_.count(id) > 0 && observesPendingStyles(type, args_01)) {
+    flushPendingStyles(id);
+  }
+
+  ensureSegmentSpace();
+}
+
+int64_t UICommandBuffer::appendString(const NativeString* string) {
+  stats_.string_bytes += string->length() * sizeof(uint16_t);
+  return pending()->strings().Append(string->string(), string->length());
+}
+
+void UICommandBuffer::ensureSegmentSpace() {
+  int64_t size = pending()->size();
+  if (size == 0 || size % UI_COMMAND_SEGMENT_SIZE != 0)
+    return;
+
+  // Nothing drains the buffer while dart side hot restarts, drop the commands instead of growing without bound.
+  if (UNLIKELY(isDartHotRestart())) {
+    pending()->clear();
+    return;
+  }
+
+  // Once a segment could not be published, the batch grows until acquire() hands it over.
+  if (UNLIKELY(publishing_enabled_) && size == UI_COMMAND_SEGMENT_SIZE && publishPendingSegment()) {
+    stats_.RecordFlush(UICommandFlushReason::kSegmentFull);
+  }
+}
+
+void UICommandBuffer::requestBatchUpdate() {
 #if FLUTTER_BACKEND
   if (UNLIKELY(!update_batched_ && context_->IsContextValid() &&
                context_->dartMethodPtr()->requestBatchUpdate != nullptr)) {
@@ -61,31 +323,155 @@ void UICommandBuffer::addCommand(const UICommandItem& item) {
     update_batched_ = true;
   }
 #endif
+}
 
-  buffer_[size_] = item;
-  size_++;
+bool UICommandBuffer::observesPendingStyles(UICommand type, const NativeString* args_01) {
+  // Dart side recalculates inline styles after all the commands of a flush, so only the style attribute, cloning and
+  // disposing need the declarations recorded before them.
+  if (type == UICommand::kSetAttribute || type == UICommand::kRemoveAttribute) {
+    static const char16_t kStyleAttribute[] = u"style";
+    const uint32_t style_attribute_length = 5;
+    return args_01 != nullptr && args_01->length() == style_attribute_length &&
+           memcmp(args_01->string(), kStyleAttribute, style_attribute_length * sizeof(uint16_t)) == 0;
+  }
+  return type == UICommand::kCloneNode || type == UICommand::kDisposeEventTarget;
 }
 
-UICommandItem* UICommandBuffer::data() {
-  return buffer_;
+void UICommandBuffer::flushPendingStyles(int32_t id) {
+  auto it = pending_styles_.find(id);
+  if (it == pending_styles_.end())
+    return;
+
+  ensureSegmentSpace();
+  UICommandStringArena& strings = pending()->strings();
+  int64_t offset = static_cast<int64_t>(strings.size());
+  auto append_string = [&](int64_t string, int32_t length) {
+    uint16_t length_units[2] = {static_cast<uint16_t>(length & 0xffff), static_cast<uint16_t>(length >> 16)};
+    strings.Append(length_units, 2);
+    strings.Append(pending_style_strings_.data() + string, length);
+  };
+  for (const PendingStyleProperty& property : it->second) {
+    append_string(property.key, property.key_length);
+    append_string(property.value, property.value_length);
+  }
+
+  UICommandItem item{id,
+                     static_cast<int32_t>(UICommand::kSetStyleBatch),
+                     offset,
+                     static_cast<int32_t>(static_cast<int64_t>(strings.size()) - offset),
+                     UI_COMMAND_NO_STRING,
+                     static_cast<int32_t>(it->second.size()),
+                     nullptr};
+  pending()->add(item);
+  stats_.command_counts[static_cast<int32_t>(UICommand::kSetStyleBatch)]++;
+  stats_.string_bytes += item.args_01_length * sizeof(uint16_t);
+  pending_styles_.erase(it);
+
+  if (pending_styles_.empty()) {
+    pending_style_targets_.clear();
+    pending_style_strings_.Reset();
+  }
+}
+
+void UICommandBuffer::flushPendingStyles() {
+  // Targets flushed earlier by another command are skipped, keep the order of the first write for the rest.
+  for (size_t i = 0; i < pending_style_targets_.size() && !pending_styles_.empty(); i++) {
+    flushPendingStyles(pending_style_targets_[i]);
+  }
+  pending_style_targets_.clear();
+  pending_style_strings_.Reset();
+}
+
+void UICommandBuffer::setPublishingEnabled(bool enabled) {
+  assert(empty());
+  publishing_enabled_ = enabled;
+}
+
+bool UICommandBuffer::publish() {
+  assert(publishing_enabled_);
+  flushPendingStyles();
+  if (pending()->empty())
+    return true;
+  if (pending()->segmentCount() > 1 || !publishPendingSegment())
+    return false;
+
+  stats_.RecordFlush(flush_reason_);
+  flush_reason_ = UICommandFlushReason::kFrame;
+  return true;
+}
+
+bool UICommandBuffer::publishPendingSegment() {
+  // Back pressure, JS thread waits a little for the consumer when it falls too far behind, but never blocks on it.
+  if (UNLIKELY(published_segments_.Full())) {
+    auto deadline =
+        std::chrono::steady_clock::now() + std::chrono::microseconds(UI_COMMAND_PUBLISH_WAIT_MICROSECONDS);
+    while (published_segments_.Full()) {
+      if (std::chrono::steady_clock::now() >= deadline)
+        return false;
+      std::this_thread::yield();
+    }
+  }
+
+  UICommandPublishedSegment* published;
+  if (!released_segments_.Pop(published)) {
+    published = new UICommandPublishedSegment();
+  }
+  pending()->publishTo(published);
+  // Only this thread pushes, the room seen above is still there.
+  published_segments_.Push(published);
+  return true;
+}
+
+UICommandPublishedSegment* UICommandBuffer::poll() {
+  UICommandPublishedSegment* published;
+  if (!published_segments_.Pop(published))
+    return nullptr;
+  return published;
+}
+
+void UICommandBuffer::release(UICommandPublishedSegment* segment) {
+  if (!released_segments_.Push(segment)) {
+    delete segment;
+  }
+}
+
+UICommandBatch* UICommandBuffer::acquire() {
+  assert(acquired()->empty());
+  if (publishing_enabled_ && publish()) {
+    update_batched_ = false;
+    return acquired();
+  }
+
+  flushPendingStyles();
+  if (!pending()->empty()) {
+    stats_.RecordFlush(flush_reason_);
+    acquired_time_ = std::chrono::steady_clock::now();
+  }
+  flush_reason_ = UICommandFlushReason::kFrame;
+
+  if (coalescing_enabled_) {
+    coalescer_.Coalesce(pending());
+  }
+  pending_index_ = 1 - pending_index_;
+  update_batched_ = false;
+  return acquired();
 }
 
 int64_t UICommandBuffer::size() {
-  return size_;
+  return pending()->size() + static_cast<int64_t>(pending_styles_.size());
 }
 
 bool UICommandBuffer::empty() {
-  return size_ == 0;
+  return pending()->empty() && pending_styles_.empty();
 }
 
 void UICommandBuffer::clear() {
-  for (int i = 0; i < size_; i++) {
-    delete[] reinterpret_cast<const uint16_t*>(buffer_[i].string_01);
-    delete[] reinterpret_cast<const uint16_t*>(buffer_[i].string_02);
+  // Batches coalesced to nothing are counted as well, they had been flushed.
+  if (acquired_time_ != std::chrono::steady_clock::time_point()) {
+    stats_.RecordFlushLatency(std::chrono::steady_clock::now() - acquired_time_);
+    acquired_time_ = std::chrono::steady_clock::time_point();
   }
-  size_ = 0;
-  memset(buffer_, 0, sizeof(buffer_));
-  update_batched_ = false;
+  acquired()->clear();
 }
 
 }  // namespace webf
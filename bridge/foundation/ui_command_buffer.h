@@ -7,8 +7,16 @@
 #define BRIDGE_FOUNDATION_UI_COMMAND_BUFFER_H_
 
 #include <cinttypes>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 #include "bindings/qjs/native_string_utils.h"
 #include "native_value.h"
+#include "spsc_queue.h"
+#include "ui_command_coalescer.h"
+#include "ui_command_stats.h"
+#include "ui_command_string_arena.h"
 
 namespace webf {
 
@@ -31,39 +39,146 @@ enum class UICommand {
   kRemoveEvent,
   kCreateDocumentFragment,
   kCreatePerformance,
+  kSetStyleBatch,
+  kInstantiateFragment,
+  kDisposeFragmentTemplate,
 };
 
-#define MAXIMUM_UI_COMMAND_SIZE 2048
+static_assert(static_cast<int>(UICommand::kDisposeFragmentTemplate) < UI_COMMAND_STATS_TYPE_COUNT,
+              "UICommandStats can't hold all UICommand types.");
 
+// Where the node carried by UICommand::kInsertAdjacentNode is inserted, relative to the command target.
+enum class UICommandInsertPosition : int32_t {
+  kBeforeBegin,
+  kAfterBegin,
+  kBeforeEnd,
+  kAfterEnd,
+};
+
+// Commands are recorded into fixed size segments, a new segment is appended when the last one is full.
+#define UI_COMMAND_SEGMENT_SIZE 2048
+// Segments kept for reusing after a batch had been consumed, the rest of them are released.
+#define MAXIMUM_REUSABLE_UI_COMMAND_SEGMENTS 8
+
+// Offset of UICommandItem strings when the command didn't carry this argument.
+#define UI_COMMAND_NO_STRING (-1)
+
+// String arguments are stored in the UICommandStringArena owned by UICommandBuffer,
+// string_01 and string_02 are the offsets (in uint16_t units) of the arguments inside the arena.
+// Commands operating on another node (kInsertAdjacentNode, kCloneNode) carry its eventTargetId in node_id,
+// and kInsertAdjacentNode carries an UICommandInsertPosition in position.
+// kSetStyleBatch carries args_02_length declarations packed at string_01, args_01_length is the length of the
+// packed list. Each key and value is prefixed by its length, stored as two uint16_t units (low bits first).
+// kInstantiateFragment creates the nodes of the fragment template node_id and appends its top level nodes to the
+// command target, or leaves them without parent when the id is -1. string_01 holds args_01_length / 6 created nodes in
+// template order, each one as its eventTargetId in two units followed by its NativeBindingObject pointer in four
+// units, low bits first. string_02 holds the description of the template when dart side has not seen it before, see
+// HTMLFragmentTemplate, and is UI_COMMAND_NO_STRING otherwise.
+// kDisposeFragmentTemplate tells dart side that the template node_id is no longer used.
 struct UICommandItem {
   UICommandItem() = default;
-  UICommandItem(int32_t id, int32_t type, NativeString* args_01, NativeString* args_02, void* nativePtr)
+  UICommandItem(int32_t id,
+                int32_t type,
+                int64_t string_01,
+                int32_t args_01_length,
+                int64_t string_02,
+                int32_t args_02_length,
+                void* nativePtr)
       : type(type),
-        string_01(reinterpret_cast<int64_t>((new NativeString(args_01))->string())),
-        args_01_length(args_01->length()),
-        string_02(reinterpret_cast<int64_t>((new NativeString(args_02))->string())),
-        args_02_length(args_02->length()),
+        string_01(string_01),
+        args_01_length(args_01_length),
+        string_02(string_02),
+        args_02_length(args_02_length),
         id(id),
         nativePtr(reinterpret_cast<int64_t>(nativePtr)){};
-  UICommandItem(int32_t id, int32_t type, NativeString* args_01, void* nativePtr)
+  UICommandItem(int32_t id, int32_t type, int64_t string_01, int32_t args_01_length, void* nativePtr)
       : type(type),
-        string_01(reinterpret_cast<int64_t>((new NativeString(args_01))->string())),
-        args_01_length(args_01->length()),
+        string_01(string_01),
+        args_01_length(args_01_length),
         id(id),
         nativePtr(reinterpret_cast<int64_t>(nativePtr)){};
+  UICommandItem(int32_t id, int32_t type, int64_t node_id, UICommandInsertPosition position, void* nativePtr)
+      : type(type),
+        id(id),
+        nativePtr(reinterpret_cast<int64_t>(nativePtr)),
+        node_id(node_id),
+        position(static_cast<int64_t>(position)){};
   UICommandItem(int32_t id, int32_t type, void* nativePtr)
       : type(type), id(id), nativePtr(reinterpret_cast<int64_t>(nativePtr)){};
   int32_t type{0};
   int32_t id{0};
   int32_t args_01_length{0};
   int32_t args_02_length{0};
-  int64_t string_01{0};
-  int64_t string_02{0};
+  int64_t string_01{UI_COMMAND_NO_STRING};
+  int64_t string_02{UI_COMMAND_NO_STRING};
   int64_t nativePtr{0};
+  int64_t node_id{0};
+  int64_t position{0};
+};
+
+// A node created by kInstantiateFragment.
+struct UICommandFragmentNode {
+  int32_t id;
+  void* native_ptr;
+};
+
+struct UICommandSegment {
+  UICommandItem items[UI_COMMAND_SEGMENT_SIZE];
+  int64_t size{0};
+};
+
+// A completed segment published to the UI command consumer thread, with the strings referenced by its commands.
+// Consumers read items, size and strings only, the rest is owned by UICommandBuffer.
+struct UICommandPublishedSegment {
+  UICommandItem* items{nullptr};
+  int64_t size{0};
+  const uint16_t* strings{nullptr};
+  std::unique_ptr<UICommandSegment> segment;
+  UICommandStringArena arena;
+};
+
+// All the commands recorded between two flushes, and the strings referenced by them.
+class UICommandBatch {
+ public:
+  UICommandBatch() = default;
+  WEBF_DISALLOW_COPY_AND_ASSIGN(UICommandBatch);
+
+  void add(const UICommandItem& item);
+  // Access commands across segments by the index in the batch.
+  FORCE_INLINE UICommandItem& item(int64_t index) {
+    return segments_[index / UI_COMMAND_SEGMENT_SIZE]->items[index % UI_COMMAND_SEGMENT_SIZE];
+  }
+  // Remove the commands marked in removed and keep the order of the rest.
+  void compact(const std::vector<bool>& removed);
+  UICommandSegment* segment(int64_t index);
+  FORCE_INLINE int64_t segmentCount() const { return segment_count_; }
+  FORCE_INLINE int64_t size() const { return size_; }
+  FORCE_INLINE bool empty() const { return size_ == 0; }
+  FORCE_INLINE UICommandStringArena& strings() { return strings_; }
+  FORCE_INLINE const UICommandStringArena& strings() const { return strings_; }
+  void clear();
+  // Move the only segment and the strings of this batch to published, the batch is empty afterwards.
+  void publishTo(UICommandPublishedSegment* published);
+
+ private:
+  std::vector<std::unique_ptr<UICommandSegment>> segments_;
+  // Segments in use, segments_ beyond this index are kept for reusing.
+  int64_t segment_count_{0};
+  int64_t size_{0};
+  UICommandStringArena strings_;
 };
 
 bool isDartHotRestart();
 
+// Published segments which are not consumed yet, the producer waits for the consumer when the queue is full.
+#define UI_COMMAND_PUBLISHED_QUEUE_SIZE 256
+// How long the producer waits for the consumer to make room in a full queue, before it keeps the commands in the
+// pending batch, which is then handed over by acquire() as when publishing is disabled.
+#define UI_COMMAND_PUBLISH_WAIT_MICROSECONDS 2000
+
+// UICommandBuffer is double buffered: the bridge records commands into the pending batch while dart side drains the
+// acquired one. The pending batch grows by segments, so large DOM builds are handed over to dart in one flush instead
+// of forcing a flush in the middle of script execution.
 class UICommandBuffer {
  public:
   UICommandBuffer() = delete;
@@ -76,18 +191,100 @@ class UICommandBuffer {
                   std::unique_ptr<NativeString>&& args_02,
                   void* nativePtr);
   void addCommand(int32_t id, UICommand type, std::unique_ptr<NativeString>&& args_01, void* nativePtr);
-  UICommandItem* data();
+  void addCommand(int32_t id, UICommand type, int64_t node_id, void* nativePtr);
+  void addCommand(int32_t id, UICommand type, int64_t node_id, UICommandInsertPosition position, void* nativePtr);
+  // Inline style declarations are accumulated per element and recorded as a single kSetStyleBatch command, which is
+  // emitted when the batch is acquired, or before a later command of the same element could observe the styles.
+  void addStyleProperty(int32_t id, std::unique_ptr<NativeString>&& key, std::unique_ptr<NativeString>&& value);
+  // Records kInstantiateFragment. |description| is null when dart side already has the template.
+  void addInstantiateFragmentCommand(int32_t parent_id,
+                                     int64_t template_id,
+                                     const std::vector<uint16_t>* description,
+                                     const std::vector<UICommandFragmentNode>& nodes);
+  // While the nodes of a fragment template are created, the commands which refer to these nodes are dropped, as
+  // kInstantiateFragment describes them. Each node is announced by expectInstantiatedTarget() right before it is
+  // created, the create command which follows gives its id. Other targets created meanwhile and disposals are
+  // recorded as usual.
+  void beginFragmentInstantiation();
+  void expectInstantiatedTarget();
+  void endFragmentInstantiation();
+  // Commands recorded since last acquire.
+  UICommandBatch* pending() { return &batches_[pending_index_]; }
+  // Hand over the pending commands to dart side and start recording into the other batch.
+  // The previous acquired batch should be cleared before.
+  UICommandBatch* acquire();
+  UICommandBatch* acquired() { return &batches_[1 - pending_index_]; }
+  // Coalesce the pending batch before handing over to dart side, disabled by default.
+  void setCoalescingEnabled(bool enabled) { coalescing_enabled_ = enabled; }
+  const UICommandCoalescingStats& coalescingStats() const { return coalescer_.stats(); }
+  // In publishing mode, every completed segment is published through a lock-free single-producer/single-consumer
+  // queue, so that a dedicated UI thread could apply the commands while JS keeps running. acquire() publishes the
+  // partially filled segment and hands over nothing, unless the consumer fell behind and the commands could not be
+  // published; the batch acquired then must be applied after the segments published before it. Should be switched
+  // when no commands are pending.
+  void setPublishingEnabled(bool enabled);
+  bool publishingEnabled() const { return publishing_enabled_; }
+  // Publish all the commands recorded so far, called on the JS thread. Return false when the consumer fell behind,
+  // the commands are left pending for acquire() then.
+  bool publish();
+  // Called on the consumer thread. Return nullptr when there is nothing published, every polled segment should be
+  // released after its commands were applied. The consumer must stop polling before the buffer is destroyed.
+  UICommandPublishedSegment* poll();
+  void release(UICommandPublishedSegment* segment);
   int64_t size();
   bool empty();
+  // Release the acquired batch after dart side consumed it.
   void clear();
+  // Bumped whenever a command which may change the layout is recorded, or dart side reports a new layout.
+  // Geometry read from dart side stays valid until the generation changes.
+  int64_t layoutGeneration() const { return layout_generation_; }
+  void invalidateLayout() { layout_generation_++; }
+  // The next acquire() or publish() is counted as a flush of this reason.
+  void setFlushReason(UICommandFlushReason reason) { flush_reason_ = reason; }
+  const UICommandStats& stats() const { return stats_; }
+  void resetStats() { stats_.Reset(); }
 
  private:
-  void addCommand(const UICommandItem& item);
+  struct PendingStyleProperty {
+    int64_t key;
+    int32_t key_length;
+    int64_t value;
+    int32_t value_length;
+  };
+
+  bool isInstantiatedTarget(int32_t id, UICommand type, int64_t node_id);
+  void prepareCommand(int32_t id, UICommand type, const NativeString* args_01);
+  int64_t appendString(const NativeString* string);
+  void ensureSegmentSpace();
+  bool publishPendingSegment();
+  void requestBatchUpdate();
+  bool observesPendingStyles(UICommand type, const NativeString* args_01);
+  void flushPendingStyles(int32_t id);
+  void flushPendingStyles();
 
   ExecutingContext* context_{nullptr};
-  UICommandItem buffer_[MAXIMUM_UI_COMMAND_SIZE];
+  UICommandBatch batches_[2];
+  int pending_index_{0};
   bool update_batched_{false};
-  int64_t size_{0};
+  bool coalescing_enabled_{false};
+  UICommandCoalescer coalescer_;
+  // Declarations waiting for kSetStyleBatch, their strings are kept aside until they are packed into the batch.
+  std::unordered_map<int32_t, std::vector<PendingStyleProperty>> pending_styles_;
+  std::vector<int32_t> pending_style_targets_;
+  UICommandStringArena pending_style_strings_;
+  bool publishing_enabled_{false};
+  UICommandStats stats_;
+  UICommandFlushReason flush_reason_{UICommandFlushReason::kFrame};
+  std::chrono::steady_clock::time_point acquired_time_;
+  int64_t layout_generation_{0};
+  // The nodes of the fragment being instantiated.
+  bool instantiating_fragment_{false};
+  bool expecting_instantiated_target_{false};
+  std::unordered_set<int32_t> instantiated_targets_;
+  // Published segments flow to the consumer through published_segments_ and come back through released_segments_
+  // for reusing, so neither side takes a lock.
+  SPSCQueue<UICommandPublishedSegment*, UI_COMMAND_PUBLISHED_QUEUE_SIZE> published_segments_;
+  SPSCQueue<UICommandPublishedSegment*, UI_COMMAND_PUBLISHED_QUEUE_SIZE> released_segments_;
 };
 
 }  // namespace webf
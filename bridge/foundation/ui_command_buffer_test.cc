@@ -0,0 +1,483 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "ui_command_buffer.h"
+#include <atomic>
+#include <thread>
+#include "gtest/gtest.h"
+#include "webf_test_env.h"
+
+using namespace webf;
+
+static std::string readCommandString(UICommandBatch* batch, int64_t offset, int32_t length) {
+  NativeString string{batch->strings().data() + offset, static_cast<uint32_t>(length)};
+  return nativeStringToStdString(&string);
+}
+
+static std::vector<std::pair<std::string, std::string>> readStyleBatch(UICommandBatch* batch,
+                                                                       const UICommandItem& item) {
+  std::vector<std::pair<std::string, std::string>> declarations;
+  int64_t offset = item.string_01;
+  auto read_string = [&]() {
+    const uint16_t* data = batch->strings().data();
+    int32_t length = data[offset] | (data[offset + 1] << 16);
+    std::string result = readCommandString(batch, offset + 2, length);
+    offset += 2 + length;
+    return result;
+  };
+  for (int32_t i = 0; i < item.args_02_length; i++) {
+    std::string key = read_string();
+    std::string value = read_string();
+    declarations.emplace_back(key, value);
+  }
+  EXPECT_EQ(offset, item.string_01 + item.args_01_length);
+  return declarations;
+}
+
+static void discardPendingCommands(UICommandBuffer* buffer) {
+  buffer->acquire();
+  buffer->clear();
+}
+
+TEST(UICommandBuffer, stringArgumentsAreStoredInArena) {
+  auto bridge = TEST_init();
+  auto* buffer = bridge->GetExecutingContext()->uiCommandBuffer();
+  discardPendingCommands(buffer);
+
+  const char* code =
+      "let div = document.createElement('div');"
+      "div.setAttribute('hello', 'world');"
+      "div.setAttribute('empty', '');";
+  bridge->evaluateScript(code, strlen(code), "vm://", 0);
+
+  UICommandBatch* batch = buffer->acquire();
+  EXPECT_EQ(batch->segmentCount(), 1);
+  UICommandSegment* segment = batch->segment(0);
+  bool create_element_found = false;
+  int set_attribute_count = 0;
+  for (int64_t i = 0; i < segment->size; i++) {
+    UICommandItem& item = segment->items[i];
+    if (item.type == static_cast<int32_t>(UICommand::kCreateElement)) {
+      create_element_found = true;
+      EXPECT_EQ(readCommandString(batch, item.string_01, item.args_01_length), "div");
+      EXPECT_EQ(item.string_02, UI_COMMAND_NO_STRING);
+    } else if (item.type == static_cast<int32_t>(UICommand::kSetAttribute)) {
+      std::string key = readCommandString(batch, item.string_01, item.args_01_length);
+      std::string value = readCommandString(batch, item.string_02, item.args_02_length);
+      if (set_attribute_count == 0) {
+        EXPECT_EQ(key, "hello");
+        EXPECT_EQ(value, "world");
+      } else {
+        EXPECT_EQ(key, "empty");
+        EXPECT_NE(item.string_02, UI_COMMAND_NO_STRING);
+        EXPECT_EQ(item.args_02_length, 0);
+      }
+      set_attribute_count++;
+    }
+  }
+  EXPECT_EQ(create_element_found, true);
+  EXPECT_EQ(set_attribute_count, 2);
+
+  buffer->clear();
+  EXPECT_EQ(batch->size(), 0);
+  EXPECT_EQ(batch->strings().size(), 0);
+}
+
+TEST(UICommandBuffer, arenaIsReusedAfterClear) {
+  auto bridge = TEST_init();
+  auto* buffer = bridge->GetExecutingContext()->uiCommandBuffer();
+  const char* code =
+      "for (let i = 0; i < 100; i ++) {"
+      "  document.createElement('div').setAttribute('id', 'item-' + i);"
+      "}";
+
+  // Run twice so that both of the batches had been used once.
+  for (int i = 0; i < 2; i++) {
+    bridge->evaluateScript(code, strlen(code), "vm://", 0);
+    discardPendingCommands(buffer);
+  }
+  int64_t allocation_count = buffer->pending()->strings().allocationCount();
+
+  bridge->evaluateScript(code, strlen(code), "vm://", 0);
+  EXPECT_GT(buffer->pending()->strings().appendCount(), 0);
+  EXPECT_EQ(buffer->pending()->strings().allocationCount(), allocation_count);
+}
+
+TEST(UICommandBuffer, growsBySegmentsWithoutFlush) {
+  auto bridge = TEST_init();
+  auto* buffer = bridge->GetExecutingContext()->uiCommandBuffer();
+  discardPendingCommands(buffer);
+
+  const char* code =
+      "let container = document.createElement('div');"
+      "for (let i = 0; i < 3000; i ++) {"
+      "  container.appendChild(document.createElement('div'));"
+      "}";
+  bridge->evaluateScript(code, strlen(code), "vm://", 0);
+
+  // 1 + 3000 createElement and 3000 insertAdjacentNode commands are kept without flushing.
+  EXPECT_EQ(buffer->size(), 6001);
+  UICommandBatch* batch = buffer->acquire();
+  EXPECT_EQ(batch->segmentCount(), 3);
+  EXPECT_EQ(batch->segment(0)->size, UI_COMMAND_SEGMENT_SIZE);
+  EXPECT_EQ(batch->segment(2)->size, 6001 - 2 * UI_COMMAND_SEGMENT_SIZE);
+  EXPECT_EQ(batch->segment(3), nullptr);
+
+  // New commands are recorded into the other batch while the acquired one is being read.
+  const char* next_code = "document.createElement('div');";
+  bridge->evaluateScript(next_code, strlen(next_code), "vm://", 0);
+  EXPECT_EQ(buffer->size(), 1);
+  EXPECT_EQ(batch->size(), 6001);
+  buffer->clear();
+  EXPECT_EQ(batch->size(), 0);
+}
+
+TEST(UICommandBuffer, insertAdjacentNodeCarriesNodeIdAndPosition) {
+  auto bridge = TEST_init();
+  auto* buffer = bridge->GetExecutingContext()->uiCommandBuffer();
+  discardPendingCommands(buffer);
+
+  const char* code =
+      "let container = document.createElement('div');"
+      "let first = document.createElement('span');"
+      "container.appendChild(first);"
+      "container.insertBefore(document.createElement('p'), first);";
+  bridge->evaluateScript(code, strlen(code), "vm://", 0);
+
+  UICommandBatch* batch = buffer->acquire();
+  UICommandSegment* segment = batch->segment(0);
+  std::vector<UICommandItem*> create_items;
+  std::vector<UICommandItem*> insert_items;
+  for (int64_t i = 0; i < segment->size; i++) {
+    UICommandItem& item = segment->items[i];
+    if (item.type == static_cast<int32_t>(UICommand::kCreateElement)) {
+      create_items.emplace_back(&item);
+    } else if (item.type == static_cast<int32_t>(UICommand::kInsertAdjacentNode)) {
+      insert_items.emplace_back(&item);
+      EXPECT_EQ(item.string_01, UI_COMMAND_NO_STRING);
+    }
+  }
+  ASSERT_EQ(create_items.size(), 3);
+  ASSERT_EQ(insert_items.size(), 2);
+
+  // container.appendChild(first)
+  EXPECT_EQ(insert_items[0]->id, create_items[0]->id);
+  EXPECT_EQ(insert_items[0]->node_id, create_items[1]->id);
+  EXPECT_EQ(insert_items[0]->position, static_cast<int64_t>(UICommandInsertPosition::kBeforeEnd));
+  // container.insertBefore(p, first)
+  EXPECT_EQ(insert_items[1]->id, create_items[1]->id);
+  EXPECT_EQ(insert_items[1]->node_id, create_items[2]->id);
+  EXPECT_EQ(insert_items[1]->position, static_cast<int64_t>(UICommandInsertPosition::kBeforeBegin));
+  buffer->clear();
+}
+
+TEST(UICommandBuffer, coalesceAttributeWrites) {
+  auto bridge = TEST_init();
+  auto* buffer = bridge->GetExecutingContext()->uiCommandBuffer();
+  discardPendingCommands(buffer);
+  buffer->setCoalescingEnabled(true);
+
+  const char* code =
+      "let div = document.createElement('div');"
+      "document.body.appendChild(div);"
+      "for (let i = 0; i < 100; i ++) {"
+      "  div.style.transform = 'translateX(' + i + 'px)';"
+      "  div.setAttribute('data-index', i);"
+      "  div.setAttribute('title', 'title-' + i);"
+      "}"
+      "div.removeAttribute('title');"
+      "div.style.color = 'red';";
+  bridge->evaluateScript(code, strlen(code), "vm://", 0);
+
+  UICommandBatch* batch = buffer->acquire();
+  int set_style_batch_count = 0;
+  int set_attribute_count = 0;
+  int remove_attribute_count = 0;
+  for (int64_t i = 0; i < batch->size(); i++) {
+    UICommandItem& item = batch->item(i);
+    if (item.type == static_cast<int32_t>(UICommand::kSetStyleBatch)) {
+      set_style_batch_count++;
+      auto declarations = readStyleBatch(batch, item);
+      ASSERT_EQ(declarations.size(), 2);
+      EXPECT_EQ(declarations[0].first, "transform");
+      EXPECT_EQ(declarations[0].second, "translateX(99px)");
+      EXPECT_EQ(declarations[1].first, "color");
+    } else if (item.type == static_cast<int32_t>(UICommand::kSetAttribute)) {
+      set_attribute_count++;
+      EXPECT_EQ(readCommandString(batch, item.string_01, item.args_01_length), "data-index");
+      EXPECT_EQ(readCommandString(batch, item.string_02, item.args_02_length), "99");
+    } else if (item.type == static_cast<int32_t>(UICommand::kRemoveAttribute)) {
+      remove_attribute_count++;
+      EXPECT_EQ(readCommandString(batch, item.string_01, item.args_01_length), "title");
+    }
+  }
+  // Style writes are merged before reaching the coalescer, only attributes are coalesced there.
+  EXPECT_EQ(set_style_batch_count, 1);
+  EXPECT_EQ(set_attribute_count, 1);
+  EXPECT_EQ(remove_attribute_count, 1);
+  EXPECT_EQ(buffer->coalescingStats().coalesced_writes, 199);
+  buffer->clear();
+}
+
+TEST(UICommandBuffer, dropTargetsCreatedAndDisposedInOneBatch) {
+  auto bridge = TEST_init();
+  auto* context = bridge->GetExecutingContext();
+  auto* buffer = context->uiCommandBuffer();
+  discardPendingCommands(buffer);
+  buffer->setCoalescingEnabled(true);
+
+  const char* code =
+      "(() => {"
+      "  let container = document.createElement('div');"
+      "  let span = document.createElement('span');"
+      "  span.style.color = 'red';"
+      "  container.appendChild(span);"
+      "  container.appendChild(document.createTextNode('hello'));"
+      "})();"
+      "let kept = document.createElement('p');";
+  bridge->evaluateScript(code, strlen(code), "vm://", 0);
+  JS_RunGC(JS_GetRuntime(context->ctx()));
+
+  UICommandBatch* batch = buffer->acquire();
+  // Only the creation of the <p> element is left.
+  ASSERT_EQ(batch->size(), 1);
+  EXPECT_EQ(batch->item(0).type, static_cast<int32_t>(UICommand::kCreateElement));
+  EXPECT_EQ(readCommandString(batch, batch->item(0).string_01, batch->item(0).args_01_length), "p");
+  EXPECT_GT(buffer->coalescingStats().disposed_target_commands, 0);
+  buffer->clear();
+}
+
+TEST(UICommandBuffer, styleDeclarationsAreBatchedPerElement) {
+  auto bridge = TEST_init();
+  auto* buffer = bridge->GetExecutingContext()->uiCommandBuffer();
+  discardPendingCommands(buffer);
+
+  const char* code =
+      "let first = document.createElement('div');"
+      "let second = document.createElement('div');"
+      "first.style.width = '100px';"
+      "second.style.color = 'red';"
+      "first.style.height = '200px';"
+      "first.style.width = '300px';"
+      "first.setAttribute('class', 'box');"
+      "second.style.removeProperty('color');";
+  bridge->evaluateScript(code, strlen(code), "vm://", 0);
+
+  UICommandBatch* batch = buffer->acquire();
+  std::vector<UICommandItem*> style_items;
+  for (int64_t i = 0; i < batch->size(); i++) {
+    UICommandItem& item = batch->item(i);
+    EXPECT_NE(item.type, static_cast<int32_t>(UICommand::kSetStyle));
+    if (item.type == static_cast<int32_t>(UICommand::kSetStyleBatch)) {
+      style_items.emplace_back(&item);
+    }
+  }
+  ASSERT_EQ(style_items.size(), 2);
+
+  auto first = readStyleBatch(batch, *style_items[0]);
+  ASSERT_EQ(first.size(), 2);
+  EXPECT_EQ(first[0].first, "width");
+  EXPECT_EQ(first[0].second, "300px");
+  EXPECT_EQ(first[1].first, "height");
+  EXPECT_EQ(first[1].second, "200px");
+
+  auto second = readStyleBatch(batch, *style_items[1]);
+  ASSERT_EQ(second.size(), 1);
+  EXPECT_EQ(second[0].first, "color");
+  EXPECT_EQ(second[0].second, "");
+  buffer->clear();
+}
+
+TEST(UICommandBuffer, pendingStylesAreRecordedBeforeClone) {
+  auto bridge = TEST_init();
+  auto* buffer = bridge->GetExecutingContext()->uiCommandBuffer();
+  discardPendingCommands(buffer);
+
+  const char* code =
+      "let div = document.createElement('div');"
+      "div.style.color = 'red';"
+      "div.cloneNode();"
+      "div.style.color = 'blue';";
+  bridge->evaluateScript(code, strlen(code), "vm://", 0);
+
+  UICommandBatch* batch = buffer->acquire();
+  std::vector<int32_t> types;
+  for (int64_t i = 0; i < batch->size(); i++) {
+    auto type = static_cast<UICommand>(batch->item(i).type);
+    if (type == UICommand::kSetStyleBatch || type == UICommand::kCloneNode) {
+      types.emplace_back(static_cast<int32_t>(type));
+    }
+  }
+  std::vector<int32_t> expected_types = {static_cast<int32_t>(UICommand::kSetStyleBatch),
+                                         static_cast<int32_t>(UICommand::kCloneNode),
+                                         static_cast<int32_t>(UICommand::kSetStyleBatch)};
+  EXPECT_EQ(types, expected_types);
+  buffer->clear();
+}
+
+TEST(UICommandBuffer, publishSegmentsToConsumerThread) {
+  auto bridge = TEST_init();
+  auto* buffer = bridge->GetExecutingContext()->uiCommandBuffer();
+  discardPendingCommands(buffer);
+  buffer->setPublishingEnabled(true);
+
+  const int total = 50000;
+  std::atomic<bool> producer_finished{false};
+  int set_attribute_count = 0;
+  int64_t segment_count = 0;
+  bool in_order = true;
+
+  std::thread consumer([&]() {
+    while (true) {
+      // Read the flag before polling, so nothing published before finishing could be missed.
+      bool finished = producer_finished.load(std::memory_order_acquire);
+      UICommandPublishedSegment* segment = buffer->poll();
+      if (segment == nullptr) {
+        if (finished)
+          break;
+        std::this_thread::yield();
+        continue;
+      }
+      segment_count++;
+      for (int64_t i = 0; i < segment->size; i++) {
+        UICommandItem& item = segment->items[i];
+        if (item.type != static_cast<int32_t>(UICommand::kSetAttribute))
+          continue;
+        NativeString value{segment->strings + item.string_02, static_cast<uint32_t>(item.args_02_length)};
+        in_order &= nativeStringToStdString(&value) == "item-" + std::to_string(set_attribute_count);
+        set_attribute_count++;
+      }
+      buffer->release(segment);
+    }
+  });
+
+  const char* code =
+      "for (let i = 0; i < 50000; i ++) {"
+      "  document.createElement('div').setAttribute('id', 'item-' + i);"
+      "}";
+  bridge->evaluateScript(code, strlen(code), "vm://", 0);
+  bool all_published = buffer->publish();
+  producer_finished.store(true, std::memory_order_release);
+  consumer.join();
+
+  // A consumer which fell behind leaves the rest of the commands to acquire(), after the published ones.
+  UICommandBatch* rest = buffer->acquire();
+  EXPECT_EQ(rest->empty(), all_published);
+  for (int64_t i = 0; i < rest->size(); i++) {
+    UICommandItem& item = rest->item(i);
+    if (item.type != static_cast<int32_t>(UICommand::kSetAttribute))
+      continue;
+    NativeString value{rest->strings().data() + item.string_02, static_cast<uint32_t>(item.args_02_length)};
+    in_order &= nativeStringToStdString(&value) == "item-" + std::to_string(set_attribute_count);
+    set_attribute_count++;
+  }
+  buffer->clear();
+
+  EXPECT_EQ(set_attribute_count, total);
+  EXPECT_EQ(in_order, true);
+  EXPECT_GE(segment_count, 1);
+  buffer->setPublishingEnabled(false);
+}
+
+TEST(UICommandBuffer, keepCommandsWhenConsumerFallsBehind) {
+  auto bridge = TEST_init();
+  auto* buffer = bridge->GetExecutingContext()->uiCommandBuffer();
+  discardPendingCommands(buffer);
+  buffer->setPublishingEnabled(true);
+
+  // Nothing polls, so the queue fills up and the rest of the commands stay pending instead of blocking JS thread.
+  const int64_t queue_capacity = UI_COMMAND_PUBLISHED_QUEUE_SIZE - 1;
+  const int64_t total = (queue_capacity + 2) * UI_COMMAND_SEGMENT_SIZE + 10;
+  for (int64_t i = 0; i < total; i++) {
+    buffer->addCommand(static_cast<int32_t>(i), UICommand::kRemoveNode, nullptr);
+  }
+  EXPECT_EQ(buffer->publish(), false);
+
+  UICommandBatch* batch = buffer->acquire();
+  EXPECT_EQ(batch->size(), total - queue_capacity * UI_COMMAND_SEGMENT_SIZE);
+  EXPECT_EQ(batch->item(0).id, queue_capacity * UI_COMMAND_SEGMENT_SIZE);
+  buffer->clear();
+
+  int64_t published = 0;
+  while (UICommandPublishedSegment* segment = buffer->poll()) {
+    published += segment->size;
+    buffer->release(segment);
+  }
+  EXPECT_EQ(published, queue_capacity * UI_COMMAND_SEGMENT_SIZE);
+  buffer->setPublishingEnabled(false);
+}
+
+TEST(UICommandBuffer, statsCountCommandsAndFlushReasons) {
+  auto bridge = TEST_init();
+  auto* context = bridge->GetExecutingContext();
+  auto* buffer = context->uiCommandBuffer();
+  discardPendingCommands(buffer);
+  buffer->resetStats();
+
+  const char* code =
+      "let div = document.createElement('div');"
+      "div.setAttribute('id', 'hello');"
+      "div.style.color = 'red';";
+  bridge->evaluateScript(code, strlen(code), "vm://", 0);
+
+  const UICommandStats& stats = buffer->stats();
+  EXPECT_EQ(stats.command_counts[static_cast<int32_t>(UICommand::kCreateElement)], 1);
+  EXPECT_EQ(stats.command_counts[static_cast<int32_t>(UICommand::kSetAttribute)], 1);
+  // "div" + "id" + "hello"
+  EXPECT_EQ(stats.string_bytes, 10 * sizeof(uint16_t));
+
+  // A binding call flushes synchronously, the test environment acquires and clears the batch at once.
+  context->FlushUICommand();
+  EXPECT_EQ(stats.sync_binding_flushes, 1);
+  EXPECT_EQ(stats.frame_flushes, 0);
+  EXPECT_EQ(stats.command_counts[static_cast<int32_t>(UICommand::kSetStyleBatch)], 1);
+
+  const char* next_code = "document.createElement('span');";
+  bridge->evaluateScript(next_code, strlen(next_code), "vm://", 0);
+  discardPendingCommands(buffer);
+  EXPECT_EQ(stats.frame_flushes, 1);
+
+  int64_t latency_count = 0;
+  for (int64_t count : stats.flush_latency_histogram) {
+    latency_count += count;
+  }
+  EXPECT_EQ(latency_count, 2);
+}
+
+TEST(UICommandBuffer, keepCommandsOfUnrelatedTargetsCreatedDuringInstantiation) {
+  auto bridge = TEST_init();
+  auto* buffer = bridge->GetExecutingContext()->uiCommandBuffer();
+  discardPendingCommands(buffer);
+
+  // Targets 1000 and 1002 are nodes of the fragment. Target 1001 is created in between, by the constructor of the
+  // first node, and 1003 by a setter while the fragment is built.
+  buffer->beginFragmentInstantiation();
+  buffer->expectInstantiatedTarget();
+  buffer->addCommand(1000, UICommand::kCreateElement, stringToNativeString("div"), nullptr);
+  buffer->addCommand(1001, UICommand::kCreateDocumentFragment, nullptr);
+  buffer->addCommand(1000, UICommand::kSetAttribute, stringToNativeString("id"), stringToNativeString("a"), nullptr);
+  buffer->expectInstantiatedTarget();
+  buffer->addCommand(1002, UICommand::kCreateTextNode, stringToNativeString("text"), nullptr);
+  buffer->addCommand(1000, UICommand::kInsertAdjacentNode, 1002, UICommandInsertPosition::kBeforeEnd, nullptr);
+  buffer->addCommand(1003, UICommand::kCreateElement, stringToNativeString("span"), nullptr);
+  buffer->addCommand(1001, UICommand::kInsertAdjacentNode, 1003, UICommandInsertPosition::kBeforeEnd, nullptr);
+  buffer->addCommand(1002, UICommand::kDisposeEventTarget, nullptr);
+  buffer->endFragmentInstantiation();
+  // Targets created with the same ids after the instantiation are recorded again.
+  buffer->addCommand(1000, UICommand::kSetAttribute, stringToNativeString("id"), stringToNativeString("b"), nullptr);
+
+  UICommandBatch* batch = buffer->acquire();
+  std::vector<std::pair<int32_t, UICommand>> commands;
+  for (int64_t i = 0; i < batch->size(); i++) {
+    UICommandItem& item = batch->item(i);
+    commands.emplace_back(item.id, static_cast<UICommand>(item.type));
+  }
+  std::vector<std::pair<int32_t, UICommand>> expected = {
+      {1001, UICommand::kCreateDocumentFragment}, {1003, UICommand::kCreateElement},
+      {1001, UICommand::kInsertAdjacentNode},     {1002, UICommand::kDisposeEventTarget},
+      {1000, UICommand::kSetAttribute},
+  };
+  EXPECT_EQ(commands, expected);
+  buffer->clear();
+}
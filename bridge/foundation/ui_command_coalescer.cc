@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "ui_command_coalescer.h"
+#include <cstdlib>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include "ui_command_buffer.h"
+
+namespace webf {
+
+namespace {
+
+bool IsCreateCommand(int32_t type) {
+  switch (static_cast<UICommand>(type)) {
+    case UICommand::kCreateElement:
+    case UICommand::kCreateTextNode:
+    case UICommand::kCreateComment:
+    case UICommand::kCreateDocumentFragment:
+      return true;
+    default:
+      return false;
+  }
+}
+
+}  // namespace
+
+void UICommandCoalescer::Coalesce(UICommandBatch* batch) {
+  int64_t size = batch->size();
+  if (size == 0)
+    return;
+
+  std::unordered_set<int32_t> created_targets;
+  std::unordered_set<int32_t> kept_targets;
+  std::unordered_set<int32_t> dropped_targets;
+
+  for (int64_t i = 0; i < size; i++) {
+    const UICommandItem& item = batch->item(i);
+    if (IsCreateCommand(item.type)) {
+      created_targets.emplace(item.id);
+    } else if (item.type == static_cast<int32_t>(UICommand::kCloneNode)) {
+      // Dart side copies the styles and attributes of the source when cloning, so the source must be kept.
+      kept_targets.emplace(item.id);
+    } else if (item.type == static_cast<int32_t>(UICommand::kInstantiateFragment)) {
+      // The nodes of the fragment have no create command of their own, they only exist in dart side if their parent
+      // does.
+      kept_targets.emplace(item.id);
+    } else if (item.type == static_cast<int32_t>(UICommand::kDisposeEventTarget) &&
+               created_targets.count(item.id) > 0) {
+      dropped_targets.emplace(item.id);
+    }
+  }
+  for (int32_t id : kept_targets) {
+    dropped_targets.erase(id);
+  }
+
+  const uint16_t* strings = batch->strings().data();
+  std::unordered_map<int32_t, std::unordered_set<std::u16string_view>> written_attributes;
+  std::vector<bool> removed(size, false);
+  int64_t removed_count = 0;
+
+  // Walk backwards so the first write we met for each attribute is the last one.
+  for (int64_t i = size - 1; i >= 0; i--) {
+    const UICommandItem& item = batch->item(i);
+    auto type = static_cast<UICommand>(item.type);
+
+    bool refers_dropped_node =
+        (type == UICommand::kInsertAdjacentNode || type == UICommand::kCloneNode) && dropped_targets.count(item.node_id);
+    if (dropped_targets.count(item.id) > 0 || refers_dropped_node) {
+      // Dart side releases the NativeBindingObject with malloc.free when handling kDisposeEventTarget.
+      if (type == UICommand::kDisposeEventTarget && item.nativePtr != 0) {
+        free(reinterpret_cast<void*>(item.nativePtr));
+      }
+      removed[i] = true;
+      removed_count++;
+      stats_.disposed_target_commands++;
+      continue;
+    }
+
+    // Inline styles are already merged per element into one kSetStyleBatch by UICommandBuffer::addStyleProperty.
+    switch (type) {
+      case UICommand::kSetAttribute:
+      case UICommand::kRemoveAttribute: {
+        std::u16string_view attribute(reinterpret_cast<const char16_t*>(strings + item.string_01),
+                                      item.args_01_length);
+        if (!written_attributes[item.id].emplace(attribute).second) {
+          removed[i] = true;
+          removed_count++;
+          stats_.coalesced_writes++;
+        }
+        break;
+      }
+      case UICommand::kCloneNode: {
+        // Writes before the clone are visible to the cloned node, never let later writes override them.
+        written_attributes.erase(item.id);
+        break;
+      }
+      default:
+        break;
+    }
+  }
+
+  stats_.batches++;
+  stats_.commands += size;
+
+  if (removed_count > 0) {
+    batch->compact(removed);
+  }
+}
+
+}  // namespace webf
@@ -0,0 +1,38 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef BRIDGE_FOUNDATION_UI_COMMAND_COALESCER_H_
+#define BRIDGE_FOUNDATION_UI_COMMAND_COALESCER_H_
+
+#include <cinttypes>
+
+namespace webf {
+
+class UICommandBatch;
+
+struct UICommandCoalescingStats {
+  // Batches and commands went through the coalescer.
+  int64_t batches{0};
+  int64_t commands{0};
+  // kSetAttribute/kRemoveAttribute commands overridden by a later write to the same attribute.
+  int64_t coalesced_writes{0};
+  // Commands of event targets which were created and disposed within the same batch.
+  int64_t disposed_target_commands{0};
+};
+
+// Drop the commands which make no difference to dart side before handing over a batch:
+// 1. Only the last write of each (target id, attribute) is kept.
+// 2. Event targets created and disposed within one batch (including whole subtrees) are never sent to dart.
+class UICommandCoalescer {
+ public:
+  void Coalesce(UICommandBatch* batch);
+  const UICommandCoalescingStats& stats() const { return stats_; }
+
+ private:
+  UICommandCoalescingStats stats_;
+};
+
+}  // namespace webf
+
+#endif  // BRIDGE_FOUNDATION_UI_COMMAND_COALESCER_H_
@@ -0,0 +1,36 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "ui_command_stats.h"
+
+namespace webf {
+
+void UICommandStats::RecordFlush(UICommandFlushReason reason) {
+  switch (reason) {
+    case UICommandFlushReason::kFrame:
+      frame_flushes++;
+      break;
+    case UICommandFlushReason::kSyncBinding:
+      sync_binding_flushes++;
+      break;
+    case UICommandFlushReason::kSegmentFull:
+      segment_full_flushes++;
+      break;
+  }
+}
+
+void UICommandStats::RecordFlushLatency(std::chrono::steady_clock::duration latency) {
+  int64_t microseconds = std::chrono::duration_cast<std::chrono::microseconds>(latency).count();
+  int bucket = 0;
+  while (bucket < UI_COMMAND_FLUSH_LATENCY_BUCKETS - 1 && microseconds >= (int64_t{1} << bucket)) {
+    bucket++;
+  }
+  flush_latency_histogram[bucket]++;
+}
+
+void UICommandStats::Reset() {
+  *this = UICommandStats();
+}
+
+}  // namespace webf
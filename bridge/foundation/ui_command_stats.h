@@ -0,0 +1,46 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef BRIDGE_FOUNDATION_UI_COMMAND_STATS_H_
+#define BRIDGE_FOUNDATION_UI_COMMAND_STATS_H_
+
+#include <chrono>
+#include <cinttypes>
+
+namespace webf {
+
+// Large enough for every UICommand type.
+#define UI_COMMAND_STATS_TYPE_COUNT 32
+// Bucket i counts flushes completed within 2^i microseconds (and not within 2^(i-1)), the last bucket takes the rest.
+#define UI_COMMAND_FLUSH_LATENCY_BUCKETS 20
+
+enum class UICommandFlushReason {
+  // Dart side pulled the commands for a new frame.
+  kFrame,
+  // A binding call needs dart side to apply the pending commands before reading from it.
+  kSyncBinding,
+  // A full segment was published to the consumer thread in publishing mode.
+  kSegmentFull,
+};
+
+// Counters since the context was created, the layout is read by dart side through getUICommandStats().
+struct UICommandStats {
+  // Recorded commands per UICommand type, before coalescing.
+  int64_t command_counts[UI_COMMAND_STATS_TYPE_COUNT]{};
+  // Bytes of string payloads copied into the string arena.
+  int64_t string_bytes{0};
+  int64_t frame_flushes{0};
+  int64_t sync_binding_flushes{0};
+  int64_t segment_full_flushes{0};
+  // Time from handing over a batch until dart side released it.
+  int64_t flush_latency_histogram[UI_COMMAND_FLUSH_LATENCY_BUCKETS]{};
+
+  void RecordFlush(UICommandFlushReason reason);
+  void RecordFlushLatency(std::chrono::steady_clock::duration latency);
+  void Reset();
+};
+
+}  // namespace webf
+
+#endif  // BRIDGE_FOUNDATION_UI_COMMAND_STATS_H_
@@ -0,0 +1,53 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include "ui_command_string_arena.h"
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <utility>
+
+namespace webf {
+
+// 32K utf-16 code units (64KB), enough for most of the frames without growing.
+static const size_t kInitialArenaCapacity = 32 * 1024;
+
+UICommandStringArena::~UICommandStringArena() {
+  free(data_);
+}
+
+int64_t UICommandStringArena::Append(const uint16_t* string, uint32_t length) {
+  if (UNLIKELY(size_ + length > capacity_)) {
+    Grow(size_ + length);
+  }
+
+  int64_t offset = static_cast<int64_t>(size_);
+  if (length > 0) {
+    memcpy(data_ + size_, string, length * sizeof(uint16_t));
+  }
+  size_ += length;
+  append_count_++;
+  return offset;
+}
+
+void UICommandStringArena::Swap(UICommandStringArena& other) {
+  std::swap(data_, other.data_);
+  std::swap(size_, other.size_);
+  std::swap(capacity_, other.capacity_);
+}
+
+void UICommandStringArena::Grow(size_t minimum_capacity) {
+  size_t new_capacity = capacity_ == 0 ? kInitialArenaCapacity : capacity_ * 2;
+  while (new_capacity < minimum_capacity) {
+    new_capacity *= 2;
+  }
+
+  auto* new_data = static_cast<uint16_t*>(realloc(data_, new_capacity * sizeof(uint16_t)));
+  assert(new_data != nullptr);
+  data_ = new_data;
+  capacity_ = new_capacity;
+  allocation_count_++;
+}
+
+}  // namespace webf
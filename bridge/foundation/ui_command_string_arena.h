@@ -0,0 +1,49 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#ifndef BRIDGE_FOUNDATION_UI_COMMAND_STRING_ARENA_H_
+#define BRIDGE_FOUNDATION_UI_COMMAND_STRING_ARENA_H_
+
+#include <cinttypes>
+#include <cstddef>
+#include "foundation/macros.h"
+
+namespace webf {
+
+// A bump allocator which holds all the string payloads of UICommandItems between two flushes.
+// Strings are laid out contiguously and referenced by offset (in uint16_t units), so the storage
+// can be reset in O(1) once dart side has consumed the commands and reused for the next batch.
+class UICommandStringArena {
+ public:
+  UICommandStringArena() = default;
+  ~UICommandStringArena();
+  WEBF_DISALLOW_COPY_AND_ASSIGN(UICommandStringArena);
+
+  // Copy the utf-16 string into the arena and return the offset of the first code unit.
+  int64_t Append(const uint16_t* string, uint32_t length);
+
+  // The address of the arena may change after Append() when growing, so read it after all strings are appended.
+  FORCE_INLINE const uint16_t* data() const { return data_; }
+  FORCE_INLINE size_t size() const { return size_; }
+  FORCE_INLINE void Reset() { size_ = 0; }
+  // Exchange the storage with another arena, used to hand over the strings along with a published segment.
+  void Swap(UICommandStringArena& other);
+
+  // Counts since the arena was created. Without arena, every appended string took its own heap allocation.
+  FORCE_INLINE int64_t appendCount() const { return append_count_; }
+  FORCE_INLINE int64_t allocationCount() const { return allocation_count_; }
+
+ private:
+  void Grow(size_t minimum_capacity);
+
+  uint16_t* data_{nullptr};
+  size_t size_{0};
+  size_t capacity_{0};
+  int64_t append_count_{0};
+  int64_t allocation_count_{0};
+};
+
+}  // namespace webf
+
+#endif  // BRIDGE_FOUNDATION_UI_COMMAND_STRING_ARENA_H_
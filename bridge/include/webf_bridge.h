@@ -44,6 +44,11 @@ WEBF_EXPORT_C
 void evaluateQuickjsByteCode(int32_t contextId, uint8_t* bytes, int32_t byteLen);
 WEBF_EXPORT_C
 void parseHTML(int32_t contextId, const char* code, int32_t length);
+// Stream a document into the page. Each chunk is parsed as far as it goes, finishParseHTML ends the document.
+WEBF_EXPORT_C
+void parseHTMLChunk(int32_t contextId, const char* code, int32_t length);
+WEBF_EXPORT_C
+void finishParseHTML(int32_t contextId);
 WEBF_EXPORT_C
 void reloadJsContext(int32_t contextId, uint64_t* dart_methods, int32_t dart_methods_len);
 WEBF_EXPORT_C
@@ -61,12 +66,42 @@ void flushUITask(int32_t contextId);
 WEBF_EXPORT_C
 void registerUITask(int32_t contextId, Task task, void* data);
 WEBF_EXPORT_C
-void* getUICommandItems(int32_t contextId);
+int64_t acquireUICommandSegments(int32_t contextId);
+WEBF_EXPORT_C
+void* getUICommandItems(int32_t contextId, int64_t segment);
+WEBF_EXPORT_C
+const uint16_t* getUICommandStrings(int32_t contextId);
+WEBF_EXPORT_C
+int64_t getUICommandItemSize(int32_t contextId, int64_t segment);
+// Return the UICommandStats of the context, which is updated in place as commands are recorded and flushed.
+WEBF_EXPORT_C
+void* getUICommandStats(int32_t contextId);
+WEBF_EXPORT_C
+void resetUICommandStats(int32_t contextId);
+// Return the EventCoalescingStats of the context, which is updated in place as move events are coalesced.
 WEBF_EXPORT_C
-int64_t getUICommandItemSize(int32_t contextId);
+void* getEventCoalescingStats(int32_t contextId);
+WEBF_EXPORT_C
+void resetEventCoalescingStats(int32_t contextId);
+// Called by dart side after every frame, element geometry read before it is no longer valid.
+WEBF_EXPORT_C
+void invalidateGeometrySnapshots(int32_t contextId);
 WEBF_EXPORT_C
 void clearUICommandItems(int32_t contextId);
 WEBF_EXPORT_C
+void setUICommandCoalescingEnabled(int32_t contextId, int32_t enabled);
+#if ENABLE_UI_COMMAND_PUBLISHING
+// Publish UI command segments to a consumer thread instead of handing them over on the JS thread.
+WEBF_EXPORT_C
+void setUICommandPublishingEnabled(int32_t contextId, int32_t enabled);
+// Called on the consumer thread. Return a UICommandPublishedSegment, which starts with the items pointer, the item
+// count and the strings pointer, or nullptr when nothing is published.
+WEBF_EXPORT_C
+void* pollUICommandSegment(int32_t contextId);
+WEBF_EXPORT_C
+void releaseUICommandSegment(int32_t contextId, void* segment);
+#endif
+WEBF_EXPORT_C
 void registerContextDisposedCallbacks(int32_t contextId, Task task, void* data);
 WEBF_EXPORT_C
 void registerPluginByteCode(uint8_t* bytes, int32_t length, const char* pluginName);
@@ -10,8 +10,15 @@ import { dispatchConnectivityChangeEvent } from "./connection";
 addWebfModuleListener('Connection', (event, data) => dispatchConnectivityChangeEvent(event));
 addWebfModuleListener('MethodChannel', (event, data) => triggerMethodCallHandler(data[0], data[1]));
 
+// Measure many elements with one call to dart side, useful for virtualized lists measuring all visible rows at once.
+// Return a Float64Array of [x, y, width, height] of each element, in the order of the given elements.
+function getBoundingClientRects(elements: ArrayLike<Element>): Float64Array {
+  return (document as any).__webf_get_bounding_client_rects__(Array.from(elements));
+}
+
 export const webf = {
   methodChannel,
+  getBoundingClientRects,
   invokeModule: webfInvokeModule,
   addWebfModuleListener: addWebfModuleListener,
   clearWebfModuleListener: clearWebfModuleListener,
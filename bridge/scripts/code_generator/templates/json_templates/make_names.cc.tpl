@@ -30,6 +30,20 @@ const AtomicString& k<%= name %> = reinterpret_cast<AtomicString*>(&names_storag
   <% }) %>
 <% } %>
 
+<% var layoutIndependentNames = _.filter(data, function(name) { return _.isPlainObject(name) && name.layoutIndependent; }); %>
+<% if (layoutIndependentNames.length > 0) { %>
+bool IsLayoutIndependent(const AtomicString& name) {
+  return <%= layoutIndependentNames.map(function(name) { return 'name == k' + name.name; }).join(' || ') %>;
+}
+<% } %>
+
+<% var layoutMutatingNames = _.filter(data, function(name) { return _.isPlainObject(name) && name.mutatesLayout; }); %>
+<% if (layoutMutatingNames.length > 0) { %>
+bool MutatesLayout(const AtomicString& name) {
+  return <%= layoutMutatingNames.map(function(name) { return 'name == k' + name.name; }).join(' || ') %>;
+}
+<% } %>
+
 void Init(JSContext* ctx) {
   struct NameEntry {
     <% if (options.add_atom_prefix) { %>
@@ -31,6 +31,16 @@ namespace <%= name %> {
 
 constexpr unsigned kNamesCount = <%= data.length %>;
 
+<% if (_.some(data, function(name) { return _.isPlainObject(name) && name.layoutIndependent; })) { %>
+// Binding calls of these names never read states affected by pending UICommands, so there is no need to flush.
+bool IsLayoutIndependent(const AtomicString& name);
+<% } %>
+
+<% if (_.some(data, function(name) { return _.isPlainObject(name) && name.mutatesLayout; })) { %>
+// Binding calls of these names change the layout at dart side.
+bool MutatesLayout(const AtomicString& name);
+<% } %>
+
 void Init(JSContext* ctx);
 void Dispose();
 
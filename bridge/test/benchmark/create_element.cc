@@ -39,9 +39,21 @@ for(let i = 0; i < 1000; i ++) {
 })();
 )";
   // Perform setup here
+  auto* buffer = context->uiCommandBuffer();
+  int64_t string_arguments = 0;
+  int64_t string_allocations = 0;
   for (auto _ : state) {
+    const UICommandStringArena& arena = buffer->pending()->strings();
+    int64_t append_count = arena.appendCount();
+    int64_t allocation_count = arena.allocationCount();
     context->EvaluateJavaScript(code.c_str(), code.size(), "internal://", 0);
+    string_arguments += arena.appendCount() - append_count;
+    string_allocations += arena.allocationCount() - allocation_count;
+    context->FlushUICommand();
   }
+  // Each string argument used to take a heap allocation for the copy held by UICommandBuffer.
+  state.counters["string_arguments"] = benchmark::Counter(string_arguments, benchmark::Counter::kAvgIterations);
+  state.counters["string_allocations"] = benchmark::Counter(string_allocations, benchmark::Counter::kAvgIterations);
 }
 
 static void InsertElement(benchmark::State& state) {
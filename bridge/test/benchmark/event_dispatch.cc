@@ -0,0 +1,37 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include <benchmark/benchmark.h>
+#include "core/dom/document.h"
+#include "core/dom/events/event.h"
+#include "core/html/html_body_element.h"
+#include "webf_test_env.h"
+
+using namespace webf;
+
+// Dispatches an event to an element with listeners for state.range(0) event types, the way window and document carry
+// the delegated handlers of an app. The type dispatched is the last one registered, which a linear search of the
+// listener map finds last.
+static void DispatchToTargetWithEventTypes(benchmark::State& state) {
+  auto page = TEST_init();
+  auto context = page->GetExecutingContext();
+  int64_t event_types = state.range(0);
+  std::string setup = "let target = document.createElement('div'); let count = 0;"
+                      "for (let i = 0; i < " +
+                      std::to_string(event_types) +
+                      "; i++) target.addEventListener('type' + i, () => count++);"
+                      "document.body.appendChild(target);";
+  page->evaluateScript(setup.c_str(), setup.size(), "vm://", 0);
+
+  EventTarget* target = context->document()->body()->lastChild();
+  AtomicString type(context->ctx(), "type" + std::to_string(event_types - 1));
+  for (auto _ : state) {
+    MemberMutationScope mutation_scope{context};
+    Event* event = Event::Create(context, type, ASSERT_NO_EXCEPTION());
+    benchmark::DoNotOptimize(target->dispatchEvent(event, ASSERT_NO_EXCEPTION()));
+  }
+  state.SetItemsProcessed(state.iterations());
+}
+
+BENCHMARK(DispatchToTargetWithEventTypes)->Arg(1)->Arg(8)->Arg(64)->Threads(1)->Unit(benchmark::kNanosecond);
@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include <benchmark/benchmark.h>
+#include "core/dom/document.h"
+#include "core/html/html_body_element.h"
+#include "foundation/native_value.h"
+#include "webf_test_env.h"
+
+using namespace webf;
+
+static const char* kSetupElements = R"(
+(() => {
+  let container = document.createElement('div');
+  for(let i = 0; i < 1000; i ++) {
+    container.appendChild(document.createElement('div'));
+  }
+  document.body.appendChild(container);
+})();
+)";
+
+static const char* kReadGeometry = R"(
+(() => {
+  let sum = 0;
+  for(let div of document.body.lastChild.childNodes) {
+    let rect = div.getBoundingClientRect();
+    sum += div.offsetTop + div.offsetLeft + div.offsetWidth + div.offsetHeight;
+    sum += div.clientWidth + div.clientHeight + rect.x + rect.y;
+  }
+  return sum;
+})();
+)";
+
+// Stands for dart side answering getGeometrySnapshot, the cost of the real layout is not measured.
+static void FakeGetGeometrySnapshot(const NativeBindingObject* binding_object,
+                                    NativeValue* return_value,
+                                    NativeValue* method,
+                                    int32_t argc,
+                                    const NativeValue* argv) {
+  auto* items = static_cast<NativeValue*>(malloc(sizeof(NativeValue) * kElementGeometryPropertyCount));
+  for (uint32_t i = 0; i < kElementGeometryPropertyCount; i++) {
+    items[i] = Native_NewFloat64(0);
+  }
+  *return_value = Native_NewList(kElementGeometryPropertyCount, items);
+}
+
+// Read 8 layout-dependent properties from 1000 elements. Without the geometry snapshot every read is a synchronous
+// call to dart side, with it each element takes at most one call per layout.
+static void ReadElementGeometry(benchmark::State& state) {
+  static auto page = TEST_init();
+  auto context = page->GetExecutingContext();
+  context->EvaluateJavaScript(kSetupElements, strlen(kSetupElements), "internal://", 0);
+  context->FlushUICommand();
+
+  // Stand in for dart side filling the snapshots after layout.
+  double values[kElementGeometryPropertyCount] = {};
+  auto* container = To<ContainerNode>(context->document()->body()->lastChild());
+  for (Node* child = container->firstChild(); child != nullptr; child = child->nextSibling()) {
+    To<Element>(child)->UpdateGeometrySnapshot(values, context->uiCommandBuffer()->layoutGeneration());
+  }
+
+  for (auto _ : state) {
+    context->EvaluateJavaScript(kReadGeometry, strlen(kReadGeometry), "internal://", 0);
+  }
+  state.counters["geometry_reads"] = benchmark::Counter(8000.0 * state.iterations(), benchmark::Counter::kIsRate);
+}
+
+// Same reads right after every layout: each element takes one call to dart side for its first read, the other 7
+// reads hit the snapshot.
+static void ReadElementGeometryAfterLayout(benchmark::State& state) {
+  static auto page = TEST_init();
+  auto context = page->GetExecutingContext();
+  context->EvaluateJavaScript(kSetupElements, strlen(kSetupElements), "internal://", 0);
+  context->FlushUICommand();
+
+  auto* container = To<ContainerNode>(context->document()->body()->lastChild());
+  for (Node* child = container->firstChild(); child != nullptr; child = child->nextSibling()) {
+    child->bindingObject()->invoke_bindings_methods_from_native = FakeGetGeometrySnapshot;
+  }
+
+  for (auto _ : state) {
+    context->uiCommandBuffer()->invalidateLayout();
+    context->EvaluateJavaScript(kReadGeometry, strlen(kReadGeometry), "internal://", 0);
+  }
+  state.counters["geometry_reads"] = benchmark::Counter(8000.0 * state.iterations(), benchmark::Counter::kIsRate);
+  state.counters["dart_calls"] = benchmark::Counter(1000.0 * state.iterations(), benchmark::Counter::kIsRate);
+}
+
+BENCHMARK(ReadElementGeometry)->Threads(1);
+BENCHMARK(ReadElementGeometryAfterLayout)->Threads(1);
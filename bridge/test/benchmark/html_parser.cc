@@ -0,0 +1,60 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include <benchmark/benchmark.h>
+#include <unordered_map>
+#include "core/dom/document.h"
+#include "core/dom/element.h"
+#include "core/html/parser/html_parser.h"
+#include "webf_test_env.h"
+
+using namespace webf;
+
+// About |size| bytes of server rendered markup: attributes, inline styles, entities and text.
+static const std::string& LargeDocument(size_t size) {
+  static std::unordered_map<size_t, std::string> documents;
+  std::string& html = documents[size];
+  if (!html.empty())
+    return html;
+
+  html = "<html><head><title>Parser benchmark</title></head><body>";
+  for (int i = 0; html.size() < size; i++) {
+    std::string index = std::to_string(i);
+    html += "<section id=\"section-" + index + "\" class=\"item " + (i % 2 ? "odd" : "even") +
+            "\" style=\"width: 100px; height: 20px; color: red\"><h2 title=\"Title &amp; " + index + "\">Heading " +
+            index + "</h2><p data-index=\"" + index +
+            "\">Lorem ipsum dolor sit amet, consectetur adipiscing elit &lt;" + index +
+            "&gt;.</p><a href=\"https://example.com/" + index + "\">link</a></section>";
+  }
+  html += "</body></html>";
+  return html;
+}
+
+static void ParseHTML(benchmark::State& state) {
+  static auto page = TEST_init();
+  auto context = page->GetExecutingContext();
+  const std::string& html = LargeDocument(state.range(0));
+  for (auto _ : state) {
+    MemberMutationScope scope{context};
+    HTMLParser::parseHTML(html, context->document()->documentElement());
+    context->FlushUICommand();
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * html.size());
+}
+
+// Gumbo runs on the parser thread, the benchmark thread only creates the nodes.
+static void ParseHTMLOffThread(benchmark::State& state) {
+  static auto page = TEST_init();
+  auto context = page->GetExecutingContext();
+  const std::string& html = LargeDocument(state.range(0));
+  for (auto _ : state) {
+    MemberMutationScope scope{context};
+    HTMLParser::parseHTMLOffThread(html, context->document()->documentElement());
+    context->FlushUICommand();
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * html.size());
+}
+
+BENCHMARK(ParseHTML)->Threads(1)->Unit(benchmark::kMillisecond)->Arg(1 << 20)->Arg(10 << 20);
+BENCHMARK(ParseHTMLOffThread)->Threads(1)->Unit(benchmark::kMillisecond)->Arg(1 << 20)->Arg(10 << 20);
@@ -0,0 +1,58 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include <benchmark/benchmark.h>
+#include <string>
+#include <third_party/gumbo-parser/src/gumbo.h>
+
+// Runs gumbo alone, without creating any DOM nodes, so the numbers are dominated by the tokenizer's text and
+// attribute value states and UTF-8 decoding.
+
+// About |size| bytes of article markup with long paragraphs and quoted attribute values made of |text|.
+static std::string TextDocument(const std::string& text, size_t size) {
+  std::string html = "<!DOCTYPE html><html><head><title>Tokenizer benchmark</title></head><body>";
+  for (int i = 0; html.size() < size; i++) {
+    std::string index = std::to_string(i);
+    html += "<article id=\"article-" + index + "\" title=\"" + text + "\"><h2>" + text + "</h2><p>" + text + text +
+            text + "</p><p class=\"note\" data-summary=\"" + text + text + "\">" + text + " &amp; " + text +
+            "</p></article>\n";
+  }
+  html += "</body></html>";
+  return html;
+}
+
+static const std::string& AsciiDocument() {
+  static std::string html = TextDocument(
+      "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do eiusmod tempor incididunt ut labore.", 1 << 20);
+  return html;
+}
+
+static const std::string& CJKDocument() {
+  static std::string html = TextDocument(
+      "\xE6\x98\xA5\xE7\x9C\xA0\xE4\xB8\x8D\xE8\xA7\x89\xE6\x99\x93\xEF\xBC\x8C\xE5\xA4\x84\xE5\xA4\x84\xE9\x97\xBB"
+      "\xE5\x95\xBC\xE9\xB8\x9F\xE3\x80\x82\xE5\xA4\x9C\xE6\x9D\xA5\xE9\xA3\x8E\xE9\x9B\xA8\xE5\xA3\xB0\xEF\xBC\x8C"
+      "\xE8\x8A\xB1\xE8\x90\xBD\xE7\x9F\xA5\xE5\xA4\x9A\xE5\xB0\x91\xE3\x80\x82 WebF \xE6\xB8\xB2\xE6\x9F\x93",
+      1 << 20);
+  return html;
+}
+
+static void Tokenize(benchmark::State& state, const std::string& html) {
+  for (auto _ : state) {
+    GumboOutput* output = gumbo_parse_with_options(&kGumboDefaultOptions, html.data(), html.size());
+    benchmark::DoNotOptimize(output->root);
+    gumbo_destroy_output(&kGumboDefaultOptions, output);
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) * html.size());
+}
+
+static void TokenizeASCII(benchmark::State& state) {
+  Tokenize(state, AsciiDocument());
+}
+
+static void TokenizeCJK(benchmark::State& state) {
+  Tokenize(state, CJKDocument());
+}
+
+BENCHMARK(TokenizeASCII)->Threads(1)->Unit(benchmark::kMillisecond);
+BENCHMARK(TokenizeCJK)->Threads(1)->Unit(benchmark::kMillisecond);
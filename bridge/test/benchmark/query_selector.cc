@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include <benchmark/benchmark.h>
+#include "webf_test_env.h"
+
+using namespace webf;
+
+// A tree of 1000 sections with 10 spans each, 11000 elements in total.
+static ExecutingContext* PrepareQuerySelectorTree() {
+  static auto page = TEST_init();
+  static bool prepared = false;
+  auto context = page->GetExecutingContext();
+  if (prepared)
+    return context;
+
+  std::string setup = R"(
+(() => {
+  let root = document.createElement('div');
+  for(let i = 0; i < 1000; i ++) {
+    let section = document.createElement('section');
+    section.className = i % 2 == 0 ? 'item even' : 'item odd';
+    for(let j = 0; j < 10; j ++) {
+      let span = document.createElement('span');
+      span.id = 'span-' + i + '-' + j;
+      section.appendChild(span);
+    }
+    root.appendChild(section);
+  }
+  document.body.appendChild(root);
+})();
+)";
+  context->EvaluateJavaScript(setup.c_str(), setup.size(), "internal://", 0);
+  context->FlushUICommand();
+  prepared = true;
+  return context;
+}
+
+static void RunQuery(benchmark::State& state, const std::string& code) {
+  auto context = PrepareQuerySelectorTree();
+  for (auto _ : state) {
+    context->EvaluateJavaScript(code.c_str(), code.size(), "internal://", 0);
+  }
+}
+
+static void QuerySelectorAllDescendant(benchmark::State& state) {
+  RunQuery(state, "document.querySelectorAll('.item span').length;");
+}
+
+static void QuerySelectorAllNthChild(benchmark::State& state) {
+  RunQuery(state, "document.querySelectorAll('section.odd > span:nth-child(2n+1)').length;");
+}
+
+static void QuerySelectorId(benchmark::State& state) {
+  RunQuery(state, "document.querySelector('#span-999-9');");
+}
+
+static void GetElementsByClassName(benchmark::State& state) {
+  RunQuery(state, "document.getElementsByClassName('item even').length;");
+}
+
+BENCHMARK(QuerySelectorAllDescendant)->Threads(1);
+BENCHMARK(QuerySelectorAllNthChild)->Threads(1);
+BENCHMARK(QuerySelectorId)->Threads(1);
+BENCHMARK(GetElementsByClassName)->Threads(1);
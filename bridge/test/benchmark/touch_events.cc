@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2022-present The WebF authors. All rights reserved.
+ */
+
+#include <benchmark/benchmark.h>
+#include "core/dom/document.h"
+#include "core/html/html_body_element.h"
+#include "qjs_touch_event.h"
+#include "webf_test_env.h"
+
+using namespace webf;
+
+// Two fingers moving over the body, dispatched from dart side the way a pinch gesture arrives: every move is
+// cancelable, so it reaches the listeners at once and is never coalesced. The created_events and reused_events
+// counters tell how many event objects the moves of one iteration allocated.
+
+static constexpr int kMovesPerIteration = 100;
+
+static void DispatchTouchStorm(benchmark::State& state, const std::string& listener) {
+  auto page = TEST_init();
+  auto context = page->GetExecutingContext();
+  page->evaluateScript(listener.c_str(), listener.size(), "vm://", 0);
+  EventTarget* body = context->document()->body();
+
+  NativeTouch touches[2]{};
+  touches[1].identifier = 1;
+  NativeTouchList touch_list{2, touches};
+  NativeTouchEvent native_event{};
+  native_event.native_event.native_event.bubbles = 1;
+  native_event.native_event.native_event.cancelable = 1;
+  native_event.touches = &touch_list;
+  native_event.targetTouches = &touch_list;
+  native_event.changedTouches = &touch_list;
+  RawEvent raw_event;
+  raw_event.bytes = reinterpret_cast<uint64_t*>(&native_event);
+  raw_event.length = sizeof(NativeTouchEvent) / sizeof(int64_t);
+  raw_event.is_custom_event = 0;
+
+  NativeValue method = Native_NewCString("dispatchEvent");
+  NativeValue argv[] = {Native_NewCString("touchmove"), Native_NewPtr(JSPointerType::Others, &raw_event),
+                        Native_NewBool(true)};
+
+  context->eventPool()->ResetStats();
+  for (auto _ : state) {
+    for (int i = 0; i < kMovesPerIteration; i++) {
+      touches[0].clientX = i;
+      touches[1].clientX = 2 * i;
+      NativeValue result;
+      NativeBindingObject::HandleCallFromDartSide(body->bindingObject(), &result, &method, 3, argv);
+      ::operator delete(result.u.ptr);
+    }
+  }
+
+  const EventPoolStats& stats = context->eventPool()->stats();
+  state.counters["created_events"] = benchmark::Counter(stats.created, benchmark::Counter::kAvgIterations);
+  state.counters["reused_events"] = benchmark::Counter(stats.reused, benchmark::Counter::kAvgIterations);
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) * kMovesPerIteration);
+}
+
+static void DispatchTouchMoves(benchmark::State& state) {
+  DispatchTouchStorm(state,
+                     "let distance = 0;"
+                     "document.body.addEventListener('touchmove', e => {"
+                     "  distance = e.touches[1].clientX - e.touches[0].clientX; });");
+}
+
+// The listener keeps the last event, so that none of them goes back to the pool.
+static void DispatchHeldTouchMoves(benchmark::State& state) {
+  DispatchTouchStorm(state,
+                     "let last = null;"
+                     "document.body.addEventListener('touchmove', e => {"
+                     "  last = e; let distance = e.touches[1].clientX - e.touches[0].clientX; });");
+}
+
+BENCHMARK(DispatchTouchMoves)->Threads(1)->Unit(benchmark::kMicrosecond);
+BENCHMARK(DispatchHeldTouchMoves)->Threads(1)->Unit(benchmark::kMicrosecond);
@@ -24,10 +24,16 @@ list(APPEND WEBF_UNIT_TEST_SOURCEURCE
   ./core/frame/console_test.cc
   ./core/frame/module_manager_test.cc
   ./core/dom/events/event_target_test.cc
+  ./core/dom/events/event_coalescer_test.cc
+  ./core/dom/events/event_pool_test.cc
   ./core/dom/document_test.cc
   ./core/dom/legacy/element_attribute_test.cc
   ./core/dom/node_test.cc
+  ./core/dom/selector_query_test.cc
   ./core/html/legacy/html_collection_test.cc
+  ./core/html/parser/html_document_parser_test.cc
+  ./core/html/parser/html_parser_test.cc
+  ./core/html/parser/html_fragment_template_test.cc
   ./core/dom/element_test.cc
   ./core/frame/dom_timer_test.cc
   ./core/frame/window_test.cc
@@ -35,6 +41,8 @@ list(APPEND WEBF_UNIT_TEST_SOURCEURCE
   ./core/html/html_element_test.cc
   ./core/html/custom/widget_element_test.cc
   ./core/timing/performance_test.cc
+  ./foundation/ui_command_buffer_test.cc
+  ./foundation/spsc_queue_test.cc
 )
 
 ### webf_unit_test executable
@@ -45,7 +53,8 @@ add_executable(webf_unit_test
 )
 
 target_include_directories(webf_unit_test PUBLIC ./third_party/googletest/googletest/include ${BRIDGE_INCLUDE} ./test)
-target_link_libraries(webf_unit_test gtest gtest_main ${BRIDGE_LINK_LIBS})
+find_package(Threads REQUIRED)
+target_link_libraries(webf_unit_test gtest gtest_main ${BRIDGE_LINK_LIBS} Threads::Threads)
 
 target_compile_options(quickjs PUBLIC -DDUMP_LEAKS=1)
 target_compile_options(webf PUBLIC -DDUMP_LEAKS=1)
@@ -83,6 +92,12 @@ add_executable(webf_benchmark
   ./test/webf_test_env.cc
   ./test/webf_test_env.h
   ./test/benchmark/create_element.cc
+  ./test/benchmark/event_dispatch.cc
+  ./test/benchmark/geometry.cc
+  ./test/benchmark/html_parser.cc
+  ./test/benchmark/html_tokenizer.cc
+  ./test/benchmark/query_selector.cc
+  ./test/benchmark/touch_events.cc
 )
 target_include_directories(webf_benchmark PUBLIC
   ./third_party/googletest/googletest/include
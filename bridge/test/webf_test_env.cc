@@ -180,6 +180,7 @@ void TEST_toBlob(void* ptr,
 }
 
 void TEST_flushUICommand(int32_t contextId) {
+  acquireUICommandSegments(contextId);
   clearUICommandItems(contextId);
 }
 
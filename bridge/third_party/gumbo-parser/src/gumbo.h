@@ -661,6 +661,45 @@ GumboOutput* gumbo_parse(const char* buffer);
 GumboOutput* gumbo_parse_with_options(
     const GumboOptions* options, const char* buffer, size_t buffer_length);
 
+/**
+ * A parse over input which arrives in chunks.  The tree is built as far as the
+ * input allows after every feed, and can be inspected between feeds through
+ * gumbo_incremental_parser_output; nodes which are not on the stack of open
+ * elements will not receive more children.
+ */
+typedef struct GumboInternalIncrementalParser GumboIncrementalParser;
+
+/** Starts an incremental parse. */
+GumboIncrementalParser* gumbo_incremental_parser_create(
+    const GumboOptions* options);
+
+/**
+ * Parses as far as |buffer| allows.  |buffer| holds all of the input so far,
+ * not just the new chunk, so it must begin with the bytes given to the
+ * previous feed; it may live at a different address, but every buffer passed
+ * in must stay alive as long as the parse tree.
+ *
+ * The tokenizer does not look ahead past the end of |buffer|, so it must end
+ * where no token lookahead is cut short, e.g. right after a '>' character.
+ */
+void gumbo_incremental_parser_feed(
+    GumboIncrementalParser* parser, const char* buffer, size_t length);
+
+/** The partial parse tree, owned by the parser until it is finished. */
+const GumboOutput* gumbo_incremental_parser_output(
+    const GumboIncrementalParser* parser);
+
+/** The stack of open elements, from the root to the current node. */
+const GumboVector* gumbo_incremental_parser_open_elements(
+    const GumboIncrementalParser* parser);
+
+/**
+ * Parses the rest of the last buffer as the end of the document, frees the
+ * parser and returns the completed tree, which is released with
+ * gumbo_destroy_output.
+ */
+GumboOutput* gumbo_incremental_parser_finish(GumboIncrementalParser* parser);
+
 /** Release the memory used for the parse tree & parse errors. */
 void gumbo_destroy_output(const GumboOptions* options, GumboOutput* output);
 
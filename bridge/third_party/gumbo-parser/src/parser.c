@@ -482,6 +482,7 @@ static void parser_state_init(GumboParser* parser) {
   parser_state->_ignore_next_linefeed = false;
   parser_state->_foster_parent_insertions = false;
   parser_state->_text_node._type = GUMBO_NODE_WHITESPACE;
+  parser_state->_text_node._start_original_text = NULL;
   gumbo_string_buffer_init(parser, &parser_state->_text_node._buffer);
   gumbo_vector_init(parser, 10, &parser_state->_open_elements);
   gumbo_vector_init(parser, 5, &parser_state->_active_formatting_elements);
@@ -1132,6 +1133,18 @@ static void insert_text_token(GumboParser* parser, GumboToken* token) {
   gumbo_debug("Inserting text token '%c'.\n", token->v.character);
 }
 
+// Once a character token has been inserted into the text node buffer, the
+// characters right after it would be inserted the same way, one token each, so
+// the plain text up to the next markup is taken from the tokenizer in one go.
+// Whitespace tokens leave the buffer type alone, and the run may not be all
+// whitespace, so only character tokens start a run.
+static void maybe_insert_text_run(GumboParser* parser, GumboToken* token) {
+  if (token->type == GUMBO_TOKEN_CHARACTER) {
+    gumbo_tokenizer_consume_text(
+        parser, &parser->_parser_state->_text_node._buffer);
+  }
+}
+
 // http://www.whatwg.org/specs/web-apps/current-work/complete/tokenization.html#generic-rcdata-element-parsing-algorithm
 static void run_generic_parsing_algorithm(
     GumboParser* parser, GumboToken* token, GumboTokenizerEnum lexer_state) {
@@ -2399,6 +2412,7 @@ static bool handle_in_body(GumboParser* parser, GumboToken* token) {
     reconstruct_active_formatting_elements(parser);
     insert_text_token(parser, token);
     set_frameset_not_ok(parser);
+    maybe_insert_text_run(parser, token);
     return true;
   } else if (token->type == GUMBO_TOKEN_COMMENT) {
     append_comment_node(parser, get_current_node(parser), token);
@@ -3044,6 +3058,7 @@ static bool handle_text(GumboParser* parser, GumboToken* token) {
   if (token->type == GUMBO_TOKEN_CHARACTER ||
       token->type == GUMBO_TOKEN_WHITESPACE) {
     insert_text_token(parser, token);
+    maybe_insert_text_run(parser, token);
   } else {
     // We provide only bare-bones script handling that doesn't involve any of
     // the parser-pause/already-started/script-nesting flags or re-entrant
@@ -4072,49 +4087,50 @@ GumboOutput* gumbo_parse(const char* buffer) {
       &kGumboDefaultOptions, buffer, strlen(buffer));
 }
 
-GumboOutput* gumbo_parse_with_options(
-    const GumboOptions* options, const char* buffer, size_t length) {
-  GumboParser parser;
-  parser._options = options;
-  output_init(&parser);
-  gumbo_tokenizer_state_init(&parser, buffer, length);
-  parser_state_init(&parser);
+static void parser_init(GumboParser* parser, const GumboOptions* options,
+    const char* buffer, size_t length) {
+  parser->_options = options;
+  output_init(parser);
+  gumbo_tokenizer_state_init(parser, buffer, length);
+  parser_state_init(parser);
 
   if (options->fragment_context != GUMBO_TAG_LAST) {
     fragment_parser_init(
-        &parser, options->fragment_context, options->fragment_namespace);
+        parser, options->fragment_context, options->fragment_namespace);
   }
+}
 
-  GumboParserState* state = parser._parser_state;
-  gumbo_debug("Parsing %.*s.\n", length, buffer);
-
-  // Sanity check so that infinite loops die with an assertion failure instead
-  // of hanging the process before we ever get an error.
-  int loop_count = 0;
-
-  GumboToken token;
-  bool has_error = false;
+// Runs the tree construction over the input given so far.  Returns true once
+// the EOF token has been handled, or false when the tokenizer ran out of
+// non-final input and the parse has to be resumed with more input.
+static bool run_parser(GumboParser* parser, GumboToken* token,
+    bool* has_error, int* loop_count) {
+  const GumboOptions* options = parser->_options;
+  GumboParserState* state = parser->_parser_state;
 
   do {
     if (state->_reprocess_current_token) {
       state->_reprocess_current_token = false;
     } else {
-      GumboNode* current_node = get_current_node(&parser);
-      gumbo_tokenizer_set_is_current_node_foreign(&parser,
+      GumboNode* current_node = get_current_node(parser);
+      gumbo_tokenizer_set_is_current_node_foreign(parser,
           current_node &&
               current_node->v.element.tag_namespace != GUMBO_NAMESPACE_HTML);
-      has_error = !gumbo_lex(&parser, &token) || has_error;
+      *has_error = !gumbo_lex(parser, token) || *has_error;
+      if (gumbo_tokenizer_needs_input(parser)) {
+        return false;
+      }
     }
     const char* token_type = "text";
-    switch (token.type) {
+    switch (token->type) {
       case GUMBO_TOKEN_DOCTYPE:
         token_type = "doctype";
         break;
       case GUMBO_TOKEN_START_TAG:
-        token_type = gumbo_normalized_tagname(token.v.start_tag.tag);
+        token_type = gumbo_normalized_tagname(token->v.start_tag.tag);
         break;
       case GUMBO_TOKEN_END_TAG:
-        token_type = gumbo_normalized_tagname(token.v.end_tag);
+        token_type = gumbo_normalized_tagname(token->v.end_tag);
         break;
       case GUMBO_TOKEN_COMMENT:
         token_type = "comment";
@@ -4123,51 +4139,147 @@ GumboOutput* gumbo_parse_with_options(
         break;
     }
     gumbo_debug("Handling %s token @%d:%d in state %d.\n", (char*) token_type,
-        token.position.line, token.position.column, state->_insertion_mode);
+        token->position.line, token->position.column, state->_insertion_mode);
 
-    state->_current_token = &token;
+    state->_current_token = token;
     state->_self_closing_flag_acknowledged =
-        !(token.type == GUMBO_TOKEN_START_TAG &&
-            token.v.start_tag.is_self_closing);
+        !(token->type == GUMBO_TOKEN_START_TAG &&
+            token->v.start_tag.is_self_closing);
 
-    has_error = !handle_token(&parser, &token) || has_error;
+    *has_error = !handle_token(parser, token) || *has_error;
 
     // Check for memory leaks when ownership is transferred from start tag
     // tokens to nodes.
     assert(state->_reprocess_current_token ||
-           token.type != GUMBO_TOKEN_START_TAG ||
-           token.v.start_tag.attributes.data == NULL);
+           token->type != GUMBO_TOKEN_START_TAG ||
+           token->v.start_tag.attributes.data == NULL);
 
     if (!state->_self_closing_flag_acknowledged) {
-      GumboError* error = parser_add_parse_error(&parser, &token);
+      GumboError* error = parser_add_parse_error(parser, token);
       if (error) {
         error->type = GUMBO_ERR_UNACKNOWLEDGED_SELF_CLOSING_TAG;
       }
     }
 
-    ++loop_count;
-    assert(loop_count < 1000000000);
+    ++*loop_count;
+    assert(*loop_count < 1000000000);
 
-  } while ((token.type != GUMBO_TOKEN_EOF || state->_reprocess_current_token) &&
-           !(options->stop_on_first_error && has_error));
+  } while ((token->type != GUMBO_TOKEN_EOF ||
+               state->_reprocess_current_token) &&
+           !(options->stop_on_first_error && *has_error));
+  return true;
+}
 
-  finish_parsing(&parser);
+static GumboOutput* parser_finish(GumboParser* parser) {
+  finish_parsing(parser);
   // For API uniformity reasons, if the doctype still has nulls, convert them to
   // empty strings.
-  GumboDocument* doc_type = &parser._output->document->v.document;
+  GumboDocument* doc_type = &parser->_output->document->v.document;
   if (doc_type->name == NULL) {
-    doc_type->name = gumbo_copy_stringz(&parser, "");
+    doc_type->name = gumbo_copy_stringz(parser, "");
   }
   if (doc_type->public_identifier == NULL) {
-    doc_type->public_identifier = gumbo_copy_stringz(&parser, "");
+    doc_type->public_identifier = gumbo_copy_stringz(parser, "");
   }
   if (doc_type->system_identifier == NULL) {
-    doc_type->system_identifier = gumbo_copy_stringz(&parser, "");
+    doc_type->system_identifier = gumbo_copy_stringz(parser, "");
+  }
+
+  parser_state_destroy(parser);
+  gumbo_tokenizer_state_destroy(parser);
+  return parser->_output;
+}
+
+GumboOutput* gumbo_parse_with_options(
+    const GumboOptions* options, const char* buffer, size_t length) {
+  GumboParser parser;
+  parser_init(&parser, options, buffer, length);
+  gumbo_debug("Parsing %.*s.\n", length, buffer);
+
+  // Sanity check so that infinite loops die with an assertion failure instead
+  // of hanging the process before we ever get an error.
+  int loop_count = 0;
+
+  GumboToken token;
+  bool has_error = false;
+  run_parser(&parser, &token, &has_error, &loop_count);
+  return parser_finish(&parser);
+}
+
+struct GumboInternalIncrementalParser {
+  GumboParser _parser;
+  GumboToken _token;
+  bool _has_error;
+  bool _done;
+  int _loop_count;
+  // The buffer passed to the last feed call.
+  const char* _buffer;
+  size_t _length;
+};
+
+GumboIncrementalParser* gumbo_incremental_parser_create(
+    const GumboOptions* options) {
+  GumboParser allocation_parser;
+  allocation_parser._options = options;
+  GumboIncrementalParser* incremental = gumbo_parser_allocate(
+      &allocation_parser, sizeof(GumboIncrementalParser));
+  incremental->_has_error = false;
+  incremental->_done = false;
+  incremental->_loop_count = 0;
+  incremental->_buffer = "";
+  incremental->_length = 0;
+  parser_init(&incremental->_parser, options, incremental->_buffer, 0);
+  gumbo_tokenizer_set_input_is_final(&incremental->_parser, false);
+  return incremental;
+}
+
+void gumbo_incremental_parser_feed(
+    GumboIncrementalParser* incremental, const char* buffer, size_t length) {
+  assert(length >= incremental->_length);
+  if (incremental->_done) {
+    return;
+  }
+  GumboParser* parser = &incremental->_parser;
+  if (buffer != incremental->_buffer) {
+    // Text buffered for the next text node still points into the old buffer.
+    TextNodeBufferState* text = &parser->_parser_state->_text_node;
+    if (text->_start_original_text >= incremental->_buffer &&
+        text->_start_original_text <=
+            incremental->_buffer + incremental->_length) {
+      text->_start_original_text =
+          buffer + (text->_start_original_text - incremental->_buffer);
+    }
   }
+  gumbo_tokenizer_extend_input(parser, buffer, length);
+  incremental->_buffer = buffer;
+  incremental->_length = length;
+  incremental->_done = run_parser(parser, &incremental->_token,
+      &incremental->_has_error, &incremental->_loop_count);
+}
+
+const GumboOutput* gumbo_incremental_parser_output(
+    const GumboIncrementalParser* incremental) {
+  return incremental->_parser._output;
+}
 
-  parser_state_destroy(&parser);
-  gumbo_tokenizer_state_destroy(&parser);
-  return parser._output;
+const GumboVector* gumbo_incremental_parser_open_elements(
+    const GumboIncrementalParser* incremental) {
+  return &incremental->_parser._parser_state->_open_elements;
+}
+
+GumboOutput* gumbo_incremental_parser_finish(
+    GumboIncrementalParser* incremental) {
+  GumboParser* parser = &incremental->_parser;
+  if (!incremental->_done) {
+    gumbo_tokenizer_set_input_is_final(parser, true);
+    gumbo_tokenizer_extend_input(
+        parser, incremental->_buffer, incremental->_length);
+    run_parser(parser, &incremental->_token, &incremental->_has_error,
+        &incremental->_loop_count);
+  }
+  GumboOutput* output = parser_finish(parser);
+  gumbo_parser_deallocate(parser, incremental);
+  return output;
 }
 
 void gumbo_destroy_node(GumboOptions* options, GumboNode* node) {
@@ -196,6 +196,14 @@ typedef struct GumboInternalTokenizerState {
 
   // The UTF8Iterator over the tokenizer input.
   Utf8Iterator _input;
+
+  // False while more input may follow the end of _input, see
+  // gumbo_tokenizer_set_input_is_final.  True for a normal, one-shot parse.
+  bool _is_input_final;
+
+  // Set when the last call to gumbo_lex stopped at the end of non-final input
+  // without producing a token.
+  bool _needs_input;
 } GumboTokenizerState;
 
 // Adds an ERR_UNEXPECTED_CODE_POINT parse error to the parser's error struct.
@@ -668,6 +676,39 @@ static void append_char_to_tag_buffer(
   gumbo_string_buffer_append_codepoint(parser, codepoint, buffer);
 }
 
+// Appends the plain text in [start, stop) to |output|, and moves the input
+// onto the last character of it.  The input must be at |start|.
+static void append_plain_text(GumboParser* parser, const char* start,
+    const char* stop, GumboStringBuffer* output) {
+  assert(stop > start);
+  GumboStringPiece run = {start, stop - start};
+  gumbo_string_buffer_append_string(parser, &run, output);
+  const char* last = stop - 1;
+  while ((*(const unsigned char*) last & 0xC0) == 0x80) {
+    --last;
+  }
+  utf8iterator_skip_plain_text(&parser->_tokenizer_state->_input, last);
+}
+
+// Appends the current character of a quoted attribute value to the tag buffer,
+// along with the plain text after it up to the closing |quote| or the next
+// character reference, which needs no other handling in these states.  The
+// input is left on the last character appended, so that advancing it as usual
+// continues after the run.
+static void append_attr_value_run_to_tag_buffer(
+    GumboParser* parser, int c, char quote) {
+  Utf8Iterator* input = &parser->_tokenizer_state->_input;
+  const char* start = utf8iterator_get_char_pointer(input);
+  const char* plain_end = utf8iterator_get_plain_text_end(input);
+  if (start == plain_end) {
+    append_char_to_tag_buffer(parser, c, false);
+    return;
+  }
+  const char* stop = utf8_find_either(start, plain_end, quote, '&');
+  append_plain_text(
+      parser, start, stop, &parser->_tokenizer_state->_tag_state._buffer);
+}
+
 // (Re-)initialize the tag buffer.  This also resets the original_text pointer
 // and _start_pos field to point to the current position.
 static void initialize_tag_buffer(GumboParser* parser) {
@@ -860,6 +901,9 @@ void gumbo_tokenizer_state_init(
   mark_tag_state_as_empty(&tokenizer->_tag_state);
 
   gumbo_string_buffer_init(parser, &tokenizer->_script_data_buffer);
+  tokenizer->_tag_state._original_text = NULL;
+  tokenizer->_is_input_final = true;
+  tokenizer->_needs_input = false;
   tokenizer->_token_start = text;
   utf8iterator_init(parser, text, text_length, &tokenizer->_input);
   utf8iterator_get_position(&tokenizer->_input, &tokenizer->_token_start_pos);
@@ -876,6 +920,52 @@ void gumbo_tokenizer_state_destroy(GumboParser* parser) {
   gumbo_parser_deallocate(parser, tokenizer);
 }
 
+void gumbo_tokenizer_set_input_is_final(GumboParser* parser, bool is_final) {
+  parser->_tokenizer_state->_is_input_final = is_final;
+  utf8iterator_set_input_is_final(&parser->_tokenizer_state->_input, is_final);
+}
+
+bool gumbo_tokenizer_needs_input(GumboParser* parser) {
+  return parser->_tokenizer_state->_needs_input;
+}
+
+// Moves |pointer| to the same offset in |new_text| when it points into the
+// input which started at |old_text|.
+static const char* rebase_input_pointer(const char* pointer,
+    const char* old_text, const char* old_end, const char* new_text) {
+  if (pointer == NULL || pointer < old_text || pointer > old_end) {
+    return pointer;
+  }
+  return new_text + (pointer - old_text);
+}
+
+void gumbo_tokenizer_extend_input(
+    GumboParser* parser, const char* text, size_t text_length) {
+  GumboTokenizerState* tokenizer = parser->_tokenizer_state;
+  Utf8Iterator* input = &tokenizer->_input;
+  const char* old_text = input->_start - input->_pos.offset;
+  const char* old_end = utf8iterator_get_end_pointer(input);
+  if (old_text != text) {
+    tokenizer->_token_start = rebase_input_pointer(
+        tokenizer->_token_start, old_text, old_end, text);
+    tokenizer->_tag_state._original_text = rebase_input_pointer(
+        tokenizer->_tag_state._original_text, old_text, old_end, text);
+  }
+  const char* held_start = text + input->_pos.offset;
+  utf8iterator_extend(input, text, text_length);
+  if (utf8iterator_get_char_pointer(input) != held_start) {
+    // The start points recorded at a carriage return held back at the end of
+    // the old input move past it, the same as with the whole input.
+    if (tokenizer->_token_start == held_start) {
+      reset_token_start_point(tokenizer);
+    }
+    if (tokenizer->_tag_state._original_text == held_start) {
+      reset_tag_buffer_start_point(parser);
+    }
+  }
+  tokenizer->_needs_input = false;
+}
+
 void gumbo_tokenizer_set_state(GumboParser* parser, GumboTokenizerEnum state) {
   parser->_tokenizer_state->_state = state;
 }
@@ -1791,7 +1881,7 @@ static StateResult handle_attr_value_double_quoted_state(GumboParser* parser,
       tokenizer->_reconsume_current_input = true;
       return NEXT_CHAR;
     default:
-      append_char_to_tag_buffer(parser, c, false);
+      append_attr_value_run_to_tag_buffer(parser, c, '"');
       return NEXT_CHAR;
   }
 }
@@ -1819,7 +1909,7 @@ static StateResult handle_attr_value_single_quoted_state(GumboParser* parser,
       tokenizer->_reconsume_current_input = true;
       return NEXT_CHAR;
     default:
-      append_char_to_tag_buffer(parser, c, false);
+      append_attr_value_run_to_tag_buffer(parser, c, '\'');
       return NEXT_CHAR;
   }
 }
@@ -2809,6 +2899,48 @@ static GumboLexerStateFunction dispatch_table[] = {handle_data_state,
     handle_after_doctype_system_id_state, handle_bogus_doctype_state,
     handle_cdata_state};
 
+bool gumbo_tokenizer_consume_text(
+    GumboParser* parser, GumboStringBuffer* output) {
+  GumboTokenizerState* tokenizer = parser->_tokenizer_state;
+  if (tokenizer->_buffered_emit_char != kGumboNoChar ||
+      tokenizer->_temporary_buffer_emit) {
+    return false;
+  }
+  // The characters these states don't emit as they are.  Plain text never
+  // contains NUL, so it's only there to fill in the pair.
+  char stop_a;
+  char stop_b;
+  switch (tokenizer->_state) {
+    case GUMBO_LEX_DATA:
+    case GUMBO_LEX_RCDATA:
+      stop_a = '<';
+      stop_b = '&';
+      break;
+    case GUMBO_LEX_RAWTEXT:
+    case GUMBO_LEX_SCRIPT:
+      stop_a = '<';
+      stop_b = '\0';
+      break;
+    case GUMBO_LEX_PLAINTEXT:
+      stop_a = '\0';
+      stop_b = '\0';
+      break;
+    default:
+      return false;
+  }
+  Utf8Iterator* input = &tokenizer->_input;
+  const char* start = utf8iterator_get_char_pointer(input);
+  const char* stop = utf8_find_either(
+      start, utf8iterator_get_plain_text_end(input), stop_a, stop_b);
+  if (stop == start) {
+    return false;
+  }
+  append_plain_text(parser, start, stop, output);
+  utf8iterator_next(input);
+  reset_token_start_point(tokenizer);
+  return true;
+}
+
 bool gumbo_lex(GumboParser* parser, GumboToken* output) {
   // Because of the spec requirements that...
   //
@@ -2825,6 +2957,7 @@ bool gumbo_lex(GumboParser* parser, GumboToken* output) {
   // are responsible for changing state (eg. flushing the chardata buffer,
   // reading the next input character) to avoid an infinite loop.
   GumboTokenizerState* tokenizer = parser->_tokenizer_state;
+  tokenizer->_needs_input = false;
 
   if (tokenizer->_buffered_emit_char != kGumboNoChar) {
     tokenizer->_reconsume_current_input = true;
@@ -2845,6 +2978,12 @@ bool gumbo_lex(GumboParser* parser, GumboToken* output) {
     assert(!tokenizer->_temporary_buffer_emit);
     assert(tokenizer->_buffered_emit_char == kGumboNoChar);
     int c = utf8iterator_current(&tokenizer->_input);
+    if (c == -1 && !tokenizer->_is_input_final) {
+      // Every state keeps its progress in the tokenizer struct, so lexing can
+      // stop here and resume in the same state once more input arrives.
+      tokenizer->_needs_input = true;
+      return true;
+    }
     gumbo_debug(
         "Lexing character '%c' (%d) in state %d.\n", c, c, tokenizer->_state);
     StateResult result =
@@ -24,6 +24,7 @@
 #include <stddef.h>
 
 #include "gumbo.h"
+#include "string_buffer.h"
 #include "token_type.h"
 #include "tokenizer_states.h"
 
@@ -78,6 +79,24 @@ void gumbo_tokenizer_state_init(
 // dynamically-allocated structures within it.
 void gumbo_tokenizer_state_destroy(struct GumboInternalParser* parser);
 
+// Marks whether the input given to the tokenizer is the whole document.  When
+// it is not, gumbo_lex stops at the end of the available input without
+// emitting a token, and gumbo_tokenizer_needs_input returns true until more
+// input is passed to gumbo_tokenizer_extend_input.
+void gumbo_tokenizer_set_input_is_final(
+    struct GumboInternalParser* parser, bool is_final);
+
+// Whether the last call to gumbo_lex ran out of non-final input instead of
+// producing a token.
+bool gumbo_tokenizer_needs_input(struct GumboInternalParser* parser);
+
+// Continues the input with |text|, which must begin with all of the input
+// given so far.  If it lives at a different address, the pointers into the old
+// buffer are moved to |text|.  The old buffer must stay alive as long as the
+// parse tree, because finished nodes keep pointing into it.
+void gumbo_tokenizer_extend_input(
+    struct GumboInternalParser* parser, const char* text, size_t text_length);
+
 // Sets the tokenizer state to the specified value.  This is needed by some
 // parser states, which alter the state of the tokenizer in response to tags
 // seen.
@@ -106,6 +125,15 @@ void gumbo_tokenizer_set_is_current_node_foreign(
 //   gumbo_tokenizer_state_destroy(&parser);
 bool gumbo_lex(struct GumboInternalParser* parser, GumboToken* output);
 
+// Appends the text at the current input position which the current state would
+// emit as character tokens, without entity or NUL handling, to |output|, and
+// moves the input past it.  This lets the tree builder take whole runs of text
+// after a character token instead of lexing them one code point at a time.
+// Only the data, RCDATA, RAWTEXT, script data and PLAINTEXT states have such
+// runs; returns whether any text was consumed.
+bool gumbo_tokenizer_consume_text(
+    struct GumboInternalParser* parser, GumboStringBuffer* output);
+
 // Frees the internally-allocated pointers within an GumboToken.  Note that this
 // doesn't free the token itself, since oftentimes it will be allocated on the
 // stack.  A simple call to free() (or GumboParser->deallocator, if
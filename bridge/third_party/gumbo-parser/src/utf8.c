@@ -27,8 +27,20 @@
 #include "util.h"
 #include "vector.h"
 
+#if defined(__GNUC__) && defined(__SSE2__)
+#include <emmintrin.h>
+#define GUMBO_UTF8_SSE2 1
+#elif defined(__GNUC__) && defined(__aarch64__) && defined(__ARM_NEON)
+#include <arm_neon.h>
+#define GUMBO_UTF8_NEON 1
+#endif
+
 const int kUtf8ReplacementChar = 0xFFFD;
 
+// Plain text is looked for in slices, so that going back to a mark before it
+// never has to scan far ahead again.
+static const size_t kMaximumPlainTextScan = 4096;
+
 // Reference material:
 // Wikipedia: http://en.wikipedia.org/wiki/UTF-8#Description
 // RFC 3629: http://tools.ietf.org/html/rfc3629
@@ -97,6 +109,228 @@ uint32_t static inline decode(uint32_t* state, uint32_t* codep, uint32_t byte) {
 
 // END COPIED CODE.
 
+// Plain text is the part of the input which the decoder below would return
+// unchanged, one code point per character, without recording any error: tabs,
+// newlines, printable ASCII, and well formed 2 and 3 byte sequences whose lead
+// byte alone guarantees that the code point is allowed.  Lead bytes which need
+// a look at the next byte (0xC2 for the C1 controls, 0xE0 for overlong forms,
+// 0xED for surrogates, 0xEF for the noncharacters) and 4 byte sequences are
+// only accepted by the scalar scan, or left to the decoder.  Carriage returns
+// and NUL are never plain text, so the tokenizer states can skip plain text
+// without looking at each character.
+
+// Returns the length of the sequence led by |c| if it can start plain text,
+// 0 otherwise.
+static inline int plain_text_sequence_length(unsigned char c) {
+  if (c >= 0x20 && c < 0x7F) {
+    return 1;
+  }
+  if (c == '\t' || c == '\n') {
+    return 1;
+  }
+  if (c >= 0xC2 && c < 0xE0) {
+    return 2;
+  }
+  if (c >= 0xE0 && c < 0xF0) {
+    return 3;
+  }
+  return 0;
+}
+
+static inline bool is_continuation_byte(unsigned char c) {
+  return (c & 0xC0) == 0x80;
+}
+
+// Scans the characters of plain text starting before |limit|, and returns the
+// start of the first one which isn't plain text, or the first character
+// starting from |limit|.
+static const char* scan_plain_text_scalar(
+    const char* p, const char* limit, const char* end) {
+  while (p < limit) {
+    const unsigned char* c = (const unsigned char*) p;
+    int length = plain_text_sequence_length(c[0]);
+    if (length == 0 || end - p < length) {
+      return p;
+    }
+    if (length == 2) {
+      if (!is_continuation_byte(c[1]) || (c[0] == 0xC2 && c[1] < 0xA0)) {
+        return p;
+      }
+    } else if (length == 3) {
+      if (!is_continuation_byte(c[1]) || !is_continuation_byte(c[2]) ||
+          (c[0] == 0xE0 && c[1] < 0xA0) || (c[0] == 0xED && c[1] >= 0xA0)) {
+        return p;
+      }
+      if (c[0] == 0xEF) {
+        int code_point = 0xF000 | ((c[1] & 0x3F) << 6) | (c[2] & 0x3F);
+        if (utf8_is_invalid_code_point(code_point)) {
+          return p;
+        }
+      }
+    }
+    p += length;
+  }
+  return p;
+}
+
+#if GUMBO_UTF8_SSE2
+
+// Validates 16 bytes at a time, starting at the beginning of a character.
+// Returns the start of the first block which has a byte that may not be plain
+// text, which can be in the middle of a character of the block before it.
+static const char* scan_plain_text_blocks(const char* p, const char* end) {
+  // Signed comparisons: bytes from 0x80 on are negative.
+  const __m128i all = _mm_set1_epi8((char) 0xFF);
+  __m128i previous_leads = _mm_setzero_si128();
+  __m128i previous_leads3 = _mm_setzero_si128();
+  for (; end - p >= 16; p += 16) {
+    __m128i v = _mm_loadu_si128((const __m128i*) p);
+    __m128i ascii = _mm_or_si128(
+        _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8(0x1F)),
+            _mm_cmplt_epi8(v, _mm_set1_epi8(0x7F))),
+        _mm_or_si128(_mm_cmpeq_epi8(v, _mm_set1_epi8('\t')),
+            _mm_cmpeq_epi8(v, _mm_set1_epi8('\n'))));
+    __m128i continuation = _mm_cmplt_epi8(v, _mm_set1_epi8((char) 0xC0));
+    __m128i leads2 =
+        _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8((char) 0xC2)),
+            _mm_cmplt_epi8(v, _mm_set1_epi8((char) 0xE0)));
+    __m128i leads3 = _mm_or_si128(
+        _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8((char) 0xE0)),
+            _mm_cmplt_epi8(v, _mm_set1_epi8((char) 0xED))),
+        _mm_cmpeq_epi8(v, _mm_set1_epi8((char) 0xEE)));
+    __m128i leads = _mm_or_si128(leads2, leads3);
+    // Continuation bytes are exactly the ones following lead bytes.
+    __m128i expected = _mm_or_si128(
+        _mm_or_si128(
+            _mm_slli_si128(leads, 1), _mm_srli_si128(previous_leads, 15)),
+        _mm_or_si128(
+            _mm_slli_si128(leads3, 2), _mm_srli_si128(previous_leads3, 14)));
+    __m128i valid = _mm_or_si128(_mm_or_si128(ascii, continuation), leads);
+    __m128i bad = _mm_or_si128(
+        _mm_xor_si128(valid, all), _mm_xor_si128(expected, continuation));
+    if (_mm_movemask_epi8(bad) != 0) {
+      break;
+    }
+    previous_leads = leads;
+    previous_leads3 = leads3;
+  }
+  return p;
+}
+
+#elif GUMBO_UTF8_NEON
+
+// See the SSE2 version.
+static const char* scan_plain_text_blocks(const char* p, const char* end) {
+  uint8x16_t previous_leads = vdupq_n_u8(0);
+  uint8x16_t previous_leads3 = vdupq_n_u8(0);
+  for (; end - p >= 16; p += 16) {
+    uint8x16_t v = vld1q_u8((const uint8_t*) p);
+    uint8x16_t ascii = vorrq_u8(
+        vandq_u8(vcgtq_u8(v, vdupq_n_u8(0x1F)), vcltq_u8(v, vdupq_n_u8(0x7F))),
+        vorrq_u8(vceqq_u8(v, vdupq_n_u8('\t')), vceqq_u8(v, vdupq_n_u8('\n'))));
+    uint8x16_t continuation =
+        vandq_u8(vcgeq_u8(v, vdupq_n_u8(0x80)), vcltq_u8(v, vdupq_n_u8(0xC0)));
+    uint8x16_t leads2 =
+        vandq_u8(vcgtq_u8(v, vdupq_n_u8(0xC2)), vcltq_u8(v, vdupq_n_u8(0xE0)));
+    uint8x16_t leads3 = vorrq_u8(
+        vandq_u8(vcgtq_u8(v, vdupq_n_u8(0xE0)), vcltq_u8(v, vdupq_n_u8(0xED))),
+        vceqq_u8(v, vdupq_n_u8(0xEE)));
+    uint8x16_t leads = vorrq_u8(leads2, leads3);
+    uint8x16_t expected = vorrq_u8(vextq_u8(previous_leads, leads, 15),
+        vextq_u8(previous_leads3, leads3, 14));
+    uint8x16_t valid = vorrq_u8(vorrq_u8(ascii, continuation), leads);
+    uint8x16_t bad =
+        vorrq_u8(vmvnq_u8(valid), veorq_u8(expected, continuation));
+    if (vmaxvq_u8(bad) != 0) {
+      break;
+    }
+    previous_leads = leads;
+    previous_leads3 = leads3;
+  }
+  return p;
+}
+
+#endif
+
+// Returns the end of the plain text starting at |begin|, which must be the
+// beginning of a character.
+static const char* scan_plain_text(const char* begin, const char* end) {
+  const char* p = begin;
+#if GUMBO_UTF8_SSE2 || GUMBO_UTF8_NEON
+  while (end - p >= 16) {
+    p = scan_plain_text_blocks(p, end);
+    // The last character before the block that stopped the vectorized scan
+    // may continue into it, check it again.
+    const char* last = p;
+    while (last > begin && is_continuation_byte((unsigned char) last[-1])) {
+      --last;
+    }
+    if (last > begin &&
+        plain_text_sequence_length((unsigned char) last[-1]) > p - last + 1) {
+      p = last - 1;
+    }
+    const char* limit = end - p > 16 ? p + 16 : end;
+    const char* stop = scan_plain_text_scalar(p, limit, end);
+    if (stop < limit) {
+      return stop;
+    }
+    p = stop;
+  }
+#endif
+  return scan_plain_text_scalar(p, end, end);
+}
+
+const char* utf8_find_either(const char* p, const char* end, char a, char b) {
+#if GUMBO_UTF8_SSE2
+  const __m128i needle_a = _mm_set1_epi8(a);
+  const __m128i needle_b = _mm_set1_epi8(b);
+  for (; end - p >= 16; p += 16) {
+    __m128i v = _mm_loadu_si128((const __m128i*) p);
+    int mask = _mm_movemask_epi8(
+        _mm_or_si128(_mm_cmpeq_epi8(v, needle_a), _mm_cmpeq_epi8(v, needle_b)));
+    if (mask != 0) {
+      return p + __builtin_ctz(mask);
+    }
+  }
+#elif GUMBO_UTF8_NEON
+  const uint8x16_t needle_a = vdupq_n_u8((uint8_t) a);
+  const uint8x16_t needle_b = vdupq_n_u8((uint8_t) b);
+  for (; end - p >= 16; p += 16) {
+    uint8x16_t v = vld1q_u8((const uint8_t*) p);
+    uint8x16_t matches = vorrq_u8(vceqq_u8(v, needle_a), vceqq_u8(v, needle_b));
+    // Narrows each byte of the comparison to 4 bits.
+    uint64_t mask = vget_lane_u64(
+        vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8(matches), 4)), 0);
+    if (mask != 0) {
+      return p + (__builtin_ctzll(mask) >> 2);
+    }
+  }
+#endif
+  for (; p < end; ++p) {
+    if (*p == a || *p == b) {
+      return p;
+    }
+  }
+  return end;
+}
+
+// Decodes the character at the current position of plain text, which is
+// known to be well formed and allowed.
+static void read_plain_char(Utf8Iterator* iter) {
+  const unsigned char* c = (const unsigned char*) iter->_start;
+  if (c[0] < 0x80) {
+    iter->_current = c[0];
+    iter->_width = 1;
+  } else if (c[0] < 0xE0) {
+    iter->_current = ((c[0] & 0x1F) << 6) | (c[1] & 0x3F);
+    iter->_width = 2;
+  } else {
+    iter->_current =
+        ((c[0] & 0x0F) << 12) | ((c[1] & 0x3F) << 6) | (c[2] & 0x3F);
+    iter->_width = 3;
+  }
+}
+
 // Adds a decoding error to the parser's error list, based on the current state
 // of the Utf8Iterator.
 static void add_error(Utf8Iterator* iter, GumboErrorType type) {
@@ -132,6 +366,19 @@ static void read_char(Utf8Iterator* iter) {
     return;
   }
 
+  if (iter->_start >= iter->_plain_end) {
+    const char* limit = iter->_end;
+    if ((size_t) (limit - iter->_start) > kMaximumPlainTextScan) {
+      limit = iter->_start + kMaximumPlainTextScan;
+    }
+    iter->_plain_begin = iter->_start;
+    iter->_plain_end = scan_plain_text(iter->_start, limit);
+  }
+  if (iter->_start < iter->_plain_end) {
+    read_plain_char(iter);
+    return;
+  }
+
   uint32_t code_point = 0;
   uint32_t state = UTF8_ACCEPT;
   for (const char* c = iter->_start; c < iter->_end; ++c) {
@@ -146,6 +393,12 @@ static void read_char(Utf8Iterator* iter) {
       if (code_point == '\r') {
         assert(iter->_width == 1);
         const char* next = c + 1;
+        if (next == iter->_end && !iter->_is_input_final) {
+          // The next chunk may start with the '\n' of a CRLF pair.
+          iter->_current = -1;
+          iter->_width = 0;
+          return;
+        }
         if (next < iter->_end && *next == '\n') {
           // Advance the iter, as if the carriage return didn't exist.
           ++iter->_start;
@@ -171,10 +424,16 @@ static void read_char(Utf8Iterator* iter) {
     }
   }
   // If we got here without exiting early, then we've reached the end of the
-  // iterator.  Add an error for truncated input, set the width to consume the
-  // rest of the iterator, and emit a replacement character.  The next time we
-  // enter this method, it will detect that there's no input to consume and
-  // output an EOF.
+  // iterator.  When more input may follow, the rest of the character is in the
+  // next chunk.
+  if (!iter->_is_input_final) {
+    iter->_current = -1;
+    iter->_width = 0;
+    return;
+  }
+  // Add an error for truncated input, set the width to consume the rest of the
+  // iterator, and emit a replacement character.  The next time we enter this
+  // method, it will detect that there's no input to consume and output an EOF.
   iter->_current = kUtf8ReplacementChar;
   iter->_width = iter->_end - iter->_start;
   add_error(iter, GUMBO_ERR_UTF8_TRUNCATED);
@@ -204,14 +463,42 @@ bool utf8_is_invalid_code_point(int c) {
 void utf8iterator_init(GumboParser* parser, const char* source,
     size_t source_length, Utf8Iterator* iter) {
   iter->_start = source;
+  iter->_mark = source;
   iter->_end = source + source_length;
   iter->_pos.line = 1;
   iter->_pos.column = 1;
   iter->_pos.offset = 0;
   iter->_parser = parser;
+  iter->_plain_begin = source;
+  iter->_plain_end = source;
+  iter->_is_input_final = true;
   read_char(iter);
 }
 
+void utf8iterator_set_input_is_final(Utf8Iterator* iter, bool is_final) {
+  iter->_is_input_final = is_final;
+}
+
+void utf8iterator_extend(
+    Utf8Iterator* iter, const char* source, size_t source_length) {
+  // _pos.offset is always the offset of _start from the beginning of the input.
+  const char* old_source = iter->_start - iter->_pos.offset;
+  iter->_start = source + (iter->_start - old_source);
+  iter->_mark = source + (iter->_mark - old_source);
+  iter->_plain_begin = source + (iter->_plain_begin - old_source);
+  iter->_plain_end = source + (iter->_plain_end - old_source);
+  iter->_end = source + source_length;
+  const char* held_start = iter->_start;
+  read_char(iter);
+  if (iter->_start != held_start && iter->_mark == held_start) {
+    // A carriage return held back at the end of the old input starts a CRLF
+    // pair, which read_char skipped.  A mark there moves along, as it would
+    // have been set after the skip with the whole input.
+    iter->_mark = iter->_start;
+    iter->_mark_pos = iter->_pos;
+  }
+}
+
 void utf8iterator_next(Utf8Iterator* iter) {
   // We update positions based on the *last* character read, so that the first
   // character following a newline is at column 1 in the next line.
@@ -222,6 +509,33 @@ void utf8iterator_next(Utf8Iterator* iter) {
 
 int utf8iterator_current(const Utf8Iterator* iter) { return iter->_current; }
 
+const char* utf8iterator_get_plain_text_end(const Utf8Iterator* iter) {
+  return iter->_start < iter->_plain_end ? iter->_plain_end : iter->_start;
+}
+
+void utf8iterator_skip_plain_text(Utf8Iterator* iter, const char* position) {
+  assert(position >= iter->_start && position < iter->_plain_end);
+  // The same position updates as utf8iterator_next, for all the characters
+  // before |position|.
+  for (const char* c = iter->_start; c < position; ++c) {
+    if (is_continuation_byte((unsigned char) *c)) {
+      continue;
+    }
+    if (*c == '\n') {
+      ++iter->_pos.line;
+      iter->_pos.column = 1;
+    } else if (*c == '\t') {
+      int tab_stop = iter->_parser->_options->tab_stop;
+      iter->_pos.column = ((iter->_pos.column / tab_stop) + 1) * tab_stop;
+    } else {
+      ++iter->_pos.column;
+    }
+  }
+  iter->_pos.offset += position - iter->_start;
+  iter->_start = position;
+  read_plain_char(iter);
+}
+
 void utf8iterator_get_position(
     const Utf8Iterator* iter, GumboSourcePosition* output) {
   *output = iter->_pos;
@@ -259,6 +573,10 @@ void utf8iterator_mark(Utf8Iterator* iter) {
 void utf8iterator_reset(Utf8Iterator* iter) {
   iter->_start = iter->_mark;
   iter->_pos = iter->_mark_pos;
+  // Any character of plain text starts plain text, unless the mark is before.
+  if (iter->_start < iter->_plain_begin) {
+    iter->_plain_end = iter->_start;
+  }
   read_char(iter);
 }
 
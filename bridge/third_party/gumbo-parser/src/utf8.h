@@ -64,12 +64,22 @@ typedef struct GumboInternalUtf8Iterator {
   // The width in bytes of the current code point.
   int _width;
 
+  // The plain text the current code point is part of, if it is inside.  See
+  // utf8iterator_get_plain_text_end.
+  const char* _plain_begin;
+  const char* _plain_end;
+
   // The SourcePosition for the current location.
   GumboSourcePosition _pos;
 
   // The SourcePosition for the mark.
   GumboSourcePosition _mark_pos;
 
+  // Whether more input may follow _end.  When it may, a carriage return or a
+  // truncated character at the end is not read until the input is extended,
+  // so that they decode the same as when the input arrives at once.
+  bool _is_input_final;
+
   // Pointer back to the GumboParser instance, for configuration options and
   // error recording.
   struct GumboInternalParser* _parser;
@@ -84,12 +94,39 @@ bool utf8_is_invalid_code_point(int c);
 void utf8iterator_init(struct GumboInternalParser* parser, const char* source,
     size_t source_length, Utf8Iterator* iter);
 
+// Continues the input with a longer buffer.  |source| must start with every
+// byte the iterator was given before; if it lives at a different address, the
+// iterator is moved to the same offset in it.  Used by incremental parsing, see
+// gumbo_tokenizer_extend_input.  The current position moves past a carriage
+// return held back at the end of the old input when it starts a CRLF pair.
+void utf8iterator_extend(
+    Utf8Iterator* iter, const char* source, size_t source_length);
+
+// Sets whether the input may be extended later, see _is_input_final.  Takes
+// effect from the next character read.
+void utf8iterator_set_input_is_final(Utf8Iterator* iter, bool is_final);
+
 // Advances the current position by one code point.
 void utf8iterator_next(Utf8Iterator* iter);
 
 // Returns the current code point as an integer.
 int utf8iterator_current(const Utf8Iterator* iter);
 
+// Returns the end of the plain text which starts at the current character, or
+// the current position when the current character isn't part of plain text.
+// Plain text is well formed UTF-8 without carriage returns, NUL, or other
+// characters the HTML5 spec forbids, so it can be copied as is instead of being
+// decoded one code point at a time.  Only tabs and newlines are allowed among
+// the ASCII control characters.
+const char* utf8iterator_get_plain_text_end(const Utf8Iterator* iter);
+
+// Moves the current position forward to |position|, which must be the start
+// of a character before utf8iterator_get_plain_text_end.
+void utf8iterator_skip_plain_text(Utf8Iterator* iter, const char* position);
+
+// Returns the first occurrence of |a| or |b| in [p, end), or |end|.
+const char* utf8_find_either(const char* p, const char* end, char a, char b);
+
 // Retrieves and fills the output parameter with the current source position.
 void utf8iterator_get_position(
     const Utf8Iterator* iter, GumboSourcePosition* output);
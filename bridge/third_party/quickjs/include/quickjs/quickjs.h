@@ -730,6 +730,8 @@ int JS_SetPropertyInt64(JSContext* ctx, JSValueConst this_obj, int64_t idx, JSVa
 int JS_SetPropertyStr(JSContext* ctx, JSValueConst this_obj, const char* prop, JSValue val);
 int JS_HasProperty(JSContext* ctx, JSValueConst this_obj, JSAtom prop);
 int JS_IsExtensible(JSContext *ctx, JSValueConst obj);
+/* number of property slots in the shape of obj, deleted properties included */
+uint32_t JS_GetOwnShapePropertyCount(JSValueConst obj);
 int JS_PreventExtensions(JSContext *ctx, JSValueConst obj);
 int JS_DeleteProperty(JSContext *ctx, JSValueConst obj, JSAtom prop, int flags);
 int JS_SetPrototype(JSContext *ctx, JSValueConst obj, JSValueConst proto_val);
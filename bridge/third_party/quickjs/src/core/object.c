@@ -779,6 +779,12 @@ int JS_IsExtensible(JSContext* ctx, JSValueConst obj) {
     return p->extensible;
 }
 
+uint32_t JS_GetOwnShapePropertyCount(JSValueConst obj) {
+  if (unlikely(JS_VALUE_GET_TAG(obj) != JS_TAG_OBJECT))
+    return 0;
+  return JS_VALUE_GET_OBJ(obj)->shape->prop_count;
+}
+
 /* return -1 if exception (Proxy object only) or TRUE/FALSE */
 int JS_PreventExtensions(JSContext* ctx, JSValueConst obj) {
   JSObject* p;
@@ -151,6 +151,18 @@ void parseHTML(int32_t contextId, const char* code, int32_t length) {
   context->parseHTML(code, length);
 }
 
+void parseHTMLChunk(int32_t contextId, const char* code, int32_t length) {
+  assert(checkPage(contextId) && "parseHTMLChunk: contextId is not valid");
+  auto context = static_cast<webf::WebFPage*>(getPage(contextId));
+  context->parseHTMLChunk(code, length);
+}
+
+void finishParseHTML(int32_t contextId) {
+  assert(checkPage(contextId) && "finishParseHTML: contextId is not valid");
+  auto context = static_cast<webf::WebFPage*>(getPage(contextId));
+  context->finishParseHTML();
+}
+
 void reloadJsContext(int32_t contextId, uint64_t* dart_methods, int32_t dart_methods_len) {
   assert(checkPage(contextId) && "reloadJSContext: contextId is not valid");
   auto bridgePtr = getPage(contextId);
@@ -204,18 +216,73 @@ void registerUITask(int32_t contextId, Task task, void* data) {
   webf::UITaskQueue::instance(contextId)->registerTask(task, data);
 };
 
-void* getUICommandItems(int32_t contextId) {
+int64_t acquireUICommandSegments(int32_t contextId) {
+  auto* page = static_cast<webf::WebFPage*>(getPage(contextId));
+  if (page == nullptr)
+    return 0;
+  return page->GetExecutingContext()->uiCommandBuffer()->acquire()->segmentCount();
+}
+
+void* getUICommandItems(int32_t contextId, int64_t segment) {
+  auto* page = static_cast<webf::WebFPage*>(getPage(contextId));
+  if (page == nullptr)
+    return nullptr;
+  auto* command_segment = page->GetExecutingContext()->uiCommandBuffer()->acquired()->segment(segment);
+  if (command_segment == nullptr)
+    return nullptr;
+  return command_segment->items;
+}
+
+const uint16_t* getUICommandStrings(int32_t contextId) {
   auto* page = static_cast<webf::WebFPage*>(getPage(contextId));
   if (page == nullptr)
     return nullptr;
-  return page->GetExecutingContext()->uiCommandBuffer()->data();
+  return page->GetExecutingContext()->uiCommandBuffer()->acquired()->strings().data();
 }
 
-int64_t getUICommandItemSize(int32_t contextId) {
+int64_t getUICommandItemSize(int32_t contextId, int64_t segment) {
   auto* page = static_cast<webf::WebFPage*>(getPage(contextId));
   if (page == nullptr)
     return 0;
-  return page->GetExecutingContext()->uiCommandBuffer()->size();
+  auto* command_segment = page->GetExecutingContext()->uiCommandBuffer()->acquired()->segment(segment);
+  if (command_segment == nullptr)
+    return 0;
+  return command_segment->size;
+}
+
+void* getUICommandStats(int32_t contextId) {
+  auto* page = static_cast<webf::WebFPage*>(getPage(contextId));
+  if (page == nullptr)
+    return nullptr;
+  return const_cast<webf::UICommandStats*>(&page->GetExecutingContext()->uiCommandBuffer()->stats());
+}
+
+void resetUICommandStats(int32_t contextId) {
+  auto* page = static_cast<webf::WebFPage*>(getPage(contextId));
+  if (page == nullptr)
+    return;
+  page->GetExecutingContext()->uiCommandBuffer()->resetStats();
+}
+
+void invalidateGeometrySnapshots(int32_t contextId) {
+  auto* page = static_cast<webf::WebFPage*>(getPage(contextId));
+  if (page == nullptr)
+    return;
+  page->GetExecutingContext()->uiCommandBuffer()->invalidateLayout();
+}
+
+void* getEventCoalescingStats(int32_t contextId) {
+  auto* page = static_cast<webf::WebFPage*>(getPage(contextId));
+  if (page == nullptr)
+    return nullptr;
+  return const_cast<webf::EventCoalescingStats*>(&page->GetExecutingContext()->eventCoalescer()->stats());
+}
+
+void resetEventCoalescingStats(int32_t contextId) {
+  auto* page = static_cast<webf::WebFPage*>(getPage(contextId));
+  if (page == nullptr)
+    return;
+  page->GetExecutingContext()->eventCoalescer()->ResetStats();
 }
 
 void clearUICommandItems(int32_t contextId) {
@@ -225,6 +292,36 @@ void clearUICommandItems(int32_t contextId) {
   page->GetExecutingContext()->uiCommandBuffer()->clear();
 }
 
+void setUICommandCoalescingEnabled(int32_t contextId, int32_t enabled) {
+  auto* page = static_cast<webf::WebFPage*>(getPage(contextId));
+  if (page == nullptr)
+    return;
+  page->GetExecutingContext()->uiCommandBuffer()->setCoalescingEnabled(enabled != 0);
+}
+
+#if ENABLE_UI_COMMAND_PUBLISHING
+void setUICommandPublishingEnabled(int32_t contextId, int32_t enabled) {
+  auto* page = static_cast<webf::WebFPage*>(getPage(contextId));
+  if (page == nullptr)
+    return;
+  page->GetExecutingContext()->uiCommandBuffer()->setPublishingEnabled(enabled != 0);
+}
+
+void* pollUICommandSegment(int32_t contextId) {
+  auto* page = static_cast<webf::WebFPage*>(getPage(contextId));
+  if (page == nullptr)
+    return nullptr;
+  return page->GetExecutingContext()->uiCommandBuffer()->poll();
+}
+
+void releaseUICommandSegment(int32_t contextId, void* segment) {
+  auto* page = static_cast<webf::WebFPage*>(getPage(contextId));
+  if (page == nullptr)
+    return;
+  page->GetExecutingContext()->uiCommandBuffer()->release(static_cast<webf::UICommandPublishedSegment*>(segment));
+}
+#endif
+
 void registerContextDisposedCallbacks(int32_t contextId, Task task, void* data) {
   assert(checkPage(contextId));
   auto context = static_cast<webf::WebFPage*>(getPage(contextId));
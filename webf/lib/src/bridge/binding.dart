@@ -154,9 +154,33 @@ void _invokeBindingMethodFromNativeImpl(Pointer<NativeBindingObject> nativeBindi
   }
 }
 
-// Dispatch the event to the binding side.
+// Must match EventListenerTypeBits in bridge/core/dom/events/event_target.h.
+const Map<String, int> _eventListenerTypeBits = {
+  'click': 1 << 0,
+  'mousedown': 1 << 1,
+  'mouseup': 1 << 2,
+  'mousemove': 1 << 3,
+  'pointerdown': 1 << 4,
+  'pointermove': 1 << 5,
+  'pointerup': 1 << 6,
+  'pointercancel': 1 << 7,
+  'touchstart': 1 << 8,
+  'touchmove': 1 << 9,
+  'touchend': 1 << 10,
+  'touchcancel': 1 << 11,
+  'scroll': 1 << 12,
+};
+const int _otherEventListenerType = 1 << 31;
+
+int _eventListenerTypeBit(String type) => _eventListenerTypeBits[type] ?? _otherEventListenerType;
+
+// Dispatch the event to the binding side. It runs the capture, target and bubble phases for the whole event path of
+// the target in one call, so the other targets on the path listening at the binding side skip it.
 void _dispatchEventToNative(Event event) {
-  Pointer<NativeBindingObject>? pointer = event.currentTarget?.pointer;
+  if (event.dispatchedToNative) return;
+  event.dispatchedToNative = true;
+
+  Pointer<NativeBindingObject>? pointer = event.target?.pointer;
   int? contextId = event.target?.contextId;
   if (contextId != null && pointer != null && pointer.ref.invokeBindingMethodFromDart != nullptr) {
     BindingObject bindingObject = BindingBridge.getBindingObject(pointer);
@@ -164,7 +188,7 @@ void _dispatchEventToNative(Event event) {
     DartInvokeBindingMethodsFromDart f = pointer.ref.invokeBindingMethodFromDart.asFunction();
 
     Pointer<Void> rawEvent = event.toRaw().cast<Void>();
-    List<dynamic> dispatchEventArguments = [event.type, rawEvent];
+    List<dynamic> dispatchEventArguments = [event.type, rawEvent, true];
 
     if (isEnabledLog) {
       print('dispatch event to native side: target: ${event.target} arguments: $dispatchEventArguments');
@@ -232,6 +256,31 @@ abstract class BindingBridge {
     BindingObject.unbind = null;
   }
 
+  // Dispatch the event to the binding side if any target on its path listens to it there. Capturing listeners of the
+  // ancestors must run before the target's, so this happens before the event goes through the targets at Dart side.
+  static void dispatchEventAlongPath(Event event) {
+    event.dispatchedToNative = false;
+    EventTarget? target = event.target;
+    // The binding side keeps the types listened to on the path of each target, which tells at once about the
+    // frequent types having a bit of their own.
+    int typeBit = _eventListenerTypeBit(event.type);
+    Pointer<NativeBindingObject>? pointer = target?.pointer;
+    if (pointer != null && typeBit != _otherEventListenerType) {
+      if (pointer.ref.eventPathListenerTypes & typeBit != 0) {
+        _dispatchEventToNative(event);
+      }
+      return;
+    }
+    while (target != null) {
+      List<EventHandler>? handlers = target.getEventHandlers()[event.type];
+      if (handlers != null && handlers.contains(_dispatchEventToNative)) {
+        _dispatchEventToNative(event);
+        return;
+      }
+      target = target.parentEventTarget;
+    }
+  }
+
   static void listenEvent(EventTarget target, String type) {
     assert(_debugShouldNotListenMultiTimes(target, type),
         'Failed to listen event \'$type\' for $target, for which is already bound.');
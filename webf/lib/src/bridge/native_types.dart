@@ -105,11 +105,15 @@ class NativeBindingObject extends Struct {
   external Pointer<NativeFunction<InvokeBindingMethodsFromDart>> invokeBindingMethodFromDart;
   // Shared method called by JS side.
   external Pointer<NativeFunction<InvokeBindingsMethodsFromNative>> invokeBindingMethodFromNative;
+  // Bits from eventListenerTypeBit of the event types listened to somewhere on the event path of an event target.
+  @Uint32()
+  external int eventPathListenerTypes;
 }
 
 Pointer<NativeBindingObject> allocateNewBindingObject() {
   Pointer<NativeBindingObject> pointer = malloc.allocate(sizeOf<NativeBindingObject>());
   pointer.ref.disposed = false;
+  pointer.ref.eventPathListenerTypes = 0;
   return pointer;
 }
 
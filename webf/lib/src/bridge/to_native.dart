@@ -119,6 +119,17 @@ final DartEvaluateScripts _evaluateScripts =
 final DartParseHTML _parseHTML =
     WebFDynamicLibrary.ref.lookup<NativeFunction<NativeParseHTML>>('parseHTML').asFunction();
 
+// Register parseHTMLChunk
+final DartParseHTML _parseHTMLChunk =
+    WebFDynamicLibrary.ref.lookup<NativeFunction<NativeParseHTML>>('parseHTMLChunk').asFunction();
+
+// Register finishParseHTML
+typedef NativeFinishParseHTML = Void Function(Int32 contextId);
+typedef DartFinishParseHTML = void Function(int contextId);
+
+final DartFinishParseHTML _finishParseHTML =
+    WebFDynamicLibrary.ref.lookup<NativeFunction<NativeFinishParseHTML>>('finishParseHTML').asFunction();
+
 int _anonymousScriptEvaluationId = 0;
 
 void evaluateScripts(int contextId, String code, {String? url, int line = 0}) {
@@ -171,6 +182,32 @@ void parseHTML(int contextId, String code) {
   malloc.free(nativeCode);
 }
 
+// Feed a part of a document which is still loading, call [finishParseHTML] after the last part.
+void parseHTMLChunk(int contextId, List<int> bytes) {
+  if (WebFController.getControllerOfJSContextId(contextId) == null) {
+    return;
+  }
+  Pointer<Uint8> nativeBytes = malloc.allocate<Uint8>(bytes.length);
+  nativeBytes.asTypedList(bytes.length).setAll(0, bytes);
+  try {
+    _parseHTMLChunk(contextId, nativeBytes.cast<Utf8>(), bytes.length);
+  } catch (e, stack) {
+    print('$e\n$stack');
+  }
+  malloc.free(nativeBytes);
+}
+
+void finishParseHTML(int contextId) {
+  if (WebFController.getControllerOfJSContextId(contextId) == null) {
+    return;
+  }
+  try {
+    _finishParseHTML(contextId);
+  } catch (e, stack) {
+    print('$e\n$stack');
+  }
+}
+
 // Register initJsEngine
 typedef NativeInitJSPagePool = Void Function(Int32 poolSize, Pointer<Uint64> dartMethods, Int32 methodsLength);
 typedef DartInitJSPagePool = void Function(int poolSize, Pointer<Uint64> dartMethods, int length);
@@ -279,6 +316,10 @@ enum UICommandType {
   cloneNode,
   removeEvent,
   createDocumentFragment,
+  createPerformance,
+  setStyleBatch,
+  instantiateFragment,
+  disposeFragmentTemplate,
 }
 
 class UICommandItem extends Struct {
@@ -296,14 +337,27 @@ class UICommandItem extends Struct {
   external Pointer nativePtr;
 }
 
-typedef NativeGetUICommandItems = Pointer<Uint64> Function(Int32 contextId);
-typedef DartGetUICommandItems = Pointer<Uint64> Function(int contextId);
+typedef NativeAcquireUICommandSegments = Int64 Function(Int32 contextId);
+typedef DartAcquireUICommandSegments = int Function(int contextId);
+
+final DartAcquireUICommandSegments _acquireUICommandSegments = WebFDynamicLibrary.ref
+    .lookup<NativeFunction<NativeAcquireUICommandSegments>>('acquireUICommandSegments')
+    .asFunction();
+
+typedef NativeGetUICommandItems = Pointer<Uint64> Function(Int32 contextId, Int64 segment);
+typedef DartGetUICommandItems = Pointer<Uint64> Function(int contextId, int segment);
 
 final DartGetUICommandItems _getUICommandItems =
     WebFDynamicLibrary.ref.lookup<NativeFunction<NativeGetUICommandItems>>('getUICommandItems').asFunction();
 
-typedef NativeGetUICommandItemSize = Int64 Function(Int64 contextId);
-typedef DartGetUICommandItemSize = int Function(int contextId);
+typedef NativeGetUICommandStrings = Pointer<Uint16> Function(Int32 contextId);
+typedef DartGetUICommandStrings = Pointer<Uint16> Function(int contextId);
+
+final DartGetUICommandStrings _getUICommandStrings =
+    WebFDynamicLibrary.ref.lookup<NativeFunction<NativeGetUICommandStrings>>('getUICommandStrings').asFunction();
+
+typedef NativeGetUICommandItemSize = Int64 Function(Int32 contextId, Int64 segment);
+typedef DartGetUICommandItemSize = int Function(int contextId, int segment);
 
 final DartGetUICommandItemSize _getUICommandItemSize =
     WebFDynamicLibrary.ref.lookup<NativeFunction<NativeGetUICommandItemSize>>('getUICommandItemSize').asFunction();
@@ -314,15 +368,50 @@ typedef DartClearUICommandItems = void Function(int contextId);
 final DartClearUICommandItems _clearUICommandItems =
     WebFDynamicLibrary.ref.lookup<NativeFunction<NativeClearUICommandItems>>('clearUICommandItems').asFunction();
 
+typedef NativeInvalidateGeometrySnapshots = Void Function(Int32 contextId);
+typedef DartInvalidateGeometrySnapshots = void Function(int contextId);
+
+final DartInvalidateGeometrySnapshots _invalidateGeometrySnapshots = WebFDynamicLibrary.ref
+    .lookup<NativeFunction<NativeInvalidateGeometrySnapshots>>('invalidateGeometrySnapshots')
+    .asFunction();
+
+// Geometry values cached by bridge are stale once a new frame has been laid out.
+void invalidateGeometrySnapshots(int contextId) {
+  _invalidateGeometrySnapshots(contextId);
+}
+
+// A node of the fragment template described by instantiateFragment, see HTMLFragmentTemplate in bridge.
+class FragmentTemplateNode {
+  static const int element = 0;
+  static const int text = 1;
+  static const int comment = 2;
+
+  FragmentTemplateNode(this.type, this.parent, this.name);
+
+  final int type;
+  // Index of the parent node in the template, -1 for the top level nodes.
+  final int parent;
+  // The tag name of an element, the data of a text or a comment.
+  final String name;
+  final List<String> attributes = [];
+  final List<String> styles = [];
+}
+
 class UICommand {
   late final UICommandType type;
   late final int id;
   late final List<String> args;
   late final Pointer nativePtr;
+  late final int nodeId;
+  late final int position;
+  // The ids and native pointers of the nodes created by instantiateFragment, 6 units per node.
+  Uint16List? fragmentNodes;
+  // The template of instantiateFragment, only sent the first time it is instantiated.
+  List<FragmentTemplateNode>? fragmentTemplate;
 
   @override
   String toString() {
-    return 'UICommand(type: $type, id: $id, args: $args, nativePtr: $nativePtr)';
+    return 'UICommand(type: $type, id: $id, args: $args, nativePtr: $nativePtr, nodeId: $nodeId, position: $position)';
   }
 }
 
@@ -331,26 +420,59 @@ class UICommand {
 //   int32_t id;               // offset: 0.5 ~ 1
 //   int32_t args_01_length;   // offset: 1 ~ 1.5
 //   int32_t args_02_length;   // offset: 1.5 ~ 2
-//   const uint16_t *string_01;// offset: 2
-//   const uint16_t *string_02;// offset: 3
+//   int64_t string_01;        // offset: 2
+//   int64_t string_02;        // offset: 3
 //   void* nativePtr;          // offset: 4
+//   int64_t node_id;          // offset: 5
+//   int64_t position;         // offset: 6
 // };
-const int nativeCommandSize = 5;
+// string_01 and string_02 are offsets (in uint16_t units) into the string arena returned by getUICommandStrings,
+// -1 means the command doesn't carry this argument.
+// node_id is the id of the node inserted by insertAdjacentNode or created by cloneNode,
+// position is one of the insertAdjacent* positions below.
+const int nativeCommandSize = 7;
 const int typeAndIdMemOffset = 0;
 const int args01And02LengthMemOffset = 1;
 const int args01StringMemOffset = 2;
 const int args02StringMemOffset = 3;
 const int nativePtrMemOffset = 4;
+const int nodeIdMemOffset = 5;
+const int positionMemOffset = 6;
+const int noStringOffset = -1;
+
+// Same values as UICommandInsertPosition in bridge.
+const int insertAdjacentBeforeBegin = 0;
+const int insertAdjacentAfterBegin = 1;
+const int insertAdjacentBeforeEnd = 2;
+const int insertAdjacentAfterEnd = 3;
 
 final bool isEnabledLog = !kReleaseMode && Platform.environment['ENABLE_WEBF_JS_LOG'] == 'true';
 
 // We found there are performance bottleneck of reading native memory with Dart FFI API.
 // So we align all UI instructions to a whole block of memory, and then convert them into a dart array at one time,
 // To ensure the fastest subsequent random access.
-List<UICommand> readNativeUICommandToDart(Pointer<Uint64> nativeCommandItems, int commandLength, int contextId) {
+// Commands of one flush are split into segments, all of them share the same string arena.
+List<UICommand> readNativeUICommandToDart(int contextId, int segmentCount) {
+  Pointer<Uint16> nativeCommandStrings = _getUICommandStrings(contextId);
+  List<UICommand> results = [];
+  for (int segment = 0; segment < segmentCount; segment++) {
+    Pointer<Uint64> nativeCommandItems = _getUICommandItems(contextId, segment);
+    int commandLength = _getUICommandItemSize(contextId, segment);
+    if (commandLength == 0 || nativeCommandItems == nullptr) continue;
+    results.addAll(_readNativeUICommandSegment(nativeCommandItems, nativeCommandStrings, commandLength));
+  }
+
+  // Clear native command.
+  _clearUICommandItems(contextId);
+
+  return results;
+}
+
+List<UICommand> _readNativeUICommandSegment(
+    Pointer<Uint64> nativeCommandItems, Pointer<Uint16> nativeCommandStrings, int commandLength) {
   List<int> rawMemory =
       nativeCommandItems.cast<Int64>().asTypedList(commandLength * nativeCommandSize).toList(growable: false);
-  List<UICommand> results = List.generate(commandLength, (int _i) {
+  return List.generate(commandLength, (int _i) {
     int i = _i * nativeCommandSize;
     UICommand command = UICommand();
 
@@ -368,6 +490,8 @@ List<UICommand> readNativeUICommandToDart(Pointer<Uint64> nativeCommandItems, in
     int nativePtrValue = rawMemory[i + nativePtrMemOffset];
     command.nativePtr = nativePtrValue != 0 ? Pointer.fromAddress(rawMemory[i + nativePtrMemOffset]) : nullptr;
     command.args = List.empty(growable: true);
+    command.nodeId = rawMemory[i + nodeIdMemOffset];
+    command.position = rawMemory[i + positionMemOffset];
 
     int args01And02Length = rawMemory[i + args01And02LengthMemOffset];
     int args01Length;
@@ -380,14 +504,32 @@ List<UICommand> readNativeUICommandToDart(Pointer<Uint64> nativeCommandItems, in
       args01Length = (args01And02Length ^ (args02Length << 32)).toSigned(32);
     }
 
-    int args01StringMemory = rawMemory[i + args01StringMemOffset];
-    if (args01StringMemory != 0) {
-      Pointer<Uint16> args_01 = Pointer.fromAddress(args01StringMemory);
+    int args01StringOffset = rawMemory[i + args01StringMemOffset];
+    if (command.type == UICommandType.setStyleBatch) {
+      // args01Length units of declarations packed at args01StringOffset, args02Length is the count of declarations.
+      Uint16List packed = nativeCommandStrings.elementAt(args01StringOffset).asTypedList(args01Length);
+      int offset = 0;
+      for (int n = 0; n < args02Length * 2; n++) {
+        int length = packed[offset] | (packed[offset + 1] << 16);
+        offset += 2;
+        command.args.add(String.fromCharCodes(packed, offset, offset + length));
+        offset += length;
+      }
+    } else if (command.type == UICommandType.instantiateFragment) {
+      command.fragmentNodes =
+          Uint16List.fromList(nativeCommandStrings.elementAt(args01StringOffset).asTypedList(args01Length));
+      int args02StringOffset = rawMemory[i + args02StringMemOffset];
+      if (args02StringOffset != noStringOffset) {
+        command.fragmentTemplate =
+            _readFragmentTemplate(nativeCommandStrings.elementAt(args02StringOffset).asTypedList(args02Length));
+      }
+    } else if (args01StringOffset != noStringOffset) {
+      Pointer<Uint16> args_01 = nativeCommandStrings.elementAt(args01StringOffset);
       command.args.add(uint16ToString(args_01, args01Length));
 
-      int args02StringMemory = rawMemory[i + args02StringMemOffset];
-      if (args02StringMemory != 0) {
-        Pointer<Uint16> args_02 = Pointer.fromAddress(args02StringMemory);
+      int args02StringOffset = rawMemory[i + args02StringMemOffset];
+      if (args02StringOffset != noStringOffset) {
+        Pointer<Uint16> args_02 = nativeCommandStrings.elementAt(args02StringOffset);
         command.args.add(uint16ToString(args_02, args02Length));
       }
     }
@@ -397,19 +539,46 @@ List<UICommand> readNativeUICommandToDart(Pointer<Uint64> nativeCommandItems, in
       for (int i = 0; i < command.args.length; i++) {
         printMsg += ' args[$i]: ${command.args[i]}';
       }
-      printMsg += ' nativePtr: ${command.nativePtr}';
+      printMsg += ' nativePtr: ${command.nativePtr} nodeId: ${command.nodeId} position: ${command.position}';
       print(printMsg);
     }
     return command;
   }, growable: false);
+}
 
-  // Clear native command.
-  _clearUICommandItems(contextId);
+List<FragmentTemplateNode> _readFragmentTemplate(Uint16List description) {
+  List<FragmentTemplateNode> nodes = [];
+  int offset = 0;
+  int readCount() {
+    int count = description[offset] | (description[offset + 1] << 16);
+    offset += 2;
+    return count;
+  }
 
-  return results;
+  String readString() {
+    int length = readCount();
+    String string = String.fromCharCodes(description, offset, offset + length);
+    offset += length;
+    return string;
+  }
+
+  while (offset < description.length) {
+    int type = description[offset++];
+    int parent = readCount().toSigned(32);
+    FragmentTemplateNode node = FragmentTemplateNode(type, parent, readString());
+    for (int n = readCount() * 2; n > 0; n--) {
+      node.attributes.add(readString());
+    }
+    for (int n = readCount() * 2; n > 0; n--) {
+      node.styles.add(readString());
+    }
+    nodes.add(node);
+  }
+  return nodes;
 }
 
 void clearUICommand(int contextId) {
+  _acquireUICommandSegments(contextId);
   _clearUICommandItems(contextId);
 }
 
@@ -421,10 +590,10 @@ void flushUICommandWithContextId(int contextId) {
 }
 
 void flushUICommand(WebFViewController view) {
-  Pointer<Uint64> nativeCommandItems = _getUICommandItems(view.contextId);
-  int commandLength = _getUICommandItemSize(view.contextId);
+  // Take over all the commands recorded by bridge, bridge will record new commands into another buffer from now on.
+  int segmentCount = _acquireUICommandSegments(view.contextId);
 
-  if (commandLength == 0 || nativeCommandItems == nullptr) {
+  if (segmentCount == 0) {
     return;
   }
 
@@ -432,7 +601,8 @@ void flushUICommand(WebFViewController view) {
     PerformanceTiming.instance().mark(PERF_FLUSH_UI_COMMAND_START);
   }
 
-  List<UICommand> commands = readNativeUICommandToDart(nativeCommandItems, commandLength, view.contextId);
+  List<UICommand> commands = readNativeUICommandToDart(view.contextId, segmentCount);
+  int commandLength = commands.length;
 
   SchedulerBinding.instance.scheduleFrame();
 
@@ -476,16 +646,13 @@ void flushUICommand(WebFViewController view) {
           view.removeEvent(id, command.args[0]);
           break;
         case UICommandType.insertAdjacentNode:
-          int childId = int.parse(command.args[0]);
-          String position = command.args[1];
-          view.insertAdjacentNode(id, position, childId);
+          view.insertAdjacentNode(id, command.position, command.nodeId);
           break;
         case UICommandType.removeNode:
           view.removeNode(id);
           break;
         case UICommandType.cloneNode:
-          int newId = int.parse(command.args[0]);
-          view.cloneNode(id, newId);
+          view.cloneNode(id, command.nodeId);
           break;
         case UICommandType.setStyle:
           String key = command.args[0];
@@ -493,6 +660,12 @@ void flushUICommand(WebFViewController view) {
           view.setInlineStyle(id, key, value);
           pendingStylePropertiesTargets[id] = true;
           break;
+        case UICommandType.setStyleBatch:
+          for (int n = 0; n < command.args.length; n += 2) {
+            view.setInlineStyle(id, command.args[n], command.args[n + 1]);
+          }
+          pendingStylePropertiesTargets[id] = true;
+          break;
         case UICommandType.setAttribute:
           String key = command.args[0];
           String value = command.args[1];
@@ -505,6 +678,16 @@ void flushUICommand(WebFViewController view) {
         case UICommandType.createDocumentFragment:
           view.createDocumentFragment(id, nativePtr.cast<NativeBindingObject>());
           break;
+        case UICommandType.instantiateFragment:
+          List<int> styledIds =
+              view.instantiateFragment(id, command.nodeId, command.fragmentTemplate, command.fragmentNodes!);
+          for (int styledId in styledIds) {
+            pendingStylePropertiesTargets[styledId] = true;
+          }
+          break;
+        case UICommandType.disposeFragmentTemplate:
+          view.disposeFragmentTemplate(command.nodeId);
+          break;
         default:
           break;
       }
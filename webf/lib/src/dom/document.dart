@@ -4,6 +4,7 @@
  */
 import 'package:flutter/foundation.dart';
 import 'package:flutter/rendering.dart';
+import 'package:webf/bridge.dart';
 import 'package:webf/css.dart';
 import 'package:webf/dom.dart';
 import 'package:webf/foundation.dart';
@@ -133,10 +134,22 @@ class Document extends Node {
         return getElementsByTagName(args);
       case 'getElementsByName':
         return getElementsByName(args);
+      case 'getGeometrySnapshots':
+        return getGeometrySnapshots(args);
     }
     return super.invokeBindingMethod(method, args);
   }
 
+  // Geometry snapshots of many elements in one call, concatenated in the order of the element list.
+  List<double> getGeometrySnapshots(List<dynamic> args) {
+    List<double> values = [];
+    for (Pointer pointer in args[0]) {
+      Element element = BindingBridge.getBindingObject(pointer) as Element;
+      values.addAll(element.getGeometrySnapshot());
+    }
+    return values;
+  }
+
   dynamic querySelector(List<dynamic> args) {
     if (args[0].runtimeType == String && (args[0] as String).isEmpty) return null;
     return QuerySelector.querySelector(this, args.first);
@@ -277,6 +277,8 @@ abstract class Element extends Node with ElementBase, ElementEventMixin, Element
     switch (method) {
       case 'getBoundingClientRect':
         return getBoundingClientRect();
+      case 'getGeometrySnapshot':
+        return getGeometrySnapshot();
       case 'scroll':
         return scroll(castToType<double>(args[0]), castToType<double>(args[1]));
       case 'scrollBy':
@@ -560,6 +562,17 @@ abstract class Element extends Node with ElementBase, ElementEventMixin, Element
 
   BoundingClientRect getBoundingClientRect() => boundingClientRect;
 
+  // All layout-dependent values at once, the order must match ElementGeometryProperty at the bridge side.
+  List<double> getGeometrySnapshot() {
+    BoundingClientRect rect = boundingClientRect;
+    return [
+      offsetTop, offsetLeft, offsetWidth, offsetHeight,
+      clientTop, clientLeft, clientWidth, clientHeight,
+      scrollTop, scrollLeft, scrollWidth, scrollHeight,
+      rect.x, rect.y, rect.width, rect.height,
+    ];
+  }
+
   bool _shouldConsumeScrollTicker = false;
 
   void _consumeScrollTicker(_) {
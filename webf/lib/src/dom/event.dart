@@ -170,6 +170,8 @@ class Event {
   bool defaultPrevented = false;
   bool _immediateBubble = true;
   bool propagationStopped = false;
+  // Whether the listeners at the binding side already ran for the whole event path.
+  bool dispatchedToNative = false;
 
   Event(
     this.type, {
@@ -3,6 +3,7 @@
  * Copyright (C) 2022-present The WebF authors. All rights reserved.
  */
 import 'package:flutter/foundation.dart';
+import 'package:webf/bridge.dart';
 import 'package:webf/dom.dart';
 import 'package:webf/foundation.dart';
 import 'package:webf/module.dart';
@@ -54,6 +55,7 @@ abstract class EventTarget extends BindingObject {
     if (_disposed) return;
 
     event.target = this;
+    BindingBridge.dispatchEventAlongPath(event);
     _dispatchEventInDOM(event);
   }
 
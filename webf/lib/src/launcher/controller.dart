@@ -154,6 +154,7 @@ class WebFViewController implements WidgetsBindingObserver, ElementsBindingObser
 
   void _postFrameCallback(Duration timeStamp) {
     if (disposed) return;
+    invalidateGeometrySnapshots(contextId);
     flushUICommand(this);
     SchedulerBinding.instance.addPostFrameCallback(_postFrameCallback);
   }
@@ -361,6 +362,7 @@ class WebFViewController implements WidgetsBindingObserver, ElementsBindingObser
     // Set current eventTargets to a new object, clean old targets by gc.
     _eventTargets = <int, EventTarget>{};
     _widgetElements.clear();
+    _fragmentTemplates.clear();
   }
 
   // export Uint8List bytes from rendered result.
@@ -442,6 +444,73 @@ class WebFViewController implements WidgetsBindingObserver, ElementsBindingObser
     }
   }
 
+  // Templates of instantiateFragment commands, keyed by template id.
+  final Map<int, List<FragmentTemplateNode>> _fragmentTemplates = {};
+
+  // Creates the nodes of a fragment template with the ids and native pointers chosen by bridge, and appends the top
+  // level ones to the node of parentId, unless it is -1. Returns the ids of the elements which have inline styles.
+  List<int> instantiateFragment(
+      int parentId, int templateId, List<FragmentTemplateNode>? template, Uint16List nodes) {
+    if (template != null) {
+      _fragmentTemplates[templateId] = template;
+    } else {
+      template = _fragmentTemplates[templateId];
+    }
+    assert(template != null, 'Unknown fragment template: $templateId');
+    if (template == null) return const [];
+
+    List<int> styledIds = [];
+    List<Node> created = [];
+    for (int i = 0; i < template.length; i++) {
+      FragmentTemplateNode templateNode = template[i];
+      int offset = i * 6;
+      int targetId = (nodes[offset] | (nodes[offset + 1] << 16)).toSigned(32);
+      Pointer<NativeBindingObject> nativePtr = Pointer.fromAddress(nodes[offset + 2] |
+          (nodes[offset + 3] << 16) |
+          (nodes[offset + 4] << 32) |
+          (nodes[offset + 5] << 48));
+
+      Node node;
+      switch (templateNode.type) {
+        case FragmentTemplateNode.element:
+          Element element =
+              document.createElement(templateNode.name.toUpperCase(), BindingContext(_contextId, nativePtr));
+          for (int n = 0; n < templateNode.attributes.length; n += 2) {
+            element.setAttribute(templateNode.attributes[n], templateNode.attributes[n + 1]);
+          }
+          for (int n = 0; n < templateNode.styles.length; n += 2) {
+            element.setInlineStyle(templateNode.styles[n], templateNode.styles[n + 1]);
+          }
+          if (templateNode.styles.isNotEmpty) {
+            styledIds.add(targetId);
+          }
+          node = element;
+          break;
+        case FragmentTemplateNode.text:
+          node = document.createTextNode(templateNode.name, BindingContext(_contextId, nativePtr));
+          break;
+        default:
+          node = document.createComment(BindingContext(_contextId, nativePtr));
+          break;
+      }
+      _setEventTarget(targetId, node);
+
+      if (templateNode.parent >= 0) {
+        created[templateNode.parent].appendChild(node);
+      } else if (parentId != -1) {
+        _getEventTargetById<Node>(parentId)!.appendChild(node);
+      }
+      created.add(node);
+    }
+
+    _debugDOMTreeChanged();
+    return styledIds;
+  }
+
+  void disposeFragmentTemplate(int templateId) {
+    _fragmentTemplates.remove(templateId);
+  }
+
   void addEvent(int targetId, String eventType) {
     if (kProfileMode) {
       PerformanceTiming.instance().mark(PERF_ADD_EVENT_START, uniqueId: targetId);
@@ -517,7 +586,7 @@ class WebFViewController implements WidgetsBindingObserver, ElementsBindingObser
   ///   <!-- beforeend -->
   /// </p>
   /// <!-- afterend -->
-  void insertAdjacentNode(int targetId, String position, int newTargetId) {
+  void insertAdjacentNode(int targetId, int position, int newTargetId) {
     if (kProfileMode) {
       PerformanceTiming.instance().mark(PERF_INSERT_ADJACENT_NODE_START, uniqueId: targetId);
     }
@@ -530,16 +599,16 @@ class WebFViewController implements WidgetsBindingObserver, ElementsBindingObser
     Node? targetParentNode = target.parentNode;
 
     switch (position) {
-      case 'beforebegin':
+      case insertAdjacentBeforeBegin:
         targetParentNode!.insertBefore(newNode, target);
         break;
-      case 'afterbegin':
+      case insertAdjacentAfterBegin:
         target.insertBefore(newNode, target.firstChild);
         break;
-      case 'beforeend':
+      case insertAdjacentBeforeEnd:
         target.appendChild(newNode);
         break;
-      case 'afterend':
+      case insertAdjacentAfterEnd:
         if (targetParentNode!.lastChild == target) {
           targetParentNode.appendChild(newNode);
         } else {